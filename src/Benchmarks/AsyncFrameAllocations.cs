@@ -0,0 +1,120 @@
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams;
+using K4os.Compression.LZ4.Streams.Abstractions;
+using K4os.Compression.LZ4.Streams.Adapters;
+using K4os.Compression.LZ4.Streams.Frames;
+using TestHelpers;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Stream adapter exposing only <see cref="Task"/> based methods, so frame reader and writer
+/// cannot use <see cref="ValueTask"/> path. Used as a baseline for allocation comparison.
+/// </summary>
+public readonly struct TaskOnlyStreamAdapter: IStreamReader<EmptyState>, IStreamWriter<EmptyState>
+{
+	private readonly StreamAdapter _adapter;
+
+	public TaskOnlyStreamAdapter(Stream stream) => _adapter = new StreamAdapter(stream);
+
+	public int Read(ref EmptyState state, byte[] buffer, int offset, int length) =>
+		_adapter.Read(ref state, buffer, offset, length);
+
+	public async Task<ReadResult<EmptyState>> ReadAsync(
+		EmptyState state, byte[] buffer, int offset, int length, CancellationToken token) =>
+		await _adapter.ReadAsync(state, buffer, offset, length, token);
+
+	public bool CanFlush => _adapter.CanFlush;
+
+	public void Write(ref EmptyState state, byte[] buffer, int offset, int length) =>
+		_adapter.Write(ref state, buffer, offset, length);
+
+	public async Task<EmptyState> WriteAsync(
+		EmptyState state, byte[] buffer, int offset, int length, CancellationToken token) =>
+		await _adapter.WriteAsync(state, buffer, offset, length, token);
+
+	public void Flush(ref EmptyState state) => _adapter.Flush(ref state);
+
+	public Task<EmptyState> FlushAsync(EmptyState state, CancellationToken token) =>
+		_adapter.FlushAsync(state, token);
+}
+
+[MemoryDiagnoser]
+public class AsyncFrameAllocations
+{
+	private byte[] _source = null!;
+	private byte[] _encoded = null!;
+	private byte[] _buffer = null!;
+	private ILZ4Descriptor _descriptor = null!;
+
+	[Params(Mem.K64, Mem.M1)]
+	public int BlockSize { get; set; }
+
+	[Params(false, true)]
+	public bool TaskOnly { get; set; }
+
+	[GlobalSetup]
+	public void Setup()
+	{
+		_source = Lorem.Create(16 * Mem.M1);
+		var settings = new LZ4EncoderSettings { BlockSize = BlockSize };
+		_descriptor = settings.CreateDescriptor();
+		using var encoded = new MemoryStream();
+		using (var encoder = LZ4Stream.Encode(encoded, settings, true))
+			encoder.Write(_source, 0, _source.Length);
+		_encoded = encoded.ToArray();
+		_buffer = new byte[Mem.K4];
+	}
+
+	[Benchmark]
+	public async Task EncodeAsync()
+	{
+		var target = new MemoryStream(_encoded.Length + Mem.K64);
+		if (TaskOnly)
+		{
+			using var writer = new LZ4FrameWriter<TaskOnlyStreamAdapter, EmptyState>(
+				new TaskOnlyStreamAdapter(target), default, d => d.CreateEncoder(), _descriptor);
+			await EncodeAsync(writer);
+		}
+		else
+		{
+			using var writer = new LZ4FrameWriter<StreamAdapter, EmptyState>(
+				new StreamAdapter(target), default, d => d.CreateEncoder(), _descriptor);
+			await EncodeAsync(writer);
+		}
+	}
+
+	private async Task EncodeAsync(ILZ4FrameWriter writer)
+	{
+		var source = _source.AsMemory();
+		for (var offset = 0; offset < source.Length; offset += Mem.K4)
+			await writer.WriteManyBytesAsync(default, source.Slice(offset, Mem.K4));
+		await writer.CloseFrameAsync(default);
+	}
+
+	[Benchmark]
+	public async Task DecodeAsync()
+	{
+		var source = new MemoryStream(_encoded);
+		if (TaskOnly)
+		{
+			using var reader = new LZ4FrameReader<TaskOnlyStreamAdapter, EmptyState>(
+				new TaskOnlyStreamAdapter(source), default, d => d.CreateDecoder());
+			await DecodeAsync(reader);
+		}
+		else
+		{
+			using var reader = new LZ4FrameReader<StreamAdapter, EmptyState>(
+				new StreamAdapter(source), default, d => d.CreateDecoder());
+			await DecodeAsync(reader);
+		}
+	}
+
+	private async Task DecodeAsync(ILZ4FrameReader reader)
+	{
+		var buffer = _buffer.AsMemory();
+		while (await reader.ReadManyBytesAsync(default, buffer) > 0) { }
+	}
+}
@@ -0,0 +1,101 @@
+using K4os.Compression.LZ4;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Prints statistics of compressed blocks (see <see cref="LZ4Analyzer"/>).
+/// LZ4 frames (<c>.lz4</c> files) are analyzed as they are, pickles (with <c>--pickle</c>)
+/// are analyzed as single block, any other file is compressed first (as frame, with given
+/// level and block size) and then analyzed.
+/// Run with: <c>Benchmarks analyze [--pickle] [--level L09_HC] [--block-size 65536] file...</c>
+/// </summary>
+public static class BlockAnalysis
+{
+	private const uint FrameMagic = 0x184D2204;
+	private const uint SkippableMagic = 0x184D2A50;
+
+	public static int Run(IEnumerable<string> arguments)
+	{
+		var pickle = false;
+		var level = LZ4Level.L00_FAST;
+		var blockSize = Mem.K64;
+		var files = new List<string>();
+
+		using (var args = arguments.GetEnumerator())
+		{
+			while (args.MoveNext())
+			{
+				switch (args.Current)
+				{
+					case "--pickle": pickle = true; break;
+					case "--level": level = Enum.Parse<LZ4Level>(Next(args), true); break;
+					case "--block-size": blockSize = int.Parse(Next(args)); break;
+					default: files.Add(args.Current); break;
+				}
+			}
+		}
+
+		if (files.Count == 0)
+		{
+			Console.Error.WriteLine(
+				"Usage: analyze [--pickle] [--level <level>] [--block-size <bytes>] file...");
+			return 2;
+		}
+
+		var failures = 0;
+		foreach (var file in files)
+		{
+			Console.WriteLine($"{file}:");
+			try
+			{
+				Analyze(file, pickle, level, blockSize).WriteTo(Console.Out);
+			}
+			catch (InvalidDataException e)
+			{
+				Console.WriteLine($"  {e.Message}");
+				failures++;
+			}
+
+			Console.WriteLine();
+		}
+
+		return failures == 0 ? 0 : 1;
+	}
+
+	private static string Next(IEnumerator<string> args) =>
+		args.MoveNext() ? args.Current : throw new ArgumentException("Missing argument value");
+
+	private static LZ4BlockStats Analyze(
+		string file, bool pickle, LZ4Level level, int blockSize)
+	{
+		if (pickle)
+			return LZ4Analyzer.Pickle(File.ReadAllBytes(file));
+
+		if (IsFrame(file))
+		{
+			using var stream = File.OpenRead(file);
+			return LZ4Frame.Analyze(stream);
+		}
+
+		var encoded = new MemoryStream();
+		var settings = new LZ4EncoderSettings { CompressionLevel = level, BlockSize = blockSize };
+		using (var source = File.OpenRead(file))
+		using (var target = LZ4Stream.Encode(encoded, settings, true))
+			source.CopyTo(target);
+
+		encoded.Position = 0;
+		return LZ4Frame.Analyze(encoded);
+	}
+
+	private static bool IsFrame(string file)
+	{
+		using var stream = File.OpenRead(file);
+		var header = new byte[sizeof(uint)];
+		if (stream.Read(header, 0, header.Length) < header.Length) return false;
+
+		var magic = BitConverter.ToUInt32(header);
+		return magic == FrameMagic || (magic & 0xFFFFFFF0) == SkippableMagic;
+	}
+}
@@ -51,7 +51,7 @@ namespace Benchmarks
 		[Benchmark]
 		public void Current64()
 		{
-			LZ4PrevCodec.Decode(
+			LZ4Codec.Decode(
 				_source, 0, _source.Length,
 				_target, 0, _target.Length);
 		}
@@ -60,7 +60,7 @@ namespace Benchmarks
 		public void Current32()
 		{
 			LZ4Codec.Enforce32 = true;
-			LZ4PrevCodec.Decode(
+			LZ4Codec.Decode(
 				_source, 0, _source.Length,
 				_target, 0, _target.Length);
 			LZ4Codec.Enforce32 = false;
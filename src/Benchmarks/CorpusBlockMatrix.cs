@@ -0,0 +1,66 @@
+using System.Buffers;
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Block and pickler API across all corpus files and all compression levels.
+/// Run with: <c>--filter *CorpusBlockMatrix*</c>
+/// </summary>
+[Config(typeof(CorpusConfig))]
+public class CorpusBlockMatrix: ICorpusBenchmark
+{
+	private byte[] _original = null!;
+	private byte[] _encoded = null!;
+	private byte[] _pickled = null!;
+	private byte[] _buffer = null!;
+	private byte[] _decoded = null!;
+	private ArrayBufferWriter<byte> _writer = null!;
+
+	public static IEnumerable<string> Files => Corpus.Files();
+
+	[ParamsSource(nameof(Files))]
+	public string File { get; set; } = null!;
+
+	[ParamsAllValues]
+	public LZ4Level Level { get; set; }
+
+	public long OriginalLength => _original.Length;
+	public long CompressedLength => _encoded.Length;
+
+	[GlobalSetup]
+	public void Setup()
+	{
+		_original = Corpus.Load(File);
+		_buffer = new byte[LZ4Codec.MaximumOutputSize(_original.Length)];
+		_encoded = _buffer.AsSpan(0, LZ4Codec.Encode(_original, _buffer, Level)).ToArray();
+		_pickled = LZ4Pickler.Pickle(_original, Level);
+		_decoded = new byte[_original.Length];
+		_writer = new ArrayBufferWriter<byte>(_buffer.Length + 16);
+	}
+
+	[Benchmark]
+	public int BlockEncode() =>
+		LZ4Codec.Encode(_original, _buffer, Level);
+
+	[Benchmark]
+	public int BlockDecode() =>
+		LZ4Codec.Decode(_encoded, _decoded);
+
+	[Benchmark]
+	public int BlockDecodedLength() =>
+		LZ4Codec.GetDecodedLength(_encoded);
+
+	[Benchmark]
+	public int PicklerEncode()
+	{
+		_writer.ResetWrittenCount();
+		LZ4Pickler.Pickle(_original, _writer, Level);
+		return _writer.WrittenCount;
+	}
+
+	[Benchmark]
+	public void PicklerDecode() =>
+		LZ4Pickler.Unpickle(_pickled, _decoded);
+}
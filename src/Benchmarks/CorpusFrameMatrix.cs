@@ -0,0 +1,193 @@
+using System.Buffers;
+using System.IO.Pipelines;
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams;
+
+namespace Benchmarks;
+
+public enum FrameSurface
+{
+	Memory,
+	Stream,
+	Pipe,
+}
+
+/// <summary>
+/// Frame API across all corpus files, compression levels, block sizes and block modes,
+/// over memory, stream and pipe. Full matrix is large (and takes hours), use filters
+/// to narrow it down, like: <c>--filter *CorpusFrameMatrix.Decode*</c>.
+/// </summary>
+[Config(typeof(CorpusConfig))]
+public class CorpusFrameMatrix: ICorpusBenchmark
+{
+	private const int ChunkSize = Mem.K64;
+
+	private byte[] _original = null!;
+	private byte[] _encoded = null!;
+	private byte[] _decoded = null!;
+	private LZ4EncoderSettings _settings = null!;
+	private ArrayBufferWriter<byte> _writer = null!;
+	private MemoryStream _stream = null!;
+
+	public static IEnumerable<string> Files => Corpus.Files();
+
+	[ParamsSource(nameof(Files))]
+	public string File { get; set; } = null!;
+
+	[ParamsAllValues]
+	public LZ4Level Level { get; set; }
+
+	[Params(Mem.K64, Mem.K256, Mem.M1, Mem.M4)]
+	public int BlockSize { get; set; }
+
+	[ParamsAllValues]
+	public bool Chaining { get; set; }
+
+	[ParamsAllValues]
+	public FrameSurface Surface { get; set; }
+
+	public long OriginalLength => _original.Length;
+	public long CompressedLength => _encoded.Length;
+
+	[GlobalSetup]
+	public void Setup()
+	{
+		_original = Corpus.Load(File);
+		_settings = new LZ4EncoderSettings {
+			CompressionLevel = Level,
+			BlockSize = BlockSize,
+			ChainBlocks = Chaining,
+		};
+		_encoded = LZ4Frame.Encode(_original.AsSpan(), new ArrayBufferWriter<byte>(), _settings)
+			.WrittenSpan.ToArray();
+		_decoded = new byte[_original.Length];
+		_writer = new ArrayBufferWriter<byte>(
+			Math.Max(_encoded.Length, _original.Length) + Mem.K64);
+		_stream = new MemoryStream(_writer.Capacity);
+	}
+
+	[Benchmark]
+	public Task<long> Encode() =>
+		Surface switch {
+			FrameSurface.Memory => Task.FromResult(EncodeMemory()),
+			FrameSurface.Stream => Task.FromResult(EncodeStream()),
+			_ => EncodePipe(),
+		};
+
+	[Benchmark]
+	public Task<long> Decode() =>
+		Surface switch {
+			FrameSurface.Memory => Task.FromResult(DecodeMemory()),
+			FrameSurface.Stream => Task.FromResult(DecodeStream()),
+			_ => DecodePipe(),
+		};
+
+	private long EncodeMemory()
+	{
+		_writer.ResetWrittenCount();
+		LZ4Frame.Encode(_original.AsSpan(), _writer, _settings);
+		return _writer.WrittenCount;
+	}
+
+	private long DecodeMemory()
+	{
+		_writer.ResetWrittenCount();
+		LZ4Frame.Decode(_encoded.AsSpan(), _writer);
+		return _writer.WrittenCount;
+	}
+
+	private long EncodeStream()
+	{
+		_stream.SetLength(0);
+		using (var encoder = LZ4Stream.Encode(_stream, _settings, true))
+		{
+			for (var offset = 0; offset < _original.Length; offset += ChunkSize)
+				encoder.Write(_original, offset, Math.Min(ChunkSize, _original.Length - offset));
+		}
+
+		return _stream.Length;
+	}
+
+	private long DecodeStream()
+	{
+		_stream.SetLength(0);
+		_stream.Write(_encoded, 0, _encoded.Length);
+		_stream.Position = 0;
+		using var decoder = LZ4Stream.Decode(_stream, 0, true);
+		var total = 0L;
+		while (true)
+		{
+			var read = decoder.Read(_decoded, 0, _decoded.Length);
+			if (read <= 0) break;
+
+			total += read;
+		}
+
+		return total;
+	}
+
+	// pipe is unbounded, so neither side waits for the other one
+	private static Pipe CreatePipe() =>
+		new(new PipeOptions(pauseWriterThreshold: 0, resumeWriterThreshold: 0));
+
+	private async Task<long> EncodePipe()
+	{
+		var pipe = CreatePipe();
+		var writer = LZ4Frame.Encode(pipe.Writer, _settings, true);
+		await using (writer)
+		{
+			var source = _original.AsMemory();
+			for (var offset = 0; offset < source.Length; offset += ChunkSize)
+			{
+				var length = Math.Min(ChunkSize, source.Length - offset);
+				await writer.WriteManyBytesAsync(default, source.Slice(offset, length));
+			}
+
+			await writer.CloseFrameAsync(default);
+		}
+
+		await pipe.Writer.CompleteAsync();
+		return await Drain(pipe.Reader);
+	}
+
+	private async Task<long> DecodePipe()
+	{
+		var pipe = CreatePipe();
+		await pipe.Writer.WriteAsync(_encoded);
+		await pipe.Writer.CompleteAsync();
+
+		var reader = LZ4Frame.Decode(pipe.Reader, 0, true);
+		var total = 0L;
+		await using (reader)
+		{
+			var buffer = _decoded.AsMemory();
+			while (true)
+			{
+				var read = await reader.ReadManyBytesAsync(default, buffer);
+				if (read <= 0) break;
+
+				total += read;
+			}
+		}
+
+		await pipe.Reader.CompleteAsync();
+		return total;
+	}
+
+	private static async Task<long> Drain(PipeReader reader)
+	{
+		var total = 0L;
+		while (true)
+		{
+			var result = await reader.ReadAsync();
+			total += result.Buffer.Length;
+			reader.AdvanceTo(result.Buffer.End);
+			if (result.IsCompleted) break;
+		}
+
+		await reader.CompleteAsync();
+		return total;
+	}
+}
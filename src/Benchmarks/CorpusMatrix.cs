@@ -0,0 +1,132 @@
+using System.Collections.Concurrent;
+using System.Globalization;
+using BenchmarkDotNet.Columns;
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Diagnosers;
+using BenchmarkDotNet.Exporters.Csv;
+using BenchmarkDotNet.Exporters.Json;
+using BenchmarkDotNet.Reports;
+using BenchmarkDotNet.Running;
+using TestHelpers;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Benchmark which compresses one of corpus files, and can tell how large
+/// the data is before and after compression.
+/// </summary>
+public interface ICorpusBenchmark
+{
+	void Setup();
+	long OriginalLength { get; }
+	long CompressedLength { get; }
+}
+
+public static class Corpus
+{
+	private static readonly ConcurrentDictionary<string, byte[]> Cache = new();
+
+	public static IEnumerable<string> Files()
+	{
+		var folder = Tools.FindFile(".corpus");
+		return Directory.Exists(folder)
+			? Directory.GetFiles(folder).Select(Path.GetFileName).OfType<string>().OrderBy(f => f)
+			: throw new DirectoryNotFoundException($"Corpus not found in {folder}, restore it first");
+	}
+
+	public static byte[] Load(string name) =>
+		Cache.GetOrAdd(name, n => File.ReadAllBytes(Tools.FindFile($".corpus/{n}")));
+}
+
+/// <summary>
+/// Configuration for corpus matrix: allocations, throughput and ratio columns,
+/// and machine-readable (JSON and CSV) exports, so results can be compared between runs.
+/// </summary>
+public class CorpusConfig: ManualConfig
+{
+	public CorpusConfig()
+	{
+		AddDiagnoser(MemoryDiagnoser.Default);
+		AddColumn(new ThroughputColumn(), new RatioColumn());
+		AddExporter(JsonExporter.Full, CsvExporter.Default);
+	}
+
+	private static readonly ConcurrentDictionary<string, (long Original, long Compressed)> Sizes =
+		new();
+
+	// benchmarks are executed in separate processes, so sizes are calculated again here
+	private static (long Original, long Compressed) GetSizes(BenchmarkCase benchmarkCase)
+	{
+		var type = benchmarkCase.Descriptor.Type;
+		var key = $"{type.FullName}/{benchmarkCase.Parameters.DisplayInfo}";
+		return Sizes.GetOrAdd(
+			key, _ => {
+				var instance = (ICorpusBenchmark)Activator.CreateInstance(type)!;
+				foreach (var parameter in benchmarkCase.Parameters.Items)
+					type.GetProperty(parameter.Name)?.SetValue(instance, parameter.Value);
+				instance.Setup();
+				return (instance.OriginalLength, instance.CompressedLength);
+			});
+	}
+
+	private abstract class CorpusColumn: IColumn
+	{
+		public abstract string Id { get; }
+		public abstract string ColumnName { get; }
+		public abstract string Legend { get; }
+		public bool AlwaysShow => true;
+		public ColumnCategory Category => ColumnCategory.Custom;
+		public int PriorityInCategory => 0;
+		public bool IsNumeric => true;
+		public UnitType UnitType => UnitType.Dimensionless;
+
+		public bool IsAvailable(Summary summary) => true;
+
+		public bool IsDefault(Summary summary, BenchmarkCase benchmarkCase) => false;
+
+		public string GetValue(Summary summary, BenchmarkCase benchmarkCase) =>
+			GetValue(summary, benchmarkCase, SummaryStyle.Default);
+
+		public string GetValue(Summary summary, BenchmarkCase benchmarkCase, SummaryStyle style)
+		{
+			if (!typeof(ICorpusBenchmark).IsAssignableFrom(benchmarkCase.Descriptor.Type))
+				return "-";
+
+			var value = Calculate(summary, benchmarkCase, GetSizes(benchmarkCase));
+			return value.HasValue ? value.Value.ToString("0.00", CultureInfo.InvariantCulture) : "-";
+		}
+
+		protected abstract double? Calculate(
+			Summary summary, BenchmarkCase benchmarkCase,
+			(long Original, long Compressed) sizes);
+	}
+
+	private class ThroughputColumn: CorpusColumn
+	{
+		public override string Id => nameof(ThroughputColumn);
+		public override string ColumnName => "MB/s";
+		public override string Legend => "Uncompressed megabytes processed per second";
+
+		protected override double? Calculate(
+			Summary summary, BenchmarkCase benchmarkCase,
+			(long Original, long Compressed) sizes)
+		{
+			var nanoseconds = summary[benchmarkCase]?.ResultStatistics?.Mean;
+			if (nanoseconds is null or <= 0) return null;
+
+			return sizes.Original / (nanoseconds.Value / 1_000_000_000.0) / (1024.0 * 1024.0);
+		}
+	}
+
+	private class RatioColumn: CorpusColumn
+	{
+		public override string Id => nameof(RatioColumn);
+		public override string ColumnName => "Ratio";
+		public override string Legend => "Original size divided by compressed size";
+
+		protected override double? Calculate(
+			Summary summary, BenchmarkCase benchmarkCase,
+			(long Original, long Compressed) sizes) =>
+			sizes.Compressed <= 0 ? null : (double)sizes.Original / sizes.Compressed;
+	}
+}
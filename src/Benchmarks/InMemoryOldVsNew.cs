@@ -37,7 +37,7 @@ public class InMemoryOldVsNew
 	[Benchmark]
 	public void UseFrameReader()
 	{
-		PinnedMemory.MaxPooledSize = Mem.M1;
+		PinnedMemory.MaxPooledSize = BlockBufferPool.MaxPooledSize;
 		using var decoder = LZ4Frame.Decode(_encoded);
 		_ = decoder.ReadManyBytes(_decoded.AsSpan());
 	}
@@ -0,0 +1,59 @@
+using System.Runtime.InteropServices;
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+using K4os.Compression.LZ4.Engine;
+
+namespace Benchmarks.Kernels;
+
+/// <summary>
+/// Decoder copies: <c>LZ4_wildCopy8</c> (literals) and <c>LZ4_memcpy_using_offset</c>
+/// (matches, including overlapping ones), on sequences produced by fast compressor.
+/// </summary>
+public unsafe class CopyKernels: KernelBenchmark
+{
+	// wild copies can overshoot by up to 8 bytes (and 8 more for short offsets)
+	private const int Overshoot = 32;
+
+	private Sequence[] _literals = null!;
+	private Sequence[] _matches = null!;
+	private byte[] _target = null!;
+	private GCHandle _handle;
+	private byte* _output;
+
+	protected override void Prepare()
+	{
+		var sequences = Sequences(LZ4Level.L00_FAST);
+		_literals = Cycle(sequences.Where(s => s.LiteralLength > 0).ToArray());
+		_matches = Cycle(sequences);
+		// target looks like decoded output, so matches copy real data
+		_target = new byte[Sample.Length + Overshoot];
+		Sample.CopyTo(_target, 0);
+		_handle = GCHandle.Alloc(_target, GCHandleType.Pinned);
+		_output = (byte*)_handle.AddrOfPinnedObject();
+	}
+
+	protected override void Release() => _handle.Free();
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public void WildCopy()
+	{
+		var source = Base;
+		var target = _output;
+		foreach (var s in _literals)
+		{
+			var op = target + s.Literal;
+			Pubternal.WildCopy8(op, source + s.Literal, op + s.LiteralLength);
+		}
+	}
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public void MatchCopy()
+	{
+		var target = _output;
+		foreach (var s in _matches)
+		{
+			var op = target + s.Match;
+			Pubternal.MatchCopy(op, op - s.Offset, op + s.MatchLength, (uint)s.Offset);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+using K4os.Compression.LZ4.Engine;
+
+namespace Benchmarks.Kernels;
+
+/// <summary>
+/// Match length counting: <c>LZ4_count</c> (forward, on matches found by fast compressor),
+/// <c>LZ4HC_countBack</c> and <c>LZ4HC_countPattern</c> (on matches found by HC compressor).
+/// </summary>
+public unsafe class CountKernels: KernelBenchmark
+{
+	private Sequence[] _fast = null!;
+	private Sequence[] _high = null!;
+	private Sequence[] _patterns = null!;
+	private long _result;
+
+	protected override void Prepare()
+	{
+		_fast = Cycle(Sequences(LZ4Level.L00_FAST));
+		var high = Sequences(LZ4Level.L09_HC);
+		_high = Cycle(high);
+		// repeated patterns (like runs of bytes) are rare in some files,
+		// so when there are none all matches are used
+		var patterns = high.Where(s => s.Offset is 1 or 2 or 4).ToArray();
+		_patterns = Cycle(patterns.Length > 0 ? patterns : high);
+	}
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public long Count()
+	{
+		var result = 0L;
+		var limit = Limit;
+		foreach (var s in _fast)
+		{
+			var ip = Base + s.Match + MINMATCH;
+			result += Pubternal.Count(ip, ip - s.Offset, limit);
+		}
+
+		return _result = result;
+	}
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public long CountBack()
+	{
+		var result = 0L;
+		var @base = Base;
+		foreach (var s in _high)
+		{
+			// starting in the middle of match gives realistic distribution of lengths
+			var ip = @base + s.Match + s.MatchLength / 2;
+			result += Pubternal.CountBack(ip, ip - s.Offset, @base + s.Literal, @base);
+		}
+
+		return _result = result;
+	}
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public long CountPattern()
+	{
+		var result = 0L;
+		var limit = Limit;
+		foreach (var s in _patterns)
+		{
+			var ip = Base + s.Match;
+			result += Pubternal.CountPattern(ip, limit, *(uint*)ip);
+		}
+
+		return _result = result;
+	}
+}
@@ -0,0 +1,77 @@
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+using K4os.Compression.LZ4.Engine;
+
+namespace Benchmarks.Kernels;
+
+/// <summary>
+/// Hashing: <c>LZ4_hash4</c>, <c>LZ4_hash5</c> and <c>LZ4_hashPosition</c> (as used by fast
+/// compressor), and <c>LZ4HC_Insert</c> (hash chain update, as used by HC compressor).
+/// </summary>
+public unsafe class HashKernels: KernelBenchmark
+{
+	private const int InsertLength = Operations * 16;
+
+	private uint[] _sequences4 = null!;
+	private ulong[] _sequences8 = null!;
+	private int[] _positions = null!;
+	private int[] _inserts = null!;
+	private Pubternal.HighContext _context = null!;
+	private long _result;
+
+	protected override void Prepare()
+	{
+		var positions = Enumerable.Range(0, Sample.Length - sizeof(ulong)).ToArray();
+		_positions = Cycle(positions);
+		_sequences4 = _positions.Select(p => BitConverter.ToUInt32(Sample, p)).ToArray();
+		_sequences8 = _positions.Select(p => BitConverter.ToUInt64(Sample, p)).ToArray();
+
+		// HC compressor inserts positions up to the beginning of every sequence
+		_inserts = Sequences(LZ4Level.L09_HC)
+			.Select(s => s.Literal + s.LiteralLength)
+			.Where(p => p < InsertLength)
+			.Append(InsertLength)
+			.ToArray();
+		_context = new Pubternal.HighContext();
+	}
+
+	protected override void Release() => _context.Dispose();
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public long Hash4()
+	{
+		var result = 0L;
+		foreach (var sequence in _sequences4)
+			result += Pubternal.Hash4(sequence, false);
+		return _result = result;
+	}
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public long Hash5()
+	{
+		var result = 0L;
+		foreach (var sequence in _sequences8)
+			result += Pubternal.Hash5(sequence, false);
+		return _result = result;
+	}
+
+	[Benchmark(OperationsPerInvoke = Operations)]
+	public long HashPosition()
+	{
+		var result = 0L;
+		var @base = Base;
+		foreach (var position in _positions)
+			result += Pubternal.HashPosition(@base + position, false);
+		return _result = result;
+	}
+
+	[Benchmark(OperationsPerInvoke = InsertLength)]
+	public void Insert()
+	{
+		var @base = Base;
+		var context = _context;
+		context.Reset(@base);
+		foreach (var position in _inserts)
+			Pubternal.Insert(context, @base + position);
+	}
+}
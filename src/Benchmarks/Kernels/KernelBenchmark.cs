@@ -0,0 +1,133 @@
+using System.Runtime.InteropServices;
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+using K4os.Compression.LZ4.Internal;
+
+namespace Benchmarks.Kernels;
+
+/// <summary>
+/// Base for engine kernel microbenchmarks. Every benchmark calls one kernel
+/// <see cref="Operations"/> times, on inputs taken from how compressor actually
+/// encoded first <see cref="SampleSize"/> bytes of given corpus file, in 64-bit
+/// and 32-bit (<see cref="LZ4Codec.Enforce32"/>) mode.
+/// Run with: <c>--filter Benchmarks.Kernels.*</c>; on Windows, hardware counters
+/// can be added with <c>--counters BranchMispredictions+CacheMisses</c>.
+/// </summary>
+[DisassemblyDiagnoser(maxDepth: 2)]
+public abstract unsafe class KernelBenchmark
+{
+	protected const int Operations = 4096;
+	protected const int SampleSize = Mem.M1;
+
+	protected const int MINMATCH = 4;
+	protected const int LASTLITERALS = 5;
+
+	private GCHandle _handle;
+
+	protected byte[] Sample = null!;
+	protected byte* Base;
+	protected byte* Limit;
+
+	public static IEnumerable<string> Files => Corpus.Files();
+
+	[ParamsSource(nameof(Files))]
+	public string File { get; set; } = null!;
+
+	[Params(false, true)]
+	public bool Enforce32 { get; set; }
+
+	[GlobalSetup]
+	public void Setup()
+	{
+		LZ4Codec.Enforce32 = Enforce32;
+
+		var content = Corpus.Load(File);
+		Sample = content.AsSpan(0, Math.Min(content.Length, SampleSize)).ToArray();
+		_handle = GCHandle.Alloc(Sample, GCHandleType.Pinned);
+		Base = (byte*)_handle.AddrOfPinnedObject();
+		Limit = Base + Sample.Length - LASTLITERALS;
+
+		Prepare();
+	}
+
+	[GlobalCleanup]
+	public void Cleanup()
+	{
+		Release();
+		_handle.Free();
+		LZ4Codec.Enforce32 = false;
+	}
+
+	protected abstract void Prepare();
+
+	protected virtual void Release() { }
+
+	/// <summary>Sequences (literals followed by match) compressor produced for sample.</summary>
+	protected Sequence[] Sequences(LZ4Level level)
+	{
+		var buffer = new byte[LZ4Codec.MaximumOutputSize(Sample.Length)];
+		var length = LZ4Codec.Encode(Sample, buffer, level);
+		return Sequence.Parse(buffer.AsSpan(0, length)).ToArray();
+	}
+
+	/// <summary>Repeats (or truncates) inputs to exactly <see cref="Operations"/> items.</summary>
+	protected static T[] Cycle<T>(IReadOnlyList<T> items)
+	{
+		if (items.Count == 0)
+			throw new InvalidOperationException("Sample does not provide any input for this kernel");
+
+		var result = new T[Operations];
+		for (var i = 0; i < result.Length; i++)
+			result[i] = items[i % items.Count];
+		return result;
+	}
+}
+
+/// <summary>Literals followed by match, with positions relative to uncompressed block.</summary>
+public readonly record struct Sequence(
+	int Literal, int LiteralLength, int Match, int Offset, int MatchLength)
+{
+	public static List<Sequence> Parse(ReadOnlySpan<byte> block)
+	{
+		var result = new List<Sequence>();
+		var input = 0;
+		var output = 0;
+
+		while (input < block.Length)
+		{
+			var token = block[input++];
+			var literalLength = ReadLength(block, ref input, token >> 4);
+			var literal = output;
+			input += literalLength;
+			output += literalLength;
+
+			if (input >= block.Length)
+				break; // last literals
+
+			var offset = block[input] | (block[input + 1] << 8);
+			input += 2;
+			var matchLength = ReadLength(block, ref input, token & 0x0F) + 4;
+
+			result.Add(new Sequence(literal, literalLength, output, offset, matchLength));
+			output += matchLength;
+		}
+
+		return result;
+	}
+
+	private static int ReadLength(ReadOnlySpan<byte> block, ref int input, int length)
+	{
+		if (length != 15)
+			return length;
+
+		byte next;
+		do
+		{
+			next = block[input++];
+			length += next;
+		}
+		while (next == 255);
+
+		return length;
+	}
+}
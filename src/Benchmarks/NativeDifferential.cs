@@ -0,0 +1,91 @@
+using K4os.Compression.LZ4;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Checks that managed engine produces exactly the same blocks as native reference
+/// library, for every corpus file and level (in 64 and 32-bit mode), and that both
+/// can decode each other's output. Note, 32-bit fast mode produces different (but
+/// still valid) output than 64-bit native library, so it is only checked for decoding,
+/// and so are managed-only levels (see <see cref="HasNativeCounterpart"/>).
+/// Run with: <c>Benchmarks native-diff [file...]</c>
+/// </summary>
+public static class NativeDifferential
+{
+	public static int Run(IEnumerable<string> arguments)
+	{
+		if (!NativeLZ4.IsAvailable)
+		{
+			Console.Error.WriteLine("Native library (lz4ref) not found, build it with src/native/build.sh");
+			return 2;
+		}
+
+		var files = arguments.ToArray();
+		if (files.Length == 0) files = Corpus.Files().ToArray();
+
+		var failures = 0;
+		foreach (var file in files)
+		foreach (var level in Enum.GetValues<LZ4Level>())
+		foreach (var enforce32 in new[] { false, true })
+		{
+			var error = Check(Corpus.Load(file), level, enforce32);
+			Console.WriteLine($"{file} {level} {(enforce32 ? "x32" : "x64")}: {error ?? "OK"}");
+			if (error is not null) failures++;
+		}
+
+		Console.WriteLine(failures == 0 ? "All blocks identical" : $"{failures} check(s) failed");
+		return failures == 0 ? 0 : 1;
+	}
+
+	private static string? Check(byte[] original, LZ4Level level, bool enforce32)
+	{
+		var length = LZ4Codec.MaximumOutputSize(original.Length);
+		var managed = new byte[length];
+		var native = new byte[length];
+		var decoded = new byte[original.Length];
+
+		int managedLength;
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			managedLength = LZ4Codec.Encode(original, managed, level);
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+
+		var nativeLength = NativeLZ4.Encode(original, native, level);
+		var managedSpan = managed.AsSpan(0, managedLength);
+		var nativeSpan = native.AsSpan(0, nativeLength);
+
+		// 32-bit fast compressor uses different hash table layout than 64-bit one,
+		// so it can be compared byte-by-byte only with 32-bit native library
+		var exact =
+			HasNativeCounterpart(level) &&
+			(enforce32 == !Environment.Is64BitProcess || level != LZ4Level.L00_FAST);
+
+		if (exact && managedLength != nativeLength)
+			return $"Compressed length differs: {managedLength} (managed) vs {nativeLength} (native)";
+
+		if (exact && !managedSpan.SequenceEqual(nativeSpan))
+			return $"Compressed blocks differ at {managedSpan.CommonPrefixLength(nativeSpan)}";
+
+		if (NativeLZ4.Decode(managedSpan, decoded) != original.Length ||
+			!decoded.AsSpan().SequenceEqual(original))
+			return "Native decoder failed to decode managed block";
+
+		decoded.AsSpan().Clear();
+		if (LZ4Codec.Decode(nativeSpan, decoded) != original.Length ||
+			!decoded.AsSpan().SequenceEqual(original))
+			return "Managed decoder failed to decode native block";
+
+		return null;
+	}
+
+	// mid compressor has no counterpart in reference library (native HC runs level 2
+	// as plain HC with shallow search) and native library clamps ultra level to
+	// L12_MAX, blocks of both are only checked by cross-decoding
+	private static bool HasNativeCounterpart(LZ4Level level) =>
+		level is not (LZ4Level.L02_MID or LZ4Level.L13_ULTRA);
+}
@@ -0,0 +1,70 @@
+using System.Runtime.InteropServices;
+using K4os.Compression.LZ4;
+
+namespace Benchmarks;
+
+/// <summary>
+/// P/Invoke adapter for native reference library, built from <c>src/sanitized</c>
+/// (the C sources managed engine has been translated from) with <c>src/native/build.sh</c>.
+/// </summary>
+public static unsafe class NativeLZ4
+{
+	private const string Library = "lz4ref";
+
+	private static readonly Lazy<bool> Available = new(Probe);
+
+	[DllImport(Library)]
+	private static extern int LZ4_versionNumber();
+
+	[DllImport(Library)]
+	private static extern int LZ4_compress_fast(
+		byte* source, byte* target, int sourceLength, int targetLength, int acceleration);
+
+	[DllImport(Library)]
+	private static extern int LZ4_compress_HC(
+		byte* source, byte* target, int sourceLength, int targetLength, int level);
+
+	[DllImport(Library)]
+	private static extern int LZ4_decompress_safe(
+		byte* source, byte* target, int sourceLength, int targetLength);
+
+	/// <summary>Indicates if native library can be loaded.</summary>
+	public static bool IsAvailable => Available.Value;
+
+	/// <summary>Version of native library (for example, 10904 for 1.9.4).</summary>
+	public static int Version => LZ4_versionNumber();
+
+	private static bool Probe()
+	{
+		try
+		{
+			return LZ4_versionNumber() > 0;
+		}
+		catch (DllNotFoundException)
+		{
+			return false;
+		}
+	}
+
+	/// <summary>Compresses block the same way <see cref="LZ4Codec.Encode(ReadOnlySpan{byte},Span{byte},LZ4Level)"/> does.</summary>
+	public static int Encode(ReadOnlySpan<byte> source, Span<byte> target, LZ4Level level)
+	{
+		fixed (byte* sourceP = source)
+		fixed (byte* targetP = target)
+		{
+			return level == LZ4Level.L00_FAST
+				? LZ4_compress_fast(sourceP, targetP, source.Length, target.Length, 1)
+				: LZ4_compress_HC(sourceP, targetP, source.Length, target.Length, (int)level);
+		}
+	}
+
+	/// <summary>Decompresses block.</summary>
+	public static int Decode(ReadOnlySpan<byte> source, Span<byte> target)
+	{
+		fixed (byte* sourceP = source)
+		fixed (byte* targetP = target)
+		{
+			return LZ4_decompress_safe(sourceP, targetP, source.Length, target.Length);
+		}
+	}
+}
@@ -0,0 +1,63 @@
+using BenchmarkDotNet.Attributes;
+using K4os.Compression.LZ4;
+
+namespace Benchmarks;
+
+public enum Implementation
+{
+	Managed,
+	Native,
+}
+
+/// <summary>
+/// Managed engine against native reference library, for every corpus file and level.
+/// Native library needs to be built first with <c>src/native/build.sh</c>.
+/// Run with: <c>--filter *NativeVsManaged*</c>
+/// </summary>
+[Config(typeof(CorpusConfig))]
+public class NativeVsManaged: ICorpusBenchmark
+{
+	private byte[] _original = null!;
+	private byte[] _encoded = null!;
+	private byte[] _buffer = null!;
+	private byte[] _decoded = null!;
+
+	public static IEnumerable<string> Files => Corpus.Files();
+
+	[ParamsSource(nameof(Files))]
+	public string File { get; set; } = null!;
+
+	[ParamsAllValues]
+	public LZ4Level Level { get; set; }
+
+	[ParamsAllValues]
+	public Implementation Implementation { get; set; }
+
+	public long OriginalLength => _original.Length;
+	public long CompressedLength => _encoded.Length;
+
+	[GlobalSetup]
+	public void Setup()
+	{
+		if (Implementation == Implementation.Native && !NativeLZ4.IsAvailable)
+			throw new InvalidOperationException(
+				"Native library (lz4ref) not found, build it with src/native/build.sh");
+
+		_original = Corpus.Load(File);
+		_buffer = new byte[LZ4Codec.MaximumOutputSize(_original.Length)];
+		_encoded = _buffer.AsSpan(0, Encode()).ToArray();
+		_decoded = new byte[_original.Length];
+	}
+
+	[Benchmark]
+	public int Encode() =>
+		Implementation == Implementation.Native
+			? NativeLZ4.Encode(_original, _buffer, Level)
+			: LZ4Codec.Encode(_original, _buffer, Level);
+
+	[Benchmark]
+	public int Decode() =>
+		Implementation == Implementation.Native
+			? NativeLZ4.Decode(_encoded, _decoded)
+			: LZ4Codec.Decode(_encoded, _decoded);
+}
@@ -5,9 +5,16 @@ namespace Benchmarks
 {
 	class Program
 	{
-		static void Main(string[] args)
+		static int Main(string[] args)
 		{
+			if (args.Length > 0 && args[0] == "native-diff")
+				return NativeDifferential.Run(args.Skip(1));
+
+			if (args.Length > 0 && args[0] == "analyze")
+				return BlockAnalysis.Run(args.Skip(1));
+
 			BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args);
+			return 0;
 		}
 	}
 }
@@ -82,6 +82,8 @@ module Sanitizer =
         let strip =
             replaceText "async" "/*async*/" >>
             replaceText "await" "/*await*/" >>
+            replaceExpr "ValueTask[<](?<type>[A-Za-z0-9_]+[?]?)[>]" (fun g -> g "type") >>
+            replaceText "ValueTask" "void" >>
             replaceExpr "Task[<](?<type>[A-Za-z0-9_]+[?]?)[>]" (fun g -> g "type") >>
             replaceText "Task" "void" >>
             replaceRaw "\\s*\\.Weave\\(\\)" "" >>
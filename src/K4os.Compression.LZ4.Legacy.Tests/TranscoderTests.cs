@@ -0,0 +1,134 @@
+using System;
+using System.IO;
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+using Xunit;
+using FrameStream = K4os.Compression.LZ4.Streams.LZ4Stream;
+
+namespace K4os.Compression.LZ4.Legacy.Tests
+{
+	public class TranscoderTests
+	{
+		private static byte[] Compressible(int length)
+		{
+			var buffer = new byte[length];
+			Lorem.Fill(buffer, 0, length);
+			return buffer;
+		}
+
+		private static byte[] Random(int length)
+		{
+			var buffer = new byte[length];
+			new Random(length).NextBytes(buffer);
+			return buffer;
+		}
+
+		private static byte[] Legacy(byte[] data, bool high, int blockSize)
+		{
+			var output = new MemoryStream();
+			using (var encoder = LZ4Legacy.Encode(output, high, blockSize, true))
+			{
+				// uneven writes, so some chunks are not full
+				var offset = 0;
+				while (offset < data.Length)
+				{
+					var chunk = Math.Min(data.Length - offset, blockSize / 3 + 1337);
+					encoder.Write(data, offset, chunk);
+					encoder.Flush();
+					offset += chunk;
+				}
+			}
+
+			return output.ToArray();
+		}
+
+		private static byte[] Decode(byte[] frame)
+		{
+			var output = new MemoryStream();
+			using (var decoder = FrameStream.Decode(new MemoryStream(frame)))
+				decoder.CopyTo(output);
+			return output.ToArray();
+		}
+
+		[Theory]
+		[InlineData(0, false, Mem.K64)]
+		[InlineData(1337, false, Mem.K64)]
+		[InlineData(Mem.M1, false, Mem.K64)]
+		[InlineData(Mem.M1, true, Mem.K256)]
+		[InlineData(Mem.M4, false, Mem.M1)]
+		[InlineData(Mem.M4, true, Mem.M1)]
+		[InlineData(Mem.M4, false, 100000)]
+		[InlineData(8 * Mem.M1, false, 8 * Mem.M1)]
+		public void CompressibleStreamIsTranscoded(int length, bool high, int blockSize)
+		{
+			var data = Compressible(length);
+			var legacy = Legacy(data, high, blockSize);
+
+			var frame = new MemoryStream();
+			var total = LZ4Legacy.Transcode(new MemoryStream(legacy), frame, blockSize, true);
+
+			Assert.Equal(length, total);
+			Assert.Equal(data, Decode(frame.ToArray()));
+		}
+
+		[Theory]
+		[InlineData(Mem.M1, Mem.K64)]
+		[InlineData(Mem.M1, Mem.M1)]
+		[InlineData(8 * Mem.M1, 8 * Mem.M1)]
+		public void IncompressibleStreamIsTranscoded(int length, int blockSize)
+		{
+			var data = Random(length);
+			var legacy = Legacy(data, false, blockSize);
+
+			var frame = new MemoryStream();
+			LZ4Transcoder.Transcode(new MemoryStream(legacy), frame, blockSize, false, true);
+
+			Assert.Equal(data, Decode(frame.ToArray()));
+		}
+
+		[Theory]
+		[InlineData(0, false)]
+		[InlineData(1337, false)]
+		[InlineData(1337, true)]
+		[InlineData(Mem.M1, true)]
+		[InlineData(8 * Mem.M1, false)]
+		public void WrappedBufferIsTranscoded(int length, bool high)
+		{
+			var data = Compressible(length);
+			var wrapped = high ? LZ4Legacy.WrapHC(data) : LZ4Legacy.Wrap(data);
+
+			Assert.Equal(data, Decode(LZ4Legacy.TranscodeWrapped(wrapped)));
+		}
+
+		[Fact]
+		public void IncompressibleWrappedBufferIsTranscoded()
+		{
+			var data = Random(Mem.K256);
+			var wrapped = LZ4Legacy.Wrap(data);
+
+			Assert.Equal(data, Decode(LZ4Legacy.TranscodeWrapped(wrapped)));
+		}
+
+		[Fact]
+		public void CorruptedStreamIsRejected()
+		{
+			var legacy = Legacy(Compressible(Mem.K256), false, Mem.K64);
+			// first chunk starts with flags and original length, so original length
+			// does not match compressed data anymore
+			legacy[1] ^= 0x01;
+
+			Assert.Throws<InvalidDataException>(
+				() => LZ4Legacy.Transcode(new MemoryStream(legacy), new MemoryStream()));
+		}
+
+		[Fact]
+		public void TruncatedStreamIsRejected()
+		{
+			var legacy = Legacy(Compressible(Mem.K256), false, Mem.K64);
+			Array.Resize(ref legacy, legacy.Length - 100);
+
+			Assert.Throws<InvalidDataException>(
+				() => LZ4Legacy.Transcode(new MemoryStream(legacy), new MemoryStream()));
+		}
+	}
+}
@@ -66,4 +66,23 @@ public static class LZ4Legacy
 	/// </exception>
 	public static byte[] Unwrap(byte[] inputBuffer, int inputOffset = 0) =>
 		LZ4Wrapper.Unwrap(inputBuffer, inputOffset);
+
+	/// <summary>Converts data written by <see cref="LZ4Stream"/> into standard LZ4 frame,
+	/// without recompressing it.</summary>
+	/// <param name="source">Legacy stream.</param>
+	/// <param name="target">Target stream.</param>
+	/// <param name="blockSize">Block size legacy stream has been written with.</param>
+	/// <param name="leaveOpen">Indicates if target stream should be left open.</param>
+	/// <returns>Number of uncompressed bytes.</returns>
+	public static long Transcode(
+		Stream source, Stream target, int blockSize = 1024 * 1024, bool leaveOpen = false) =>
+		LZ4Transcoder.Transcode(source, target, blockSize, true, leaveOpen);
+
+	/// <summary>Converts buffer wrapped by <see cref="Wrap"/> or <see cref="WrapHC"/> into
+	/// standard LZ4 frame, without recompressing it.</summary>
+	/// <param name="inputBuffer">The input buffer.</param>
+	/// <param name="inputOffset">The input offset.</param>
+	/// <returns>LZ4 frame.</returns>
+	public static byte[] TranscodeWrapped(byte[] inputBuffer, int inputOffset = 0) =>
+		LZ4Transcoder.TranscodeWrapped(inputBuffer, inputOffset);
 }
\ No newline at end of file
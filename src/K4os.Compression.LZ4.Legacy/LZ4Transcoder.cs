@@ -0,0 +1,207 @@
+using System;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams;
+using K4os.Compression.LZ4.Streams.Frames;
+
+namespace K4os.Compression.LZ4.Legacy;
+
+/// <summary>
+/// Converts data produced by <see cref="LZ4Stream"/> and <see cref="LZ4Wrapper"/> into
+/// standard LZ4 frames, without recompression. Every legacy chunk is already a plain LZ4
+/// block (or stored data), so it is validated (by walking its tokens, not by decoding it)
+/// and written as independent frame block as it is. Only chunks larger than maximum frame
+/// block size (4MB) need to be decoded and compressed again (with fast compressor).
+/// Frames do not have content checksum, as it would require decoding all the data.
+/// </summary>
+public static class LZ4Transcoder
+{
+	private const int WRAP_LENGTH = 2 * sizeof(int);
+
+	/// <summary>Converts <see cref="LZ4Stream"/> data into LZ4 frame.</summary>
+	/// <param name="source">Stream with data written by <see cref="LZ4Stream"/>.</param>
+	/// <param name="target">Stream to write LZ4 frame to.</param>
+	/// <param name="blockSize">Block size legacy stream has been written with, frame block
+	/// size is chosen to fit it.</param>
+	/// <param name="blockChecksum">Indicates if frame should have block checksums.</param>
+	/// <param name="leaveOpen">Indicates if target stream should stay open.</param>
+	/// <returns>Number of uncompressed bytes transcoded.</returns>
+	/// <exception cref="InvalidDataException">Thrown when source is corrupted.</exception>
+	public static long Transcode(
+		Stream source, Stream target,
+		int blockSize = 1024 * 1024, bool blockChecksum = true, bool leaveOpen = false)
+	{
+		var total = 0L;
+		var buffer = Array.Empty<byte>();
+
+		var frameBlockSize = FrameBlockSize(blockSize);
+		using var writer = CreateWriter(target, frameBlockSize, blockChecksum, leaveOpen);
+		writer.OpenFrame();
+
+		while (TryReadVarInt(source, out var varint))
+		{
+			var flags = (LZ4Stream.ChunkFlags)varint;
+			var compressed = (flags & LZ4Stream.ChunkFlags.Compressed) != 0;
+			if (compressed && (int)flags >> 2 != 0)
+				throw new NotSupportedException("Chunks with multiple passes are not supported.");
+
+			var originalLength = ReadLength(source);
+			var compressedLength = compressed ? ReadLength(source) : originalLength;
+			if (compressedLength > originalLength)
+				throw Corrupted("Compressed chunk is longer than original");
+
+			if (buffer.Length < compressedLength)
+				buffer = new byte[compressedLength];
+
+			if (ReadBlock(source, buffer, compressedLength) != compressedLength)
+				throw Corrupted("Unexpected end of stream");
+
+			WriteChunk(
+				writer, frameBlockSize,
+				buffer.AsSpan(0, compressedLength), compressed, originalLength);
+			total += originalLength;
+		}
+
+		return total;
+	}
+
+	/// <summary>
+	/// Converts buffer produced by <see cref="LZ4Wrapper.Wrap(byte[],int,int)"/> into LZ4 frame.
+	/// </summary>
+	/// <param name="inputBuffer">Wrapped buffer.</param>
+	/// <param name="inputOffset">Wrapped buffer offset.</param>
+	/// <param name="blockChecksum">Indicates if frame should have block checksums.</param>
+	/// <returns>LZ4 frame.</returns>
+	/// <exception cref="InvalidDataException">Thrown when buffer is corrupted.</exception>
+	public static byte[] TranscodeWrapped(
+		byte[] inputBuffer, int inputOffset = 0, bool blockChecksum = true)
+	{
+		var inputLength = inputBuffer.Length - inputOffset;
+		if (inputLength < WRAP_LENGTH)
+			throw new ArgumentException("inputBuffer size is invalid");
+
+		var outputLength = BitConverter.ToInt32(inputBuffer, inputOffset);
+		var dataLength = BitConverter.ToInt32(inputBuffer, inputOffset + sizeof(int));
+		if (dataLength < 0 || outputLength < 0 || dataLength > inputLength - WRAP_LENGTH)
+			throw new ArgumentException("inputBuffer size is invalid or has been corrupted");
+
+		var data = inputBuffer.AsSpan(inputOffset + WRAP_LENGTH, dataLength);
+		var output = new MemoryStream(dataLength + 32);
+
+		var frameBlockSize = FrameBlockSize(outputLength);
+		using (var writer = CreateWriter(output, frameBlockSize, blockChecksum, true))
+		{
+			writer.OpenFrame();
+			WriteChunk(
+				writer, frameBlockSize, data, dataLength < outputLength, outputLength);
+		}
+
+		return output.ToArray();
+	}
+
+	private static StreamLZ4FrameWriter CreateWriter(
+		Stream target, int blockSize, bool blockChecksum, bool leaveOpen) =>
+		LZ4Frame.Encode(
+			target,
+			new LZ4EncoderSettings {
+				BlockSize = blockSize,
+				ChainBlocks = false,
+				BlockChecksum = blockChecksum,
+				ContentChecksum = false,
+			},
+			leaveOpen);
+
+	private static int FrameBlockSize(int blockSize) =>
+		blockSize <= Mem.K64 ? Mem.K64 :
+		blockSize <= Mem.K256 ? Mem.K256 :
+		blockSize <= Mem.M1 ? Mem.M1 :
+		Mem.M4;
+
+	private static void WriteChunk(
+		StreamLZ4FrameWriter writer, int blockSize,
+		ReadOnlySpan<byte> chunk, bool compressed, int originalLength)
+	{
+		if (originalLength == 0)
+			return;
+
+		if (!compressed)
+		{
+			// stored chunks can be split into blocks of any size
+			for (var offset = 0; offset < chunk.Length; offset += blockSize)
+			{
+				var length = Math.Min(blockSize, chunk.Length - offset);
+				writer.WriteRawBlock(chunk.Slice(offset, length), false);
+			}
+
+			return;
+		}
+
+		var decodedLength = LZ4Codec.GetDecodedLength(chunk);
+		if (decodedLength != originalLength)
+			throw Corrupted(
+				$"Chunk should decode to {originalLength} bytes but it is {decodedLength}");
+
+		if (originalLength <= blockSize)
+		{
+			writer.WriteRawBlock(chunk);
+			return;
+		}
+
+		// too big for any frame block, so it needs to be decoded and encoded again
+		var decoded = new byte[originalLength];
+		if (LZ4Codec.Decode(chunk, decoded) != originalLength)
+			throw Corrupted("Chunk cannot be decoded");
+
+		writer.WriteManyBytes(decoded);
+	}
+
+	private static bool TryReadVarInt(Stream stream, out ulong result)
+	{
+		var count = 0;
+		result = 0;
+
+		while (true)
+		{
+			var b = stream.ReadByte();
+			if (b < 0)
+			{
+				if (count == 0) return false;
+
+				throw Corrupted("Unexpected end of stream");
+			}
+
+			result += (ulong)(b & 0x7F) << count;
+			count += 7;
+			if ((b & 0x80) == 0 || count >= 64) break;
+		}
+
+		return true;
+	}
+
+	private static int ReadLength(Stream stream)
+	{
+		if (!TryReadVarInt(stream, out var length))
+			throw Corrupted("Unexpected end of stream");
+
+		return length <= int.MaxValue
+			? (int)length
+			: throw Corrupted($"Invalid chunk length {length}");
+	}
+
+	private static int ReadBlock(Stream stream, byte[] buffer, int length)
+	{
+		var total = 0;
+
+		while (total < length)
+		{
+			var read = stream.Read(buffer, total, length - total);
+			if (read == 0) break;
+
+			total += read;
+		}
+
+		return total;
+	}
+
+	private static InvalidDataException Corrupted(string message) =>
+		new($"Legacy stream is corrupted: {message}");
+}
@@ -0,0 +1,115 @@
+using K4os.Compression.LZ4.Encoders;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Frames;
+using K4os.Compression.LZ4.Streams.Tests.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class AdaptiveLevelTests
+{
+	private static byte[] Source()
+	{
+		// compressible text with incompressible chunks in between
+		var source = Lorem.Create(4 * Mem.M1 + 1337);
+		var random = new Random(0);
+		for (var offset = Mem.K256; offset < source.Length; offset += Mem.M1)
+			random.NextBytes(source.AsSpan(offset, Mem.K256));
+		return source;
+	}
+
+	private static LZ4EncoderSettings Settings(bool chaining, double throughput) =>
+		FrameTools.Settings(
+			chaining, blockChecksum: false, configure: s => {
+				s.CompressionLevel = LZ4Level.L03_HC;
+				s.AdaptiveLevel = new LZ4AdaptiveParameters {
+					MaxLevel = LZ4Level.L11_OPT, TargetThroughput = throughput,
+				};
+			});
+
+	[Theory]
+	[InlineData(true, 1)]
+	[InlineData(true, 100e6)]
+	[InlineData(true, 1e15)]
+	[InlineData(false, 100e6)]
+	public async Task AdaptiveFrameCanBeDecoded(bool chaining, double throughput)
+	{
+		var source = Source();
+		var target = new MemoryStream();
+		using (var encoder = LZ4Stream.Encode(target, Settings(chaining, throughput), true))
+		{
+			for (var offset = 0; offset < source.Length; offset += 12345)
+				await encoder.WriteAsync(source, offset, Math.Min(12345, source.Length - offset));
+		}
+
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+		Tools.SameBytes(source, LZ4Frame.Decode(target.ToArray(), new BufferWriter()).WrittenSpan.ToArray());
+	}
+
+	[Theory]
+	[InlineData(1, LZ4Level.L11_OPT)]
+	[InlineData(1e15, LZ4Level.L00_FAST)]
+	public void WriterFeedsLevelController(double throughput, LZ4Level expected)
+	{
+		var source = Lorem.Create(64 * Mem.K64);
+		var settings = Settings(true, throughput);
+		LZ4AdaptiveEncoder? encoder = null;
+
+		var target = new MemoryStream();
+		using (var writer = new StreamLZ4FrameWriter(
+			target, true,
+			d => encoder = (LZ4AdaptiveEncoder)d.CreateEncoder(settings),
+			settings.CreateDescriptor()))
+		{
+			writer.WriteManyBytes(source);
+			Assert.NotNull(encoder);
+			Assert.Equal(expected, encoder!.Level);
+			Assert.Equal(expected, encoder.Controller.Level);
+		}
+
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+	}
+
+	[Theory]
+	[InlineData(20, 1, LZ4Level.L00_FAST, LZ4Level.L09_HC)]
+	[InlineData(0, 0, LZ4Level.L09_HC, LZ4Level.L00_FAST)]
+	public async Task BackpressureFollowsInnerStream(
+		int delay, int pending, LZ4Level initial, LZ4Level expected)
+	{
+		var source = Lorem.Create(32 * Mem.K64);
+		var settings = new LZ4EncoderSettings {
+			ChainBlocks = true,
+			BlockSize = Mem.K64,
+			CompressionLevel = initial,
+			AdaptiveLevel = new LZ4AdaptiveParameters { Backpressure = true },
+		};
+		LZ4AdaptiveEncoder? encoder = null;
+
+		// slow stream (like WAN link) leaves time for better compression,
+		// memory stream makes compression the bottleneck
+		Stream target = delay > 0
+			? new SlowStream { Delay = delay }
+			: new MemoryStream();
+		using (var writer = new StreamLZ4FrameWriter(
+			target, true,
+			d => encoder = (LZ4AdaptiveEncoder)d.CreateEncoder(settings),
+			settings.CreateDescriptor()) { MaxPendingWrites = pending })
+		{
+			await writer.WriteManyBytesAsync(CancellationToken.None, source);
+			Assert.NotNull(encoder);
+			Assert.Equal(expected, encoder!.Level);
+			await writer.CloseFrameAsync();
+		}
+
+		Tools.SameBytes(source, FrameTools.Decode(((MemoryStream)target).ToArray()));
+	}
+
+	[Fact]
+	public void AdaptiveLevelNeedsTarget()
+	{
+		var settings = new LZ4EncoderSettings { AdaptiveLevel = new LZ4AdaptiveParameters() };
+		Assert.Throws<ArgumentException>(
+			() => LZ4Frame.Encode(Lorem.Create(Mem.K64).AsSpan(), new BufferWriter(), settings));
+	}
+}
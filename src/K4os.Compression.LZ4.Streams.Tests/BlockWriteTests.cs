@@ -0,0 +1,83 @@
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Tests.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class BlockWriteTests
+{
+	// NOTE: MemoryStream.WriteAsync completes synchronously by calling Write
+	public class CountingStream: MemoryStream
+	{
+		public int Writes { get; private set; }
+
+		public override void Write(byte[] buffer, int offset, int count)
+		{
+			Writes++;
+			base.Write(buffer, offset, count);
+		}
+	}
+
+	private static LZ4EncoderSettings Settings(bool chaining, bool checksums) =>
+		FrameTools.Settings(chaining, checksums, checksums);
+
+	[Theory]
+	[InlineData(false, false, 1)]
+	[InlineData(true, true, 1)]
+	[InlineData(false, true, 4)]
+	[InlineData(true, false, 7)]
+	public void EachBlockIsWrittenWithSingleCall(bool chaining, bool checksums, int blocks)
+	{
+		// last block is partial, so it is written together with frame tail
+		var source = Lorem.Create(blocks * Mem.K64 - 1337);
+		var target = new CountingStream();
+
+		using (var encoder = LZ4Stream.Encode(target, Settings(chaining, checksums), true))
+			encoder.Write(source, 0, source.Length);
+
+		// frame header + one write per block
+		Assert.Equal(1 + blocks, target.Writes);
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+	}
+
+	[Theory]
+	[InlineData(false, true, 4)]
+	[InlineData(true, true, 3)]
+	public async Task EachBlockIsWrittenWithSingleCallAsync(
+		bool chaining, bool checksums, int blocks)
+	{
+		var source = Lorem.Create(blocks * Mem.K64 - 1337);
+		var target = new CountingStream();
+
+		using (var encoder = LZ4Stream.Encode(target, Settings(chaining, checksums), true))
+			await encoder.WriteAsync(source, 0, source.Length);
+
+		Assert.Equal(1 + blocks, target.Writes);
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+	}
+
+	[Fact]
+	public void FrameTailIsWrittenSeparatelyAfterFullBlock()
+	{
+		var source = Lorem.Create(2 * Mem.K64);
+		var target = new CountingStream();
+
+		using (var encoder = LZ4Stream.Encode(target, Settings(true, true), true))
+			encoder.Write(source, 0, source.Length);
+
+		Assert.Equal(1 + 2 + 1, target.Writes);
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+	}
+
+	[Fact]
+	public void EmptyFrameIsStillValid()
+	{
+		var target = new CountingStream();
+
+		using (var encoder = LZ4Stream.Encode(target, Settings(true, true), true))
+			encoder.Write(Array.Empty<byte>(), 0, 0);
+
+		Assert.Equal(0, FrameTools.Decode(target.ToArray()).Length);
+	}
+}
@@ -0,0 +1,113 @@
+using System.Text;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Frames;
+using K4os.Compression.LZ4.Streams.Tests.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class FlushBlockTests
+{
+	private static LZ4EncoderSettings Settings(bool chaining, bool flushBlocks = true) =>
+		FrameTools.Settings(chaining, configure: s => s.FlushBlocks = flushBlocks);
+
+	private static byte[] Message(int index) =>
+		Encoding.UTF8.GetBytes(
+			$"message {index}: {Encoding.UTF8.GetString(Lorem.Create(200 + index * 7))}");
+
+	// decodes everything written so far (frame is not closed yet)
+	private static byte[] DecodeSoFar(MemoryStream encoded, int length)
+	{
+		var decoder = LZ4Stream.Decode(
+			new MemoryStream(encoded.ToArray()), interactive: true);
+		var buffer = new byte[length];
+		var offset = 0;
+		while (offset < length)
+		{
+			var read = decoder.Read(buffer, offset, length - offset);
+			Assert.True(read > 0);
+			offset += read;
+		}
+
+		return buffer;
+	}
+
+	[Theory]
+	[InlineData(false)]
+	[InlineData(true)]
+	public void FlushedMessagesCanBeDecodedBeforeFrameIsClosed(bool chaining)
+	{
+		var encoded = new MemoryStream();
+		var written = new MemoryStream();
+
+		using (var encoder = LZ4Stream.Encode(encoded, Settings(chaining), true))
+		{
+			for (var i = 0; i < 10; i++)
+			{
+				var message = Message(i);
+				encoder.Write(message, 0, message.Length);
+				written.Write(message, 0, message.Length);
+				encoder.Flush();
+
+				Assert.Equal(
+					written.ToArray(),
+					DecodeSoFar(encoded, (int)written.Length));
+			}
+		}
+
+		Assert.Equal(written.ToArray(), FrameTools.Decode(encoded.ToArray()));
+	}
+
+	[Fact]
+	public void FlushIsIgnoredByDefault()
+	{
+		var encoded = new MemoryStream();
+
+		using (var encoder = LZ4Stream.Encode(encoded, Settings(true, false), true))
+		{
+			var message = Message(0);
+			encoder.Write(message, 0, message.Length);
+			encoder.Flush();
+
+			// only frame header has been written
+			Assert.True(encoded.Length < 16);
+		}
+	}
+
+	[Fact]
+	public void ChainedBlocksReferenceFlushedData()
+	{
+		static int Length(bool chaining)
+		{
+			var encoded = new MemoryStream();
+			using var writer = LZ4Frame.Encode(encoded, Settings(chaining), true);
+			for (var i = 0; i < 10; i++)
+			{
+				writer.WriteManyBytes(Message(0));
+				writer.FlushBlock();
+			}
+
+			writer.CloseFrame();
+			return (int)encoded.Length;
+		}
+
+		// same message repeated can be encoded as single match when history is kept
+		Assert.True(Length(true) < Length(false) / 2);
+	}
+
+	[Fact]
+	public async Task FlushBlockAsyncWritesPartialBlock()
+	{
+		var encoded = new MemoryStream();
+		var message = Message(1);
+
+		using (var writer = LZ4Frame.Encode(encoded, Settings(true), true))
+		{
+			await writer.WriteManyBytesAsync(CancellationToken.None, message);
+			await writer.FlushBlockAsync();
+
+			Assert.Equal(message, DecodeSoFar(encoded, message.Length));
+		}
+	}
+}
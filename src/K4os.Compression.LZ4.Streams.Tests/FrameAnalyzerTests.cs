@@ -0,0 +1,67 @@
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class FrameAnalyzerTests
+{
+	private static MemoryStream Encode(byte[] source, LZ4EncoderSettings settings)
+	{
+		var encoded = new MemoryStream();
+		using (var encoder = LZ4Stream.Encode(encoded, settings, true))
+			encoder.Write(source, 0, source.Length);
+		encoded.Position = 0;
+		return encoded;
+	}
+
+	[Theory]
+	[InlineData(true, LZ4Level.L00_FAST)]
+	[InlineData(false, LZ4Level.L00_FAST)]
+	[InlineData(true, LZ4Level.L09_HC)]
+	public void FrameIsWalkedWithoutDecoding(bool chaining, LZ4Level level)
+	{
+		var source = Lorem.Create(Mem.K256 + 1337);
+		var encoded = Encode(source, new LZ4EncoderSettings {
+			ChainBlocks = chaining,
+			CompressionLevel = level,
+			BlockSize = Mem.K64,
+			BlockChecksum = true,
+			ContentChecksum = true,
+		});
+
+		var stats = LZ4Frame.Analyze(encoded);
+
+		Assert.Equal(5, stats.Blocks);
+		Assert.Equal(source.Length, stats.DecodedBytes);
+		Assert.Equal(source.Length, stats.LiteralBytes + stats.MatchBytes);
+		Assert.Equal(encoded.Length, encoded.Position);
+	}
+
+	[Fact]
+	public void ConcatenatedFramesAndStoredBlocksAreAnalyzed()
+	{
+		var random = new byte[Mem.K64];
+		new Random(0).NextBytes(random);
+		var settings = new LZ4EncoderSettings { BlockSize = Mem.K64 };
+
+		var stream = new MemoryStream();
+		Encode(random, settings).CopyTo(stream);
+		Encode(Lorem.Create(Mem.K64), settings).CopyTo(stream);
+		stream.Position = 0;
+
+		var stats = LZ4Frame.Analyze(stream);
+
+		Assert.Equal(2, stats.Blocks);
+		Assert.Equal(1, stats.StoredBlocks);
+		Assert.Equal(2 * Mem.K64, stats.DecodedBytes);
+	}
+
+	[Fact]
+	public void TruncatedFrameIsRejected()
+	{
+		var encoded = Encode(Lorem.Create(Mem.K64), new LZ4EncoderSettings()).ToArray();
+		var truncated = new MemoryStream(encoded, 0, encoded.Length - 10);
+		Assert.Throws<InvalidDataException>(() => LZ4Frame.Analyze(truncated));
+	}
+}
@@ -0,0 +1,40 @@
+using K4os.Compression.LZ4.Internal;
+
+namespace K4os.Compression.LZ4.Streams.Tests.Internal;
+
+public static class FrameTools
+{
+	/// <summary>
+	/// Frame settings used by stream tests: small (64KB) blocks, so few of them fit in
+	/// test data, with checksums. Anything else is set with <paramref name="configure"/>.
+	/// </summary>
+	public static LZ4EncoderSettings Settings(
+		bool chaining, bool blockChecksum = true, bool contentChecksum = true,
+		Action<LZ4EncoderSettings>? configure = null)
+	{
+		var settings = new LZ4EncoderSettings {
+			ChainBlocks = chaining,
+			BlockSize = Mem.K64,
+			BlockChecksum = blockChecksum,
+			ContentChecksum = contentChecksum,
+		};
+		configure?.Invoke(settings);
+		return settings;
+	}
+
+	public static byte[] Encode(byte[] source, LZ4EncoderSettings settings)
+	{
+		var encoded = new MemoryStream();
+		using (var encoder = LZ4Stream.Encode(encoded, settings, true))
+			encoder.Write(source, 0, source.Length);
+		return encoded.ToArray();
+	}
+
+	public static byte[] Decode(byte[] encoded)
+	{
+		using var decoder = LZ4Stream.Decode(new MemoryStream(encoded));
+		using var decoded = new MemoryStream();
+		decoder.CopyTo(decoded);
+		return decoded.ToArray();
+	}
+}
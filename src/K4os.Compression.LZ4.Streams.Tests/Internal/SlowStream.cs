@@ -0,0 +1,92 @@
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests.Internal;
+
+/// <summary>
+/// Memory stream which completes asynchronous reads and writes after a delay (reads
+/// returning at most <see cref="MaxRead"/> bytes), tracking how many of them are in
+/// flight. Writes check that buffer is not touched by caller until they complete.
+/// Delays can ignore cancellation (like some network streams do).
+/// </summary>
+public class SlowStream: MemoryStream
+{
+	private int _inFlight;
+
+	public SlowStream() { }
+
+	public SlowStream(byte[] buffer): base(buffer) { }
+
+	public int InFlight => _inFlight;
+	public int MaxInFlight { get; private set; }
+	public int Delay { get; set; } = 1;
+	public int MaxRead { get; set; } = 7777;
+	public int FailAfter { get; set; } = int.MaxValue;
+	public int Writes { get; private set; }
+	public bool IgnoreCancellation { get; set; }
+
+	public override Task<int> ReadAsync(
+		byte[] buffer, int offset, int count, CancellationToken token) =>
+		SlowRead(buffer, offset, count, token);
+
+	public override Task WriteAsync(
+		byte[] buffer, int offset, int count, CancellationToken token) =>
+		SlowWrite(buffer, offset, count, token);
+
+#if NET5_0_OR_GREATER
+	public override async ValueTask<int> ReadAsync(
+		Memory<byte> buffer, CancellationToken token = default)
+	{
+		var temp = new byte[buffer.Length];
+		var read = await SlowRead(temp, 0, temp.Length, token);
+		temp.AsSpan(0, read).CopyTo(buffer.Span);
+		return read;
+	}
+
+	public override ValueTask WriteAsync(
+		ReadOnlyMemory<byte> buffer, CancellationToken token = default) =>
+		new(SlowWrite(buffer.ToArray(), 0, buffer.Length, token));
+#endif
+
+	private async Task<int> SlowRead(
+		byte[] buffer, int offset, int count, CancellationToken token)
+	{
+		Enter();
+		try
+		{
+			await Task.Delay(Delay, IgnoreCancellation ? CancellationToken.None : token);
+			return base.Read(buffer, offset, Math.Min(count, MaxRead));
+		}
+		finally
+		{
+			Leave();
+		}
+	}
+
+	private async Task SlowWrite(
+		byte[] buffer, int offset, int count, CancellationToken token)
+	{
+		Enter();
+		try
+		{
+			// buffer must not be touched until write completes
+			var copy = buffer.AsSpan(offset, count).ToArray();
+			await Task.Delay(Delay, IgnoreCancellation ? CancellationToken.None : token);
+			Assert.True(copy.AsSpan().SequenceEqual(buffer.AsSpan(offset, count)));
+			if (++Writes > FailAfter) throw new IOException("Write failed");
+
+			base.Write(buffer, offset, count);
+		}
+		finally
+		{
+			Leave();
+		}
+	}
+
+	private void Enter()
+	{
+		var inFlight = Interlocked.Increment(ref _inFlight);
+		MaxInFlight = Math.Max(MaxInFlight, inFlight);
+	}
+
+	private void Leave() => Interlocked.Decrement(ref _inFlight);
+}
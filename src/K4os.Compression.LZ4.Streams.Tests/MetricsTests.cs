@@ -0,0 +1,158 @@
+#if NET5_0_OR_GREATER
+
+using System.Diagnostics.Metrics;
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class MetricsTests
+{
+	// measurements are reported synchronously on thread doing the work, so recording
+	// only current thread makes it immune to other tests running in parallel
+	private sealed class Recorder: IDisposable
+	{
+		private readonly MeterListener _listener = new();
+		private readonly int _thread = Environment.CurrentManagedThreadId;
+		private readonly Dictionary<string, double> _values = new();
+
+		public Recorder()
+		{
+			_listener.InstrumentPublished = (instrument, listener) => {
+				if (instrument.Meter.Name == LZ4Metrics.MeterName)
+					listener.EnableMeasurementEvents(instrument);
+			};
+			_listener.SetMeasurementEventCallback<long>(
+				(i, v, t, _) => Record(i, v, t));
+			_listener.SetMeasurementEventCallback<double>(
+				(i, v, t, _) => Record(i, 1, t));
+			_listener.Start();
+		}
+
+		private void Record(
+			Instrument instrument, double value,
+			ReadOnlySpan<KeyValuePair<string, object?>> tags)
+		{
+			if (Environment.CurrentManagedThreadId != _thread) return;
+
+			string? operation = null, api = null;
+			foreach (var tag in tags)
+			{
+				if (tag.Key == "lz4.operation") operation = (string?)tag.Value;
+				else if (tag.Key == "lz4.api") api = (string?)tag.Value;
+			}
+
+			var key = $"{instrument.Name}/{operation}/{api}";
+			_values[key] = this[key] + value;
+		}
+
+		public double this[string key] => _values.TryGetValue(key, out var v) ? v : 0;
+
+		public void Dispose() => _listener.Dispose();
+	}
+
+	[Fact]
+	public void CodecReportsBytesAndBlocks()
+	{
+		var source = Lorem.Create(Mem.K64);
+		var target = new byte[LZ4Codec.MaximumOutputSize(source.Length)];
+
+		using var recorder = new Recorder();
+		var encoded = LZ4Codec.Encode(source, target, LZ4Level.L00_FAST);
+		var decoded = LZ4Codec.Decode(target, 0, encoded, source, 0, source.Length);
+
+		Assert.Equal(source.Length, decoded);
+		Assert.Equal(1, recorder["lz4.blocks/encode/codec"]);
+		Assert.Equal(source.Length, recorder["lz4.bytes.in/encode/codec"]);
+		Assert.Equal(encoded, recorder["lz4.bytes.out/encode/codec"]);
+		Assert.Equal(1, recorder["lz4.block.duration/encode/codec"]);
+		Assert.Equal(1, recorder["lz4.blocks/decode/codec"]);
+		Assert.Equal(encoded, recorder["lz4.bytes.in/decode/codec"]);
+		Assert.Equal(source.Length, recorder["lz4.bytes.out/decode/codec"]);
+	}
+
+	[Theory]
+	[InlineData(false, true)]
+	[InlineData(true, true)]
+	[InlineData(false, false)]
+	[InlineData(true, false)]
+	public void FrameReportsBlocksAndChecksums(bool incompressible, bool chaining)
+	{
+		var source = incompressible ? new byte[Mem.K256] : Lorem.Create(Mem.K256);
+		if (incompressible) new Random(0).NextBytes(source);
+
+		var settings = new LZ4EncoderSettings {
+			BlockSize = Mem.K64,
+			BlockChecksum = true,
+			ContentChecksum = true,
+			ChainBlocks = chaining,
+		};
+
+		using var recorder = new Recorder();
+
+		var encoded = new MemoryStream();
+		using (var encoder = LZ4Stream.Encode(encoded, settings))
+			encoder.Write(source, 0, source.Length);
+
+		var decoded = new MemoryStream();
+		using (var decoder = LZ4Stream.Decode(new MemoryStream(encoded.ToArray())))
+			decoder.CopyTo(decoded);
+
+		Assert.Equal(source, decoded.ToArray());
+
+		const int blocks = 4;
+		var uncompressed = incompressible ? blocks : 0;
+
+		Assert.Equal(blocks, recorder["lz4.blocks/encode/frame"]);
+		Assert.Equal(uncompressed, recorder["lz4.blocks.uncompressed/encode/frame"]);
+		Assert.Equal(source.Length, recorder["lz4.bytes.in/encode/frame"]);
+		Assert.Equal(blocks, recorder["lz4.block.duration/encode/frame"]);
+
+		Assert.Equal(blocks, recorder["lz4.blocks/decode/frame"]);
+		Assert.Equal(uncompressed, recorder["lz4.blocks.uncompressed/decode/frame"]);
+		Assert.Equal(source.Length, recorder["lz4.bytes.out/decode/frame"]);
+		Assert.Equal(
+			recorder["lz4.bytes.out/encode/frame"],
+			recorder["lz4.bytes.in/decode/frame"]);
+
+		// block checksum for every block, content checksum for every write/read
+		Assert.True(recorder["lz4.checksum.duration/encode/frame"] > blocks);
+		Assert.True(recorder["lz4.checksum.duration/decode/frame"] > blocks);
+
+		// frame encoders and decoders (and verifier) are not reported as block codec api
+		Assert.True(LZ4Frame.Verify(new MemoryStream(encoded.ToArray())).Valid);
+		Assert.Equal(0, recorder["lz4.blocks/encode/codec"]);
+		Assert.Equal(0, recorder["lz4.blocks/decode/codec"]);
+		Assert.Equal(0, recorder["lz4.bytes.in/encode/codec"]);
+		Assert.Equal(0, recorder["lz4.bytes.in/decode/codec"]);
+	}
+
+	[Fact]
+	public void FrameReportsWritesAndLevelChanges()
+	{
+		var source = Lorem.Create(Mem.K256);
+		var settings = new LZ4EncoderSettings {
+			BlockSize = Mem.K64,
+			ChainBlocks = true,
+			CompressionLevel = LZ4Level.L12_MAX,
+			// no compression level can keep up with that
+			AdaptiveLevel = new LZ4AdaptiveParameters {
+				MaxLevel = LZ4Level.L12_MAX, TargetThroughput = 1e15,
+			},
+		};
+
+		using var recorder = new Recorder();
+
+		var encoded = new MemoryStream();
+		using (var encoder = LZ4Stream.Encode(encoded, settings))
+			encoder.Write(source, 0, source.Length);
+
+		const int blocks = 4;
+
+		Assert.Equal(blocks, recorder["lz4.write.duration/encode/frame"]);
+		Assert.Equal(1, recorder["lz4.level.changes/encode/frame"]);
+	}
+}
+
+#endif
@@ -0,0 +1,145 @@
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Frames;
+using K4os.Compression.LZ4.Streams.Tests.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class PendingWritesTests
+{
+	private static LZ4EncoderSettings Settings(bool chaining, int pending) =>
+		FrameTools.Settings(chaining, configure: s => s.MaxPendingWrites = pending);
+
+	[Theory]
+	[InlineData(true, 0)]
+	[InlineData(true, 1)]
+	[InlineData(false, 2)]
+	[InlineData(true, 4)]
+	public async Task PipelinedWritesProduceSameFrame(bool chaining, int pending)
+	{
+		var source = Lorem.Create(13 * Mem.K64 + 1337);
+		var expected = new MemoryStream();
+		using (var encoder = LZ4Stream.Encode(expected, Settings(chaining, 0), true))
+			encoder.Write(source, 0, source.Length);
+
+		var target = new SlowStream();
+		using (var encoder = LZ4Stream.Encode(target, Settings(chaining, pending), true))
+		{
+			var offset = 0;
+			while (offset < source.Length)
+			{
+				var chunk = Math.Min(source.Length - offset, 12345);
+				await encoder.WriteAsync(source, offset, chunk);
+				offset += chunk;
+			}
+		}
+
+		Tools.SameBytes(expected.ToArray(), target.ToArray());
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+		Assert.Equal(1, target.MaxInFlight);
+	}
+
+	[Fact]
+	public async Task MixingBlockingAndAsyncWritesKeepsOrder()
+	{
+		var source = Lorem.Create(8 * Mem.K64);
+		var target = new SlowStream();
+
+		using (var encoder = LZ4Stream.Encode(target, Settings(true, 3), true))
+		{
+			await encoder.WriteAsync(source, 0, 3 * Mem.K64);
+			encoder.Write(source, 3 * Mem.K64, 2 * Mem.K64);
+			await encoder.WriteAsync(source, 5 * Mem.K64, 3 * Mem.K64);
+		}
+
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+	}
+
+	private class CountingWriter: StreamLZ4FrameWriter
+	{
+		public CountingWriter(Stream stream, LZ4EncoderSettings settings):
+			base(stream, true, d => d.CreateEncoder(settings), settings.CreateDescriptor()) =>
+			MaxPendingWrites = settings.MaxPendingWrites;
+
+		public int Allocated { get; private set; }
+		public int Released { get; private set; }
+
+		protected override byte[] AllocateBuffer(int size)
+		{
+			Allocated++;
+			return base.AllocateBuffer(size);
+		}
+
+		protected override void ReleaseBuffer(byte[] buffer)
+		{
+			Released++;
+			base.ReleaseBuffer(buffer);
+		}
+	}
+
+	[Fact]
+	public async Task CancelledWriteDoesNotBreakPendingWrites()
+	{
+		var source = Lorem.Create(8 * Mem.K64);
+		var target = new SlowStream { Delay = 20 };
+
+		using (var encoder = LZ4Stream.Encode(target, Settings(true, 2), true))
+		{
+			for (var i = 0; i < 8; i++)
+			{
+				// writing whole block, so it gets queued before waiting is cancelled
+				if (i != 3)
+				{
+					await encoder.WriteAsync(source, i * Mem.K64, Mem.K64);
+					continue;
+				}
+
+				using var timeout = new CancellationTokenSource(5);
+				await Assert.ThrowsAnyAsync<OperationCanceledException>(
+					() => encoder.WriteAsync(source, i * Mem.K64, Mem.K64, timeout.Token));
+			}
+		}
+
+		Tools.SameBytes(source, FrameTools.Decode(target.ToArray()));
+	}
+
+	[Fact]
+	public async Task FailedPendingWritesReleaseBuffers()
+	{
+		var source = Lorem.Create(8 * Mem.K64);
+		var target = new SlowStream { FailAfter = 2 };
+		var writer = new CountingWriter(target, Settings(true, 3));
+
+		await Assert.ThrowsAsync<IOException>(
+			async () => {
+				await writer.WriteManyBytesAsync(CancellationToken.None, source);
+				await writer.CloseFrameAsync();
+			});
+
+		try
+		{
+			await writer.CloseFrameAsync();
+		}
+		catch (IOException)
+		{
+			// failure might be reported again
+		}
+
+		Assert.True(writer.Allocated > 1);
+		Assert.Equal(writer.Allocated, writer.Released);
+	}
+
+	[Fact]
+	public async Task FailedPendingWriteIsReported()
+	{
+		var source = Lorem.Create(8 * Mem.K64);
+		var target = new SlowStream { FailAfter = 2 };
+
+		await Assert.ThrowsAsync<IOException>(
+			async () => {
+				using var encoder = LZ4Stream.Encode(target, Settings(true, 2), true);
+				await encoder.WriteAsync(source, 0, source.Length);
+			});
+	}
+}
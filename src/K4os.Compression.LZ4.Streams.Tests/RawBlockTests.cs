@@ -0,0 +1,167 @@
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Frames;
+using K4os.Compression.LZ4.Streams.Tests.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class RawBlockTests
+{
+	private static LZ4EncoderSettings Settings(bool chaining, bool contentChecksum = false) =>
+		FrameTools.Settings(chaining, contentChecksum: contentChecksum);
+
+	private static byte[] Source(int length, int seed)
+	{
+		var source = Lorem.Create(length);
+		// one incompressible block, so stored blocks are forwarded as well
+		new Random(seed).NextBytes(source.AsSpan(Mem.K64, Mem.K64));
+		return source;
+	}
+
+	[Theory]
+	[InlineData(false, false)]
+	[InlineData(false, true)]
+	[InlineData(true, false)]
+	public void BlocksAreReadAsTheyAreStored(bool chaining, bool contentChecksum)
+	{
+		var source = Source(Mem.K256 + 1337, 0);
+		var encoded = FrameTools.Encode(source, Settings(chaining, contentChecksum));
+
+		using var reader = new LZ4RawFrameReader(new MemoryStream(encoded));
+		var blocks = new List<(bool Compressed, int Length)>();
+		while (reader.ReadBlock() is { } block)
+		{
+			Assert.Equal(0, block.Frame);
+			Assert.Equal(chaining, block.Descriptor.Chaining);
+			Assert.Equal(XXH32Of(block.Data.Span), block.Checksum);
+			blocks.Add((block.Compressed, block.Data.Length));
+		}
+
+		Assert.Equal(5, blocks.Count);
+		Assert.False(blocks[1].Compressed);
+		Assert.Equal(Mem.K64, blocks[1].Length);
+		Assert.Equal(encoded.Length, reader.GetBytesRead());
+	}
+
+	[Theory]
+	[InlineData(false)]
+	[InlineData(true)]
+	public void FramesCanBeSplicedWithoutRecompression(bool chaining)
+	{
+		var first = Source(Mem.K256, 1);
+		var second = Source(Mem.K256, 2);
+		var encoded = FrameTools.Encode(first, Settings(false))
+			.Concat(FrameTools.Encode(second, Settings(false)))
+			.ToArray();
+
+		// independent blocks can be forwarded into any frame, even chained one
+		var spliced = new MemoryStream();
+		using (var writer = LZ4Frame.Encode(spliced, Settings(chaining), true))
+		using (var reader = new LZ4RawFrameReader(new MemoryStream(encoded)))
+		{
+			while (reader.ReadBlock() is { } block)
+				writer.WriteRawBlock(block.Data.Span, block.Compressed);
+		}
+
+		Assert.Equal(first.Concat(second).ToArray(), FrameTools.Decode(spliced.ToArray()));
+	}
+
+	[Fact]
+	public async Task ChainedFrameCanBeForwardedAsynchronously()
+	{
+		var source = Source(Mem.K256 * 2, 3);
+		var encoded = FrameTools.Encode(source, Settings(true));
+
+		var forwarded = new MemoryStream();
+		using (var writer = LZ4Frame.Encode(forwarded, Settings(true), true))
+		using (var reader = new LZ4RawFrameReader(new MemoryStream(encoded)))
+		{
+			while (await reader.ReadBlockAsync() is { } block)
+				await writer.WriteRawBlockAsync(default, block.Data, block.Compressed);
+		}
+
+		Assert.Equal(encoded, forwarded.ToArray());
+		Assert.Equal(source, FrameTools.Decode(forwarded.ToArray()));
+	}
+
+	[Fact]
+	public void RegularWritesAreFlushedBeforeRawBlock()
+	{
+		var prefix = Lorem.Create(1000);
+		var source = Source(Mem.K256, 4);
+		var encoded = FrameTools.Encode(source, Settings(false));
+
+		var combined = new MemoryStream();
+		using (var writer = LZ4Frame.Encode(combined, Settings(false), true))
+		using (var reader = new LZ4RawFrameReader(new MemoryStream(encoded)))
+		{
+			writer.WriteManyBytes(prefix);
+			while (reader.ReadBlock() is { } block)
+			{
+				writer.WriteRawBlock(block.Data.Span, block.Compressed);
+				Assert.True(writer.GetBytesWritten() > prefix.Length);
+			}
+
+			writer.WriteManyBytes(prefix);
+			Assert.Equal(2 * prefix.Length + source.Length, writer.GetBytesWritten());
+		}
+
+		Assert.Equal(
+			prefix.Concat(source).Concat(prefix).ToArray(),
+			FrameTools.Decode(combined.ToArray()));
+	}
+
+	[Fact]
+	public void RawBlocksCannotBeMixedWithWritesInChainedFrame()
+	{
+		using var writer = LZ4Frame.Encode(new MemoryStream(), Settings(true));
+		writer.WriteManyBytes(Lorem.Create(1000));
+		var block = Block(Lorem.Create(1000));
+		Assert.Throws<InvalidOperationException>(() => writer.WriteRawBlock(block));
+	}
+
+	[Fact]
+	public void RawBlocksCannotBeWrittenWithContentChecksum()
+	{
+		using var writer = LZ4Frame.Encode(new MemoryStream(), Settings(false, true));
+		var block = Block(Lorem.Create(1000));
+		Assert.Throws<InvalidOperationException>(() => writer.WriteRawBlock(block));
+	}
+
+	[Fact]
+	public void InvalidRawBlockIsRejected()
+	{
+		using var writer = LZ4Frame.Encode(new MemoryStream(), Settings(false));
+		Assert.Throws<ArgumentException>(
+			() => writer.WriteRawBlock(new byte[] { 0x10, 0x61, 0x05, 0x00, 0x00 }));
+		Assert.Throws<ArgumentException>(
+			() => writer.WriteRawBlock(new byte[Mem.K64 + 1], false));
+	}
+
+	[Theory]
+	[InlineData(4, 0x80, "version")] // FLG
+	[InlineData(5, 0x70, "block size")] // BD
+	[InlineData(6, 0x01, "header checksum")] // HC
+	public void CorruptedHeaderIsRejectedLikeVerifierDoes(int index, int mask, string error)
+	{
+		var encoded = FrameTools.Encode(Lorem.Create(Mem.K4), Settings(false));
+		encoded[index] ^= (byte)mask;
+
+		using var reader = new LZ4RawFrameReader(new MemoryStream(encoded));
+		var exception = Assert.Throws<InvalidDataException>(() => reader.ReadBlock());
+		var result = LZ4Frame.Verify(new MemoryStream(encoded));
+
+		Assert.Contains(error, exception.Message);
+		Assert.Contains(result.Error!, exception.Message);
+	}
+
+	private static byte[] Block(byte[] source)
+	{
+		var target = new byte[LZ4Codec.MaximumOutputSize(source.Length)];
+		return target.AsSpan(0, LZ4Codec.Encode(source, target)).ToArray();
+	}
+
+	private static uint XXH32Of(ReadOnlySpan<byte> data) =>
+		K4os.Hash.xxHash.XXH32.DigestOf(data);
+}
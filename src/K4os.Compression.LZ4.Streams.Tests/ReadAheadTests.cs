@@ -0,0 +1,156 @@
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Tests.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class ReadAheadTests
+{
+	private static byte[] Encode(byte[] source, bool chaining, bool checksums) =>
+		FrameTools.Encode(source, FrameTools.Settings(chaining, checksums, checksums));
+
+	private static async Task<byte[]> DecodeAsync(Stream decoder, int chunk)
+	{
+		var decoded = new MemoryStream();
+		var buffer = new byte[chunk];
+		while (true)
+		{
+			var read = await decoder.ReadAsync(buffer, 0, buffer.Length);
+			if (read == 0) break;
+
+			decoded.Write(buffer, 0, read);
+		}
+
+		return decoded.ToArray();
+	}
+
+	[Theory]
+	[InlineData(true, true, 0)]
+	[InlineData(true, true, 1)]
+	[InlineData(false, false, 2)]
+	[InlineData(true, false, 4)]
+	[InlineData(false, true, 16)]
+	public async Task ReadAheadDecodesSameData(bool chaining, bool checksums, int readAhead)
+	{
+		var source = Lorem.Create(11 * Mem.K64 + 1337);
+		var inner = new SlowStream(Encode(source, chaining, checksums));
+		var settings = new LZ4DecoderSettings { ReadAhead = readAhead };
+
+		using var decoder = LZ4Stream.Decode(inner, settings);
+		var decoded = await DecodeAsync(decoder, 3333);
+
+		Tools.SameBytes(source, decoded);
+		Assert.Equal(1, inner.MaxInFlight);
+	}
+
+	[Fact]
+	public async Task ReadAheadDoesNotGoPastEndOfFrame()
+	{
+		var source = Lorem.Create(5 * Mem.K64 + 1337);
+		var encoded = Encode(source, true, true);
+		var inner = new SlowStream(encoded.Concat(encoded).ToArray());
+		var settings = new LZ4DecoderSettings { ReadAhead = 8 };
+
+		using var decoder = LZ4Stream.Decode(inner, settings, true);
+		var decoded = await DecodeAsync(decoder, Mem.K64);
+
+		// decoder reads concatenated frames, but should stop exactly at frame boundaries
+		Tools.SameBytes(source.Concat(source).ToArray(), decoded);
+		Assert.Equal(inner.Length, inner.Position);
+	}
+
+	[Fact]
+	public async Task BlockingReadIsRefusedWhileReadingAhead()
+	{
+		var source = Lorem.Create(9 * Mem.K64);
+		var inner = new SlowStream(Encode(source, true, true)) { Delay = 20 };
+		var settings = new LZ4DecoderSettings { ReadAhead = 3 };
+
+		using var decoder = LZ4Stream.Decode(inner, settings);
+		var decoded = new byte[source.Length];
+		var offset = await decoder.ReadAsync(decoded, 0, 1000);
+
+		// nothing is consumed by refused read
+		Assert.Throws<InvalidOperationException>(
+			() => decoder.Read(decoded, offset, decoded.Length - offset));
+
+		decoded = decoded.Take(offset).Concat(await DecodeAsync(decoder, 3333)).ToArray();
+		Tools.SameBytes(source, decoded);
+	}
+
+	[Fact]
+	public async Task CancelledReadDoesNotBreakReadAhead()
+	{
+		var source = Lorem.Create(9 * Mem.K64);
+		var inner = new SlowStream(Encode(source, true, true)) { Delay = 20 };
+		var settings = new LZ4DecoderSettings { ReadAhead = 3 };
+
+		using var decoder = LZ4Stream.Decode(inner, settings);
+		var decoded = new byte[source.Length];
+		var offset = await decoder.ReadAsync(decoded, 0, Mem.K64);
+		Assert.Equal(Mem.K64, offset);
+
+		// next block is still being read ahead when this call times out
+		using (var timeout = new CancellationTokenSource(5))
+			await Assert.ThrowsAnyAsync<OperationCanceledException>(
+				() => decoder.ReadAsync(decoded, offset, Mem.K64, timeout.Token));
+
+		decoded = decoded.Take(offset).Concat(await DecodeAsync(decoder, 3333)).ToArray();
+		Tools.SameBytes(source, decoded);
+	}
+
+	[Fact]
+	public async Task DisposingWhileReadingAheadDoesNotBlock()
+	{
+		var source = Lorem.Create(9 * Mem.K64);
+		var inner = new SlowStream(Encode(source, false, true));
+		var settings = new LZ4DecoderSettings { ReadAhead = 4 };
+
+		var decoder = LZ4Stream.Decode(inner, settings, true);
+		var buffer = new byte[1000];
+		var read = await decoder.ReadAsync(buffer, 0, buffer.Length);
+
+		// read-ahead cannot be stopped and takes long, but dispose does not wait for it
+		inner.IgnoreCancellation = true;
+		inner.Delay = 500;
+		var started = DateTime.UtcNow;
+		decoder.Dispose();
+		Assert.True(DateTime.UtcNow - started < TimeSpan.FromMilliseconds(250));
+
+		// once it finishes inner stream is not touched anymore
+		for (var i = 0; i < 100 && inner.InFlight > 0; i++) await Task.Delay(50);
+		Assert.Equal(0, inner.InFlight);
+		var position = inner.Position;
+		await Task.Delay(50);
+		Assert.Equal(position, inner.Position);
+
+		Assert.Equal(buffer.Length, read);
+		Tools.SameBytes(source.AsSpan(0, read).ToArray(), buffer);
+	}
+
+#if NET5_0_OR_GREATER
+	[Fact]
+	public async Task DisposingAsyncWhileReadingAheadWaitsForIt()
+	{
+		var source = Lorem.Create(9 * Mem.K64);
+		var inner = new SlowStream(Encode(source, false, true));
+		var settings = new LZ4DecoderSettings { ReadAhead = 4 };
+
+		var decoder = LZ4Stream.Decode(inner, settings, true);
+		var buffer = new byte[1000];
+		var read = await decoder.ReadAsync(buffer, 0, buffer.Length);
+		inner.IgnoreCancellation = true;
+		await decoder.DisposeAsync();
+
+		// read-ahead is finished before dispose returns, inner stream is not touched anymore
+		Assert.Equal(0, inner.InFlight);
+		var position = inner.Position;
+		await Task.Delay(50);
+		Assert.Equal(position, inner.Position);
+
+		Assert.Equal(buffer.Length, read);
+		Tools.SameBytes(source.AsSpan(0, read).ToArray(), buffer);
+	}
+#endif
+}
@@ -0,0 +1,70 @@
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Abstractions;
+using K4os.Compression.LZ4.Streams.Adapters;
+using K4os.Compression.LZ4.Streams.Frames;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class ValueAdapterTests
+{
+	private static readonly LZ4Descriptor DefaultSettings =
+		new(null, true, true, true, null, Mem.K64);
+
+	// adapter which does not implement ValueTask based interfaces
+	public readonly struct TaskOnlyAdapter: IStreamReader<EmptyState>, IStreamWriter<EmptyState>
+	{
+		private readonly StreamAdapter _adapter;
+
+		public TaskOnlyAdapter(Stream stream) => _adapter = new StreamAdapter(stream);
+
+		public int Read(ref EmptyState state, byte[] buffer, int offset, int length) =>
+			throw new InvalidOperationException("Synchronous read is not expected");
+
+		public Task<ReadResult<EmptyState>> ReadAsync(
+			EmptyState state, byte[] buffer, int offset, int length, CancellationToken token) =>
+			_adapter.ReadAsync(state, buffer, offset, length, token);
+
+		public bool CanFlush => true;
+
+		public void Write(ref EmptyState state, byte[] buffer, int offset, int length) =>
+			throw new InvalidOperationException("Synchronous write is not expected");
+
+		public Task<EmptyState> WriteAsync(
+			EmptyState state, byte[] buffer, int offset, int length, CancellationToken token) =>
+			_adapter.WriteAsync(state, buffer, offset, length, token);
+
+		public void Flush(ref EmptyState state) =>
+			throw new InvalidOperationException("Synchronous flush is not expected");
+
+		public Task<EmptyState> FlushAsync(EmptyState state, CancellationToken token) =>
+			_adapter.FlushAsync(state, token);
+	}
+
+	[Theory]
+	[InlineData(0)]
+	[InlineData(1337)]
+	[InlineData(5 * Mem.K64 + 1337)]
+	public async Task TaskOnlyAdapterStillWorks(int length)
+	{
+		var source = Lorem.Create(length);
+		var encoded = new MemoryStream();
+
+		using (var writer = new LZ4FrameWriter<TaskOnlyAdapter, EmptyState>(
+			new TaskOnlyAdapter(encoded), default, d => d.CreateEncoder(), DefaultSettings))
+		{
+			await writer.WriteManyBytesAsync(default, source);
+			await writer.CloseFrameAsync(default);
+		}
+
+		encoded.Position = 0;
+		var decoded = new byte[length + 1];
+		using var reader = new LZ4FrameReader<TaskOnlyAdapter, EmptyState>(
+			new TaskOnlyAdapter(encoded), default, d => d.CreateDecoder());
+		var read = await reader.ReadManyBytesAsync(default, decoded);
+
+		Assert.Equal(length, read);
+		Tools.SameBytes(source, decoded.AsSpan(0, read).ToArray());
+	}
+}
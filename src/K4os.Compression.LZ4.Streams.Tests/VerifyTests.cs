@@ -0,0 +1,129 @@
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+using Xunit;
+
+namespace K4os.Compression.LZ4.Streams.Tests;
+
+public class VerifyTests
+{
+	private const int FrameHeaderLength = 7; // magic, FLG, BD, HC
+	private const int BlockHeaderLength = 4;
+
+	private static byte[] Encode(byte[] source, bool chaining, bool checksums = true)
+	{
+		var encoded = new MemoryStream();
+		var settings = new LZ4EncoderSettings {
+			ChainBlocks = chaining,
+			BlockSize = Mem.K64,
+			BlockChecksum = checksums,
+			ContentChecksum = checksums,
+		};
+		using (var encoder = LZ4Stream.Encode(encoded, settings, true))
+			encoder.Write(source, 0, source.Length);
+		return encoded.ToArray();
+	}
+
+	private static byte[] Source(int length)
+	{
+		var source = Lorem.Create(length);
+		// some incompressible blocks, so stored blocks are verified as well
+		new Random(0).NextBytes(source.AsSpan(Mem.K64, Mem.K64));
+		return source;
+	}
+
+	[Theory]
+	[InlineData(true, 1)]
+	[InlineData(true, 4)]
+	[InlineData(false, 1)]
+	[InlineData(false, 4)]
+	public void ValidFrameIsVerified(bool chaining, int parallelism)
+	{
+		var source = Source(Mem.K256 * 3 + 1337);
+		var encoded = Encode(source, chaining);
+
+		var result = LZ4Frame.Verify(new MemoryStream(encoded), parallelism);
+
+		Assert.True(result.Valid, result.ToString());
+		Assert.Null(result.ErrorOffset);
+		Assert.Equal(1, result.Frames);
+		Assert.Equal(13, result.Blocks);
+		Assert.Equal(encoded.Length, result.BytesRead);
+		Assert.Equal(source.Length, result.BytesDecoded);
+	}
+
+	[Fact]
+	public void ConcatenatedFramesAreVerified()
+	{
+		var first = Encode(Source(Mem.K256), true);
+		var second = Encode(Source(Mem.K256), false, false);
+		var encoded = first.Concat(second).ToArray();
+
+		var result = LZ4Frame.Verify(new MemoryStream(encoded));
+
+		Assert.True(result.Valid, result.ToString());
+		Assert.Equal(2, result.Frames);
+		Assert.Equal(2 * Mem.K256, result.BytesDecoded);
+	}
+
+	[Theory]
+	[InlineData(true, true)]
+	[InlineData(false, true)]
+	[InlineData(true, false)]
+	[InlineData(false, false)]
+	public void FirstCorruptedBlockIsReported(bool chaining, bool checksums)
+	{
+		var encoded = Encode(Source(Mem.K256 * 2), chaining, checksums);
+
+		// finds third block (skipping first two) and damages its tokens
+		var offset = (long)FrameHeaderLength;
+		for (var i = 0; i < 2; i++)
+			offset += BlockHeaderLength + BlockLength(encoded, offset) + (checksums ? 4 : 0);
+		for (var i = 0; i < 16; i++)
+			encoded[offset + BlockHeaderLength + i] = 0xFF;
+
+		var result = LZ4Frame.Verify(new MemoryStream(encoded), 4);
+
+		Assert.False(result.Valid);
+		Assert.Equal(offset, result.ErrorOffset);
+		Assert.NotNull(result.Error);
+	}
+
+	[Fact]
+	public void InvalidContentChecksumIsReported()
+	{
+		var encoded = Encode(Source(Mem.K256), true);
+		encoded[^1] ^= 0x01;
+
+		var result = LZ4Frame.Verify(new MemoryStream(encoded));
+
+		Assert.False(result.Valid);
+		Assert.Equal(encoded.Length - 4, result.ErrorOffset);
+		Assert.Contains("content checksum", result.Error);
+	}
+
+	[Fact]
+	public void InvalidHeaderChecksumIsReported()
+	{
+		var encoded = Encode(Source(Mem.K256), true);
+		encoded[FrameHeaderLength - 1] ^= 0x01;
+
+		var result = LZ4Frame.Verify(new MemoryStream(encoded));
+
+		Assert.False(result.Valid);
+		Assert.Equal(0, result.ErrorOffset);
+	}
+
+	[Fact]
+	public void TruncatedStreamIsReported()
+	{
+		var encoded = Encode(Source(Mem.K256), true);
+
+		var result = LZ4Frame.Verify(new MemoryStream(encoded, 0, encoded.Length - 100));
+
+		Assert.False(result.Valid);
+		Assert.Contains("end of stream", result.Error);
+	}
+
+	private static int BlockLength(byte[] encoded, long offset) =>
+		BitConverter.ToInt32(encoded, (int)offset) & 0x7FFFFFFF;
+}
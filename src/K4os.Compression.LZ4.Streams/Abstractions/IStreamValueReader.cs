@@ -0,0 +1,25 @@
+namespace K4os.Compression.LZ4.Streams.Abstractions;
+
+/// <summary>
+/// Stream reader interface with <see cref="ValueTask{TResult}"/> based asynchronous read.
+/// Implementing it is optional, but it allows asynchronous frame readers to avoid
+/// allocating <see cref="Task{TResult}"/> for every read which completes synchronously.
+/// </summary>
+/// <typeparam name="TStreamState">Stream state.</typeparam>
+public interface IStreamValueReader<TStreamState>: IStreamReader<TStreamState>
+{
+    /// <summary>
+    /// Reads at-most <paramref name="length"/> bytes from given <paramref name="state"/>. 
+    /// </summary>
+    /// <param name="state">Stream state.</param>
+    /// <param name="buffer">Buffer to read bytes into.</param>
+    /// <param name="offset">Offset in buffer.</param>
+    /// <param name="length">Maximum number of bytes to read.</param>
+    /// <param name="token">Cancellation token.</param>
+    /// <returns><see cref="ReadResult{TStreamState}"/> containing new stream state,
+    /// and number of bytes actually read..</returns>
+    ValueTask<ReadResult<TStreamState>> ReadValueAsync(
+        TStreamState state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token);
+}
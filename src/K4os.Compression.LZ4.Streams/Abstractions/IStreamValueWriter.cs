@@ -0,0 +1,30 @@
+namespace K4os.Compression.LZ4.Streams.Abstractions;
+
+/// <summary>
+/// Stream writer interface with <see cref="ValueTask{TResult}"/> based asynchronous
+/// operations. Implementing it is optional, but it allows asynchronous frame writers
+/// to avoid allocating <see cref="Task{TResult}"/> for every write which completes
+/// synchronously.
+/// </summary>
+/// <typeparam name="TStreamState">Mutable part of stream state.</typeparam>
+public interface IStreamValueWriter<TStreamState>: IStreamWriter<TStreamState>
+{
+    /// <summary>Writes byte buffer to underlying stream.</summary>
+    /// <param name="state">Stream state.</param>
+    /// <param name="buffer">Byte buffer.</param>
+    /// <param name="offset">Offset within buffer.</param>
+    /// <param name="length">Number of bytes.</param>
+    /// <param name="token">Cancellation token.</param>
+    /// <returns>New stream state (mutable part).</returns>
+    ValueTask<TStreamState> WriteValueAsync(
+        TStreamState state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token);
+
+    /// <summary>Flushes buffers to underlying storage. Called only when
+    /// <see cref="IStreamWriter{TStreamState}.CanFlush"/></summary>
+    /// <param name="state">Stream state.</param>
+    /// <param name="token">Cancellation token.</param>
+    /// <returns>New stream state (mutable part).</returns>
+    ValueTask<TStreamState> FlushValueAsync(TStreamState state, CancellationToken token);
+}
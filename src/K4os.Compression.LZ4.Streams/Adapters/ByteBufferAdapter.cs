@@ -12,7 +12,7 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// pubternal - exposed as public but still very likely to change.
 /// </summary>
 /// <typeparam name="TBufferWriter">Type implementing <see cref="IBufferWriter{T}"/></typeparam>
-public readonly struct ByteBufferAdapter<TBufferWriter>: IStreamWriter<TBufferWriter>
+public readonly struct ByteBufferAdapter<TBufferWriter>: IStreamValueWriter<TBufferWriter>
     where TBufferWriter: IBufferWriter<byte>
 {
     /// <inheritdoc />
@@ -38,6 +38,16 @@ public readonly struct ByteBufferAdapter<TBufferWriter>: IStreamWriter<TBufferWr
         return Task.FromResult(state);
     }
 
+    /// <inheritdoc />
+    public ValueTask<TBufferWriter> WriteValueAsync(
+        TBufferWriter state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token)
+    {
+        Write(ref state, buffer, offset, length);
+        return new ValueTask<TBufferWriter>(state);
+    }
+
     /// <inheritdoc />
     public bool CanFlush
     {
@@ -51,4 +61,9 @@ public readonly struct ByteBufferAdapter<TBufferWriter>: IStreamWriter<TBufferWr
     /// <inheritdoc />
     public Task<TBufferWriter> FlushAsync(TBufferWriter state, CancellationToken token) =>
         Task.FromResult(state);
+
+    /// <inheritdoc />
+    public ValueTask<TBufferWriter> FlushValueAsync(
+        TBufferWriter state, CancellationToken token) =>
+        new(state);
 }
@@ -12,7 +12,7 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// Please note, whole <c>K4os.Compression.LZ4.Streams.Adapters</c> namespace should be considered
 /// pubternal - exposed as public but still very likely to change.
 /// </summary>
-public readonly struct ByteMemoryReadAdapter: IStreamReader<int>
+public readonly struct ByteMemoryReadAdapter: IStreamValueReader<int>
 {
     private readonly ReadOnlyMemory<byte> _memory;
 
@@ -69,4 +69,15 @@ public readonly struct ByteMemoryReadAdapter: IStreamReader<int>
         var bytes = Read(ref state, buffer, offset, length);
         return Task.FromResult(ReadResult.Create(state, bytes));
     }
+
+    /// <inheritdoc />
+    public ValueTask<ReadResult<int>> ReadValueAsync(
+        int state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token)
+    {
+        token.ThrowIfCancellationRequested();
+        var bytes = Read(ref state, buffer, offset, length);
+        return new ValueTask<ReadResult<int>>(ReadResult.Create(state, bytes));
+    }
 }
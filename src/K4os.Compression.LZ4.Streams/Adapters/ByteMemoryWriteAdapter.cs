@@ -12,7 +12,7 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// Please note, whole <c>K4os.Compression.LZ4.Streams.Adapters</c> namespace should be considered
 /// pubternal - exposed as public but still very likely to change.
 /// </summary>
-public readonly struct ByteMemoryWriteAdapter: IStreamWriter<int>
+public readonly struct ByteMemoryWriteAdapter: IStreamValueWriter<int>
 {
     private readonly Memory<byte> _memory;
 
@@ -59,6 +59,17 @@ public readonly struct ByteMemoryWriteAdapter: IStreamWriter<int>
         return Task.FromResult(state);
     }
 
+    /// <inheritdoc />
+    public ValueTask<int> WriteValueAsync(
+        int state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token)
+    {
+        token.ThrowIfCancellationRequested();
+        Write(ref state, buffer, offset, length);
+        return new ValueTask<int>(state);
+    }
+
     /// <inheritdoc />
     public bool CanFlush
     {
@@ -72,4 +83,8 @@ public readonly struct ByteMemoryWriteAdapter: IStreamWriter<int>
     /// <inheritdoc />
     public Task<int> FlushAsync(int state, CancellationToken token) =>
         Task.FromResult(state);
+
+    /// <inheritdoc />
+    public ValueTask<int> FlushValueAsync(int state, CancellationToken token) =>
+        new(state);
 }
@@ -9,7 +9,7 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// Please note, whole <c>K4os.Compression.LZ4.Streams.Adapters</c> namespace should be considered
 /// pubternal - exposed as public but still very likely to change.
 /// </summary>
-public struct ByteSequenceAdapter: IStreamReader<ReadOnlySequence<byte>>
+public struct ByteSequenceAdapter: IStreamValueReader<ReadOnlySequence<byte>>
 {
     /// <inheritdoc />
     public int Read(
@@ -35,4 +35,15 @@ public struct ByteSequenceAdapter: IStreamReader<ReadOnlySequence<byte>>
         var bytes = Read(ref state, buffer, offset, length);
         return Task.FromResult(ReadResult.Create(state, bytes));
     }
+
+    /// <inheritdoc />
+    public ValueTask<ReadResult<ReadOnlySequence<byte>>> ReadValueAsync(
+        ReadOnlySequence<byte> state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token)
+    {
+        token.ThrowIfCancellationRequested();
+        var bytes = Read(ref state, buffer, offset, length);
+        return new ValueTask<ReadResult<ReadOnlySequence<byte>>>(ReadResult.Create(state, bytes));
+    }
 }
@@ -6,7 +6,7 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// <summary>
 /// LZ4 stream reader/writer adapter for <see cref="UnsafeByteSpan"/>.
 /// </summary>
-public class ByteSpanAdapter: IStreamReader<int>, IStreamWriter<int>
+public class ByteSpanAdapter: IStreamValueReader<int>, IStreamValueWriter<int>
 {
     private readonly UnsafeByteSpan _span;
 
@@ -45,6 +45,17 @@ public class ByteSpanAdapter: IStreamReader<int>, IStreamWriter<int>
         return Task.FromResult(ReadResult.Create(state, loaded));
     }
 
+    /// <inheritdoc />
+    public ValueTask<ReadResult<int>> ReadValueAsync(
+        int state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token)
+    {
+        token.ThrowIfCancellationRequested();
+        var loaded = Read(ref state, buffer, offset, length);
+        return new ValueTask<ReadResult<int>>(ReadResult.Create(state, loaded));
+    }
+
     /// <inheritdoc />
     public void Write(
         ref int state,
@@ -71,6 +82,17 @@ public class ByteSpanAdapter: IStreamReader<int>, IStreamWriter<int>
         return Task.FromResult(state);
     }
 
+    /// <inheritdoc />
+    public ValueTask<int> WriteValueAsync(
+        int state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token)
+    {
+        token.ThrowIfCancellationRequested();
+        Write(ref state, buffer, offset, length);
+        return new ValueTask<int>(state);
+    }
+
     /// <inheritdoc />
     public bool CanFlush
     {
@@ -84,4 +106,8 @@ public class ByteSpanAdapter: IStreamReader<int>, IStreamWriter<int>
     /// <inheritdoc />
     public Task<int> FlushAsync(int state, CancellationToken token) =>
         Task.FromResult(state);
+
+    /// <inheritdoc />
+    public ValueTask<int> FlushValueAsync(int state, CancellationToken token) =>
+        new(state);
 }
@@ -13,7 +13,7 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// Please note, whole <c>K4os.Compression.LZ4.Streams.Adapters</c> namespace should be considered
 /// pubternal - exposed as public but still very likely to change.
 /// </summary>
-public readonly struct PipeReaderAdapter: IStreamReader<EmptyState>
+public readonly struct PipeReaderAdapter: IStreamValueReader<EmptyState>
 {
     private readonly PipeReader _reader;
 
@@ -37,35 +37,60 @@ public readonly struct PipeReaderAdapter: IStreamReader<EmptyState>
     {
         CheckSyncOverAsync();
 
-        (state, var result) = ReadAsync(state, buffer, offset, length, CancellationToken.None)
-            .GetAwaiter().GetResult();
+        var pending = ReadValueAsync(state, buffer, offset, length, CancellationToken.None);
+        (state, var result) = pending.IsCompleted
+            ? pending.Result
+            : pending.AsTask().GetAwaiter().GetResult();
         return result;
     }
 
     /// <inheritdoc />
-    public async Task<ReadResult<EmptyState>> ReadAsync(
+    public Task<ReadResult<EmptyState>> ReadAsync(
+        EmptyState state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token) =>
+        ReadValueAsync(state, buffer, offset, length, token).AsTask();
+
+    /// <inheritdoc />
+    public ValueTask<ReadResult<EmptyState>> ReadValueAsync(
         EmptyState state,
         byte[] buffer, int offset, int length,
         CancellationToken token)
     {
         if (length <= 0)
-            return ReadResult.Create(state);
+            return new ValueTask<ReadResult<EmptyState>>(ReadResult.Create(state));
+
+        var pending = ReadFromPipe(_reader, length, token);
+        return pending.IsCompletedSuccessfully
+            ? new ValueTask<ReadResult<EmptyState>>(
+                ReadFromSequence(_reader, pending.Result, buffer.AsSpan(offset, length)))
+            : ReadValueAsync(_reader, pending, buffer, offset, length);
+    }
 
-        var sequence = await ReadFromPipe(_reader, length, token).Weave();
-        return ReadFromSequence(_reader, sequence, buffer.AsSpan(offset, length));
+    private static async ValueTask<ReadResult<EmptyState>> ReadValueAsync(
+        PipeReader reader, ValueTask<System.IO.Pipelines.ReadResult> pending,
+        byte[] buffer, int offset, int length)
+    {
+        var result = await pending.Weave();
+        return ReadFromSequence(reader, result, buffer.AsSpan(offset, length));
     }
 
-    private static async Task<ReadOnlySequence<byte>> ReadFromPipe(
+    private static ValueTask<System.IO.Pipelines.ReadResult> ReadFromPipe(
         PipeReader reader, int length, CancellationToken token)
     {
 #if NETSTANDARD2_1_OR_GREATER || NETCOREAPP3_1_OR_GREATER
-		var result = await reader.ReadAtLeastAsync(length, token).Weave();
+		return reader.ReadAtLeastAsync(length, token);
 #else
         _ = length; // ignore
-        var result = await reader.ReadAsync(token).Weave();
+        return reader.ReadAsync(token);
 #endif
+    }
+
+    private static ReadResult<EmptyState> ReadFromSequence(
+        PipeReader reader, System.IO.Pipelines.ReadResult result, Span<byte> buffer)
+    {
         if (result.IsCanceled) ThrowPendingReadsCancelled();
-        return result.Buffer;
+        return ReadFromSequence(reader, result.Buffer, buffer);
     }
 
     private static ReadResult<EmptyState> ReadFromSequence(
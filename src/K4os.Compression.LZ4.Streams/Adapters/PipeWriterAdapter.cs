@@ -9,7 +9,7 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// Please note, whole <c>K4os.Compression.LZ4.Streams.Adapters</c> namespace should be considered
 /// pubternal - exposed as public but still very likely to change.
 /// </summary>
-public readonly struct PipeWriterAdapter: IStreamWriter<EmptyState>
+public readonly struct PipeWriterAdapter: IStreamValueWriter<EmptyState>
 {
     private readonly PipeWriter _writer;
 
@@ -26,17 +26,18 @@ public readonly struct PipeWriterAdapter: IStreamWriter<EmptyState>
     public void Write(ref EmptyState state, byte[] buffer, int offset, int length)
     {
         CheckSyncOverAsync();
-        state = WriteAsync(state, buffer, offset, length, CancellationToken.None)
-            .GetAwaiter().GetResult();
+        state = Wait(WriteValueAsync(state, buffer, offset, length, CancellationToken.None));
     }
 
     /// <inheritdoc />
-    public async Task<EmptyState> WriteAsync(
-        EmptyState state, byte[] buffer, int offset, int length, CancellationToken token)
-    {
-        await _writer.WriteAsync(buffer.AsMemory(offset, length), token).Weave();
-        return state;
-    }
+    public Task<EmptyState> WriteAsync(
+        EmptyState state, byte[] buffer, int offset, int length, CancellationToken token) =>
+        WriteValueAsync(state, buffer, offset, length, token).AsTask();
+
+    /// <inheritdoc />
+    public ValueTask<EmptyState> WriteValueAsync(
+        EmptyState state, byte[] buffer, int offset, int length, CancellationToken token) =>
+        Complete(state, _writer.WriteAsync(buffer.AsMemory(offset, length), token));
 
     /// <inheritdoc />
 #if NETSTANDARD2_1_OR_GREATER || NETCOREAPP3_1_OR_GREATER
@@ -49,17 +50,37 @@ public readonly struct PipeWriterAdapter: IStreamWriter<EmptyState>
     public void Flush(ref EmptyState state)
     {
         CheckSyncOverAsync();
-        state = FlushAsync(state, CancellationToken.None)
-            .GetAwaiter().GetResult();
+        state = Wait(FlushValueAsync(state, CancellationToken.None));
     }
 
     /// <inheritdoc />
-    public async Task<EmptyState> FlushAsync(EmptyState state, CancellationToken token)
+    public Task<EmptyState> FlushAsync(EmptyState state, CancellationToken token) =>
+        FlushValueAsync(state, token).AsTask();
+
+    /// <inheritdoc />
+    public ValueTask<EmptyState> FlushValueAsync(EmptyState state, CancellationToken token) =>
+        Complete(state, _writer.FlushAsync(token));
+
+    private static ValueTask<EmptyState> Complete(
+        EmptyState state, ValueTask<FlushResult> pending)
+    {
+        if (!pending.IsCompletedSuccessfully)
+            return CompleteAsync(state, pending);
+
+        _ = pending.Result; // consume result, as required by ValueTask contract
+        return new ValueTask<EmptyState>(state);
+    }
+
+    private static async ValueTask<EmptyState> CompleteAsync(
+        EmptyState state, ValueTask<FlushResult> pending)
     {
-        await _writer.FlushAsync(token).Weave();
+        await pending.Weave();
         return state;
     }
 
+    private static EmptyState Wait(ValueTask<EmptyState> pending) =>
+        pending.IsCompleted ? pending.Result : pending.AsTask().GetAwaiter().GetResult();
+
     private static void CheckSyncOverAsync()
     {
         if (SynchronizationContext.Current != null)
@@ -10,8 +10,8 @@ namespace K4os.Compression.LZ4.Streams.Adapters;
 /// pubternal - exposed as public but still very likely to change.
 /// </summary>
 public readonly struct StreamAdapter:
-    IStreamReader<EmptyState>,
-    IStreamWriter<EmptyState>
+    IStreamValueReader<EmptyState>,
+    IStreamValueWriter<EmptyState>
 {
     private readonly Stream _stream;
 
@@ -31,21 +31,65 @@ public readonly struct StreamAdapter:
         _stream.Read(buffer, offset, length);
 
     /// <inheritdoc />
-    public async Task<ReadResult<EmptyState>> ReadAsync(
+    public Task<ReadResult<EmptyState>> ReadAsync(
         EmptyState state, byte[] buffer, int offset, int length, CancellationToken token) =>
-        ReadResult.Create(state, await _stream.ReadAsync(buffer, offset, length, token).Weave());
+        ReadValueAsync(state, buffer, offset, length, token).AsTask();
+
+    /// <inheritdoc />
+    public ValueTask<ReadResult<EmptyState>> ReadValueAsync(
+        EmptyState state, byte[] buffer, int offset, int length, CancellationToken token)
+    {
+#if NETSTANDARD2_1_OR_GREATER || NET5_0_OR_GREATER
+        var pending = _stream.ReadAsync(buffer.AsMemory(offset, length), token);
+        return pending.IsCompletedSuccessfully
+            ? new ValueTask<ReadResult<EmptyState>>(ReadResult.Create(state, pending.Result))
+            : ReadValueAsync(state, pending);
+#else
+        var pending = _stream.ReadAsync(buffer, offset, length, token);
+        return pending.Status == TaskStatus.RanToCompletion
+            ? new ValueTask<ReadResult<EmptyState>>(ReadResult.Create(state, pending.Result))
+            : ReadValueAsync(state, new ValueTask<int>(pending));
+#endif
+    }
+
+    private static async ValueTask<ReadResult<EmptyState>> ReadValueAsync(
+        EmptyState state, ValueTask<int> pending) =>
+        ReadResult.Create(state, await pending.Weave());
 
     /// <inheritdoc />
     public void Write(ref EmptyState state, byte[] buffer, int offset, int length) =>
         _stream.Write(buffer, offset, length);
 
     /// <inheritdoc />
-    public async Task<EmptyState> WriteAsync(
+    public Task<EmptyState> WriteAsync(
+        EmptyState state,
+        byte[] buffer, int offset, int length,
+        CancellationToken token) =>
+        WriteValueAsync(state, buffer, offset, length, token).AsTask();
+
+    /// <inheritdoc />
+    public ValueTask<EmptyState> WriteValueAsync(
         EmptyState state,
         byte[] buffer, int offset, int length,
         CancellationToken token)
     {
-        await _stream.WriteAsync(buffer, offset, length, token).Weave();
+#if NETSTANDARD2_1_OR_GREATER || NET5_0_OR_GREATER
+        var pending = _stream.WriteAsync(buffer.AsMemory(offset, length), token);
+        return pending.IsCompletedSuccessfully
+            ? new ValueTask<EmptyState>(state)
+            : WriteValueAsync(state, pending);
+#else
+        var pending = _stream.WriteAsync(buffer, offset, length, token);
+        return pending.Status == TaskStatus.RanToCompletion
+            ? new ValueTask<EmptyState>(state)
+            : WriteValueAsync(state, new ValueTask(pending));
+#endif
+    }
+
+    private static async ValueTask<EmptyState> WriteValueAsync(
+        EmptyState state, ValueTask pending)
+    {
+        await pending.Weave();
         return state;
     }
 
@@ -62,4 +106,8 @@ public readonly struct StreamAdapter:
     /// <inheritdoc />
     public Task<EmptyState> FlushAsync(EmptyState state, CancellationToken token) =>
         Task.FromResult(state);
+
+    /// <inheritdoc />
+    public ValueTask<EmptyState> FlushValueAsync(EmptyState state, CancellationToken token) =>
+        new(state);
 }
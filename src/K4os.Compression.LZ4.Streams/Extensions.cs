@@ -43,11 +43,54 @@ public static class Extensions
     /// <returns>Encoder.</returns>
     public static ILZ4Encoder CreateEncoder(
         this ILZ4Descriptor descriptor, LZ4EncoderSettings settings) =>
+        settings.AdaptiveLevel is { } adaptive
+            ? descriptor.CreateEncoder(adaptive, settings.CompressionLevel, settings.ExtraMemory)
+            : settings.CompressionParameters is { } parameters
+                ? descriptor.CreateEncoder(parameters, settings.ExtraMemory)
+                : descriptor.CreateEncoder(settings.CompressionLevel, settings.ExtraMemory);
+
+    /// <summary>
+    /// Creates <see cref="LZ4AdaptiveEncoder"/> (with its <see cref="LZ4LevelController"/>)
+    /// using <see cref="ILZ4Descriptor"/> and <see cref="LZ4AdaptiveParameters"/>.
+    /// </summary>
+    /// <param name="descriptor">LZ4 descriptor.</param>
+    /// <param name="parameters">Adaptive level parameters.</param>
+    /// <param name="level">Initial compression level.</param>
+    /// <param name="extraMemory">Additional memory for encoder.</param>
+    /// <returns>Encoder.</returns>
+    public static ILZ4Encoder CreateEncoder(
+        this ILZ4Descriptor descriptor,
+        LZ4AdaptiveParameters parameters,
+        LZ4Level level = LZ4Level.L00_FAST,
+        int extraMemory = 0)
+    {
+        var controller = new LZ4LevelController(parameters, level);
+        return new LZ4AdaptiveEncoder(
+            descriptor.Chaining,
+            controller.Level,
+            descriptor.BlockSize,
+            ExtraBlocks(descriptor.BlockSize, extraMemory)) {
+            Controller = controller,
+        };
+    }
+
+    /// <summary>
+    /// Creates <see cref="ILZ4Encoder"/> using <see cref="ILZ4Descriptor"/> and
+    /// <see cref="LZ4CompressionParameters"/>.
+    /// </summary>
+    /// <param name="descriptor">LZ4 descriptor.</param>
+    /// <param name="parameters">Compression parameters.</param>
+    /// <param name="extraMemory">Additional memory for encoder.</param>
+    /// <returns>Encoder.</returns>
+    public static ILZ4Encoder CreateEncoder(
+        this ILZ4Descriptor descriptor,
+        LZ4CompressionParameters parameters,
+        int extraMemory = 0) =>
         LZ4Encoder.Create(
             descriptor.Chaining,
-            settings.CompressionLevel,
+            parameters,
             descriptor.BlockSize,
-            ExtraBlocks(descriptor.BlockSize, settings.ExtraMemory));
+            ExtraBlocks(descriptor.BlockSize, extraMemory));
 
     /// <summary>
     /// Create <see cref="ILZ4Decoder"/> using <see cref="ILZ4Descriptor"/>.
@@ -13,31 +13,31 @@ namespace K4os.Compression.LZ4.Streams.Frames;
 
 public partial class LZ4FrameReader<TStreamReader, TStreamState>
 {
-    private async Task<ulong> Peek8(Token token)
+    private async ValueTask<ulong> Peek8(Token token)
     {
         var loaded = await ReadMeta(token, sizeof(ulong)).Weave();
         return _stash.Last8(loaded);
     }
 
-    private async Task<uint?> TryPeek4(Token token)
+    private async ValueTask<uint?> TryPeek4(Token token)
     {
         var loaded = await ReadMeta(token, sizeof(uint), true).Weave();
         return loaded <= 0 ? null : _stash.Last4(loaded);
     }
 
-    private async Task<uint> Peek4(Token token)
+    private async ValueTask<uint> Peek4(Token token)
     {
         var loaded = await ReadMeta(token, sizeof(uint)).Weave();
         return _stash.Last4(loaded);
     }
 
-    private async Task<ushort> Peek2(Token token)
+    private async ValueTask<ushort> Peek2(Token token)
     {
         var loaded = await ReadMeta(token, sizeof(ushort)).Weave();
         return _stash.Last2(loaded);
     }
 
-    private async Task<byte> Peek1(Token token)
+    private async ValueTask<byte> Peek1(Token token)
     {
         var loaded = await ReadMeta(token, sizeof(byte)).Weave();
         return _stash.Last1(loaded);
@@ -47,8 +47,10 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>
         _decoder != null || await ReadHeader(token).Weave();
 
     [SuppressMessage("ReSharper", "InconsistentNaming")]
-    private async Task<bool> ReadHeader(Token token)
+    private async ValueTask<bool> ReadHeader(Token token)
     {
+        await EnsureNotReadingAhead(token).Weave();
+
         _stash.Flush();
 
         var magic = await TryPeek4(token).Weave();
@@ -102,17 +104,22 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>
             contentLength, contentChecksum, blockChaining, blockChecksum, dictionaryId,
             blockSize);
         _decoder = CreateDecoder(_descriptor);
-        _buffer = AllocBuffer(blockSize);
+        _bufferSize = blockSize + sizeof(uint);
+        _buffer = AllocBuffer(_bufferSize);
 
         return true;
     }
 
-    private async Task<int> ReadBlock(Token token)
+    private async ValueTask<int> ReadBlock(Token token)
     {
         _stash.Flush();
 
         _descriptor.AssertIsNotNull();
 
+        var prefetched = await TryTakePrefetched(token).Weave();
+        if (prefetched.HasValue)
+            return DecodePrefetched(prefetched.Value);
+
         var blockLength = (int)await Peek4(token).Weave();
         if (blockLength == 0)
         {
@@ -150,6 +157,8 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>
     private async Task<int> ReadManyBytes(
         Token token, WritableBuffer buffer, bool interactive = false)
     {
+        await EnsureNotReadingAhead(token).Weave();
+
         var hasFrame = await EnsureHeader(token).Weave();
         if (!hasFrame) return 0;
 
@@ -56,6 +56,8 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>
     [SuppressMessage("ReSharper", "InconsistentNaming")]
     private /*async*/ bool ReadHeader(Token token)
     {
+        /*await*/ EnsureNotReadingAhead(token);
+
         _stash.Flush();
 
         var magic = /*await*/ TryPeek4(token);
@@ -109,7 +111,8 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>
             contentLength, contentChecksum, blockChaining, blockChecksum, dictionaryId,
             blockSize);
         _decoder = CreateDecoder(_descriptor);
-        _buffer = AllocBuffer(blockSize);
+        _bufferSize = blockSize + sizeof(uint);
+        _buffer = AllocBuffer(_bufferSize);
 
         return true;
     }
@@ -120,6 +123,10 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>
 
         _descriptor.AssertIsNotNull();
 
+        var prefetched = /*await*/ TryTakePrefetched(token);
+        if (prefetched.HasValue)
+            return DecodePrefetched(prefetched.Value);
+
         var blockLength = (int)/*await*/ Peek4(token);
         if (blockLength == 0)
         {
@@ -157,6 +164,8 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>
     private /*async*/ int ReadManyBytes(
         Token token, WritableBuffer buffer, bool interactive = false)
     {
+        /*await*/ EnsureNotReadingAhead(token);
+
         var hasFrame = /*await*/ EnsureHeader(token);
         if (!hasFrame) return 0;
 
@@ -15,6 +15,7 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
     where TStreamReader: IStreamReader<TStreamState>
 {
     private readonly TStreamReader _reader;
+    private IStreamValueReader<TStreamState>? _valueReader;
     private TStreamState _stream;
     private Stash _stash = new();
 
@@ -26,8 +27,15 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
     private XXH32.State _contentChecksum;
 
     private byte[]? _buffer;
+    private int _bufferSize;
     private int _decoded;
 
+    private Queue<(Task<PrefetchedBlock> Block, byte[] Buffer)>? _prefetched;
+    private Task<PrefetchedBlock>? _lastPrefetch;
+    private CancellationTokenSource? _prefetchCancel;
+    private Task? _abandonedPrefetch;
+    private Stack<byte[]>? _spareBuffers;
+
     private long _bytesRead;
 
     /// <summary>Creates new instance <see cref="LZ4DecoderStream"/>.</summary>
@@ -53,6 +61,38 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
     /// </summary>
     public TStreamState StreamState => _stream;
 
+    /// <summary>
+    /// Number of compressed blocks to be read ahead from inner stream while current block
+    /// is being consumed. It is applied to asynchronous operations only and helps with
+    /// high-latency sources (network, blob storage, slow disks). Read-ahead never goes
+    /// past the end of current frame. Every block read ahead holds its own buffer, so
+    /// memory usage grows accordingly. Read-ahead is not bound to cancellation token of
+    /// the call which started it (cancelling a call stops waiting only, block is kept for
+    /// next read), it is cancelled when frame is closed. Synchronous reads cannot be issued
+    /// while read-ahead is still in progress. Synchronous <see cref="Dispose()"/> (and
+    /// <see cref="CloseFrame"/>) does not wait for reads in progress, their buffers are
+    /// released when they finish, use <c>DisposeAsync</c> to wait for them.
+    /// Default is <c>0</c> (blocks are read on demand).
+    /// </summary>
+    public int ReadAhead { get; set; }
+
+    private readonly struct PrefetchedBlock
+    {
+        public readonly byte[] Buffer;
+        public readonly uint Length;
+        public readonly uint Checksum;
+
+        public PrefetchedBlock(byte[] buffer, uint length, uint checksum)
+        {
+            Buffer = buffer;
+            Length = length;
+            Checksum = checksum;
+        }
+    }
+
+    private IStreamValueReader<TStreamState> ValueReader =>
+        _valueReader ??= StreamValueAdapter.AsValueReader<TStreamReader, TStreamState>(_reader);
+
     private static int MaxBlockSize(int blockSizeCode) =>
         blockSizeCode switch {
             7 => Mem.M4, 6 => Mem.M1, 5 => Mem.K256, 4 => Mem.K64, _ => Mem.K64,
@@ -69,8 +109,8 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
 
         try
         {
-            if (_buffer is not null)
-                ReleaseBuffer(_buffer);
+            AbandonPrefetched();
+            ReleaseBuffers();
             _decoder.Dispose();
         }
         finally
@@ -90,10 +130,29 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
     /// <param name="buffer">Previously allocated buffer.</param>
     protected virtual void ReleaseBuffer(byte[] buffer) => BufferPool.Free(buffer);
 
-    private int InjectOrDecode(int blockLength, bool uncompressed) =>
-        uncompressed
+    private void ReleaseBuffers()
+    {
+        if (_buffer is not null)
+            ReleaseBuffer(_buffer);
+
+        while (_spareBuffers is { Count: > 0 })
+            ReleaseBuffer(_spareBuffers.Pop());
+    }
+
+    private byte[] AllocBlockBuffer() =>
+        _spareBuffers is { Count: > 0 } ? _spareBuffers.Pop() : AllocBuffer(_bufferSize);
+
+    private int InjectOrDecode(int blockLength, bool uncompressed)
+    {
+        var started = LZ4Metrics.StartBlock();
+        var decoded = uncompressed
             ? _decoder.Inject(_buffer, 0, blockLength)
             : _decoder.Decode(_buffer, 0, blockLength);
+        LZ4Metrics.Block(
+            LZ4Metrics.Decode, LZ4Metrics.Frame,
+            blockLength, decoded, uncompressed, started);
+        return decoded;
+    }
 
     private bool Drain(Span<byte> buffer, ref int offset, ref int count, ref int read)
     {
@@ -113,7 +172,9 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
 
     private void VerifyBlockChecksum(uint expected, int blockLength)
     {
+        var started = LZ4Metrics.StartChecksum();
         var actual = XXH32.DigestOf(_buffer, 0, blockLength);
+        LZ4Metrics.Checksum(LZ4Metrics.Decode, LZ4Metrics.Frame, started);
         if (actual != expected) throw InvalidChecksum("block");
     }
 
@@ -123,8 +184,10 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
     private unsafe void UpdateContentChecksum(int read)
     {
         _decoder.AssertIsNotNull();
+        var started = LZ4Metrics.StartChecksum();
         var span = new Span<byte>(_decoder.Peek(-read), read);
         XXH32.Update(ref _contentChecksum, span);
+        LZ4Metrics.Checksum(LZ4Metrics.Decode, LZ4Metrics.Frame, started);
     }
 
     private void VerifyContentChecksum(uint expected)
@@ -193,6 +256,9 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
     private static InvalidDataException InvalidChecksum(string type) =>
         new($"Invalid {type} checksum");
 
+    private static InvalidOperationException InvalidOperation(string description) =>
+        new(description);
+
     /// <summary>
     /// Disposes the decoder. Consecutive attempts to read will fail.
     /// </summary>
@@ -236,6 +302,7 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
 	{
 		try
 		{
+			await AbandonPrefetched(CancellationToken.None).Weave();
 			CloseFrame();
 		}
 		finally
@@ -256,11 +323,12 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
         return loaded;
     }
 
-    private async Task<int> ReadMeta(CancellationToken token, int length, bool optional = false)
+    private async ValueTask<int> ReadMeta(
+        CancellationToken token, int length, bool optional = false)
     {
         var buffer = _stash.Data;
         var head = _stash.Head;
-        (_stream, var loaded) = await _reader
+        (_stream, var loaded) = await ValueReader
             .TryReadBlockAsync(_stream, buffer, head, length, optional, token)
             .Weave();
         return loaded;
@@ -273,11 +341,249 @@ public partial class LZ4FrameReader<TStreamReader, TStreamState>:
         _reader.TryReadBlock(ref _stream, _buffer, 0, length, false);
     }
 
-    private async Task ReadData(CancellationToken token, int length)
+    private async ValueTask ReadData(CancellationToken token, int length)
     {
         _buffer.AssertIsNotNull();
-        _stream = (await _reader
+        _stream = (await ValueReader
             .TryReadBlockAsync(_stream, _buffer, 0, length, false, token)
             .Weave()).Stream;
     }
+
+    /// <summary>
+    /// Blocking on read-ahead would be sync-over-async, so synchronous reads are refused
+    /// until it is finished (it is checked before anything is consumed). This includes
+    /// read-ahead abandoned by closed frame, as it still uses inner stream.
+    /// </summary>
+    // ReSharper disable once UnusedParameter.Local
+    private void EnsureNotReadingAhead(EmptyToken _)
+    {
+        if (_abandonedPrefetch is { IsCompleted: false })
+            throw InvalidOperation(
+                "Synchronous read cannot be issued while read-ahead is in progress");
+
+        if (_prefetched is null)
+            return;
+
+        foreach (var (block, _) in _prefetched)
+        {
+            if (!block.IsCompleted)
+                throw InvalidOperation(
+                    "Synchronous read cannot be issued while read-ahead is in progress");
+        }
+    }
+
+    /// <summary>
+    /// Asynchronous reads wait for read-ahead abandoned by closed frame, before they
+    /// touch inner stream (read-ahead of current frame is taken over by them).
+    /// </summary>
+    private async ValueTask EnsureNotReadingAhead(CancellationToken token)
+    {
+        if (_abandonedPrefetch is { IsCompleted: false })
+            await _abandonedPrefetch.WhenCompleted(token).Weave();
+    }
+
+    // ReSharper disable once UnusedParameter.Local
+    private PrefetchedBlock? TryTakePrefetched(EmptyToken _)
+    {
+        if (_prefetched is not { Count: > 0 })
+            return null;
+
+        // all blocks are completed already (see EnsureNotReadingAhead), so it does not block
+        var (next, buffer) = _prefetched.Peek();
+        return TakePrefetched(next, buffer).GetAwaiter().GetResult();
+    }
+
+    private async ValueTask<PrefetchedBlock?> TryTakePrefetched(CancellationToken token)
+    {
+        if (ReadAhead <= 0 && _prefetched is not { Count: > 0 })
+            return null;
+
+        _prefetched ??= new Queue<(Task<PrefetchedBlock>, byte[])>();
+        SchedulePrefetch();
+
+        // token of this call cancels waiting only, block stays in the queue for next read
+        var (next, buffer) = _prefetched.Peek();
+        await next.WhenCompleted(token).Weave();
+        var block = await TakePrefetched(next, buffer).Weave();
+
+        SchedulePrefetch();
+        return block;
+    }
+
+    private Task<PrefetchedBlock> TakePrefetched(Task<PrefetchedBlock> block, byte[] buffer)
+    {
+        _prefetched.AssertIsNotNull();
+        _prefetched.Dequeue();
+
+        // failed read-ahead is going to be reported, but its buffer is not going to be used
+        if (block.Status != TaskStatus.RanToCompletion)
+            ReleaseBuffer(buffer);
+
+        return block;
+    }
+
+    private void SchedulePrefetch()
+    {
+        _prefetched.AssertIsNotNull();
+        _descriptor.AssertIsNotNull();
+
+        var blockChecksum = _descriptor.BlockChecksum;
+        var contentChecksum = _descriptor.ContentChecksum;
+
+        // read-ahead outlives calls which started it, so it uses reader's own token
+        var token = (_prefetchCancel ??= new CancellationTokenSource()).Token;
+
+        while (_prefetched.Count < Math.Max(1, ReadAhead))
+        {
+            var buffer = AllocBlockBuffer();
+            var next = PrefetchBlock(
+                _lastPrefetch, buffer, blockChecksum, contentChecksum, token);
+            _prefetched.Enqueue((next, buffer));
+            _lastPrefetch = next;
+        }
+    }
+
+    private async Task<PrefetchedBlock> PrefetchBlock(
+        Task<PrefetchedBlock>? previous, byte[] buffer,
+        bool blockChecksum, bool contentChecksum,
+        CancellationToken token)
+    {
+        // nothing past end mark is ever read from inner stream, blocks scheduled
+        // after it are empty and get discarded when frame is closed
+        if (previous is not null && (await previous.Weave()).Length == 0)
+            return new PrefetchedBlock(buffer, 0, 0);
+
+        var length = await PrefetchUInt32(buffer, 0, token).Weave();
+        if (length == 0)
+        {
+            var content = contentChecksum ? await PrefetchUInt32(buffer, 0, token).Weave() : 0;
+            return new PrefetchedBlock(buffer, 0, content);
+        }
+
+        var blockLength = (int)(length & 0x7FFFFFFF);
+        _stream = (await ValueReader
+            .TryReadBlockAsync(_stream, buffer, 0, blockLength, false, token)
+            .Weave()).Stream;
+        var checksum = blockChecksum
+            ? await PrefetchUInt32(buffer, blockLength, token).Weave()
+            : 0;
+
+        return new PrefetchedBlock(buffer, length, checksum);
+    }
+
+    private async ValueTask<uint> PrefetchUInt32(
+        byte[] buffer, int offset, CancellationToken token)
+    {
+        _stream = (await ValueReader
+            .TryReadBlockAsync(_stream, buffer, offset, sizeof(uint), false, token)
+            .Weave()).Stream;
+        return BitConverter.ToUInt32(buffer, offset);
+    }
+
+    private int DecodePrefetched(PrefetchedBlock block)
+    {
+        _descriptor.AssertIsNotNull();
+
+        if (_buffer is not null)
+            (_spareBuffers ??= new Stack<byte[]>()).Push(_buffer);
+        _buffer = block.Buffer;
+
+        if (block.Length == 0)
+        {
+            if (_descriptor.ContentChecksum)
+                VerifyContentChecksum(block.Checksum);
+
+            CloseFrame();
+            return 0;
+        }
+
+        var uncompressed = (block.Length & 0x80000000) != 0;
+        var blockLength = (int)(block.Length & 0x7FFFFFFF);
+
+        if (_descriptor.BlockChecksum)
+            VerifyBlockChecksum(block.Checksum, blockLength);
+
+        var read = InjectOrDecode(blockLength, uncompressed);
+        UpdateContentChecksum(read);
+        return read;
+    }
+
+    /// <summary>
+    /// Cancels read-ahead (frame is closed before it finished, most likely reader is being
+    /// disposed). Blocking on reads in progress would be sync-over-async (it could deadlock,
+    /// or hang if inner stream ignores cancellation), so their buffers are released when
+    /// they finish, and reads from inner stream wait for them
+    /// (see <see cref="EnsureNotReadingAhead(EmptyToken)"/>).
+    /// </summary>
+    private void AbandonPrefetched()
+    {
+        var pending = DetachPrefetched(out var cancel);
+        if (pending is null)
+            return;
+
+        // previously abandoned read-ahead (if any) is still waited for
+        var blocks = new Task[pending.Count + 1];
+        var completed = true;
+        var index = 0;
+        foreach (var (block, _) in pending)
+        {
+            blocks[index++] = block;
+            completed &= block.IsCompleted;
+        }
+        blocks[index] = _abandonedPrefetch ?? Task.CompletedTask;
+
+        if (completed)
+        {
+            ReleasePrefetched(pending, cancel);
+            return;
+        }
+
+        _abandonedPrefetch = Task.WhenAll(blocks).ContinueWith(
+            all => {
+                _ = all.Exception; // cancelled, so nobody is going to observe it
+                ReleasePrefetched(pending, cancel);
+            },
+            CancellationToken.None,
+            TaskContinuationOptions.ExecuteSynchronously,
+            TaskScheduler.Default);
+    }
+
+    // ReSharper disable once UnusedParameter.Local
+    private async Task AbandonPrefetched(CancellationToken _)
+    {
+        var pending = DetachPrefetched(out var cancel);
+
+        if (pending is not null)
+        {
+            foreach (var (block, _) in pending)
+                await Task.WhenAny(block).Weave();
+
+            ReleasePrefetched(pending, cancel);
+        }
+
+        if (_abandonedPrefetch is not null)
+            await _abandonedPrefetch.Weave();
+    }
+
+    private Queue<(Task<PrefetchedBlock> Block, byte[] Buffer)>? DetachPrefetched(
+        out CancellationTokenSource? cancel)
+    {
+        var pending = _prefetched;
+        cancel = _prefetchCancel;
+        _prefetched = null;
+        _lastPrefetch = null;
+        _prefetchCancel = null;
+        cancel?.Cancel();
+        return pending;
+    }
+
+    private void ReleasePrefetched(
+        Queue<(Task<PrefetchedBlock> Block, byte[] Buffer)> pending,
+        CancellationTokenSource? cancel)
+    {
+        while (pending.Count > 0)
+            ReleaseBuffer(pending.Dequeue().Buffer);
+
+        cancel?.Dispose();
+    }
 }
@@ -12,17 +12,12 @@ namespace K4os.Compression.LZ4.Streams.Frames;
 
 public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
 {
-    private async Task WriteBlock(Token token, BlockInfo block)
+    private async ValueTask WriteBlock(Token token, BlockInfo block, bool closing = false)
     {
         if (!block.Ready) return;
 
-        _stash.Poke4(BlockLengthCode(block));
-        await FlushMeta(token).Weave();
-
-        await WriteData(token, block).Weave();
-
-        _stash.TryPoke4(BlockChecksum(block));
-        await FlushMeta(token, true).Weave();
+        var length = FrameBlock(block, closing);
+        await WriteData(token, block, length).Weave();
     }
 
     private Task WriteOneByte(Token token, byte value) =>
@@ -35,6 +30,9 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
 
         _descriptor.AssertIsNotNull();
 
+        if (buffer.Length > 0)
+            EnsureNotMixed(false);
+
         if (_descriptor.ContentChecksum)
             UpdateContentChecksum(buffer.ToSpan());
 
@@ -48,6 +46,30 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
         }
     }
 
+    private async Task WriteRawBlock(Token token, ReadableBuffer block, bool compressed)
+    {
+        if (TryStashFrame())
+            await FlushMeta(token).Weave();
+
+        // data written so far needs to be sent before pre-compressed block
+        var pending = FlushAndEncode();
+        if (pending.Ready) await WriteBlock(token, pending).Weave();
+
+        await WriteBlock(token, StashRawBlock(block.ToSpan(), compressed)).Weave();
+    }
+
+    private async Task FlushBlock(Token token)
+    {
+        if (_encoder == null)
+            return;
+
+        var block = FlushAndEncode();
+        if (block.Ready) await WriteBlock(token, block).Weave();
+
+        // waits for pending writes and flushes underlying stream (if it can be flushed)
+        await FlushMeta(token, true).Weave();
+    }
+
     private async Task<bool> OpenFrame(Token token)
     {
         if (!TryStashFrame())
@@ -65,24 +87,32 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
         try
         {
             await WriteFrameTail(token).Weave();
-
-            if (_buffer is not null)
-                ReleaseBuffer(_buffer);
-            _encoder.Dispose();
+            await FlushWrites(token).Weave();
         }
         finally
         {
+            // pending writes (if frame is closed after failure) need to finish before
+            // their buffers are released
+            await AbandonWrites(token).Weave();
+            ReleaseBuffers();
+            _encoder.Dispose();
+
             _encoder = null;
+            _adaptiveEncoder = null;
             _descriptor = null;
             _buffer = null;
+            _rawBlocks = null;
         }
     }
 
-    private async Task WriteFrameTail(Token token)
+    private async ValueTask WriteFrameTail(Token token)
     {
         var block = FlushAndEncode();
         if (block.Ready)
-            await WriteBlock(token, block).Weave();
+        {
+            await WriteBlock(token, block, true).Weave();
+            return;
+        }
 
         _stash.Poke4(0);
         _stash.TryPoke4(ContentChecksum());
@@ -19,17 +19,12 @@ namespace K4os.Compression.LZ4.Streams.Frames;
 
 public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
 {
-    private /*async*/ void WriteBlock(Token token, BlockInfo block)
+    private /*async*/ void WriteBlock(Token token, BlockInfo block, bool closing = false)
     {
         if (!block.Ready) return;
 
-        _stash.Poke4(BlockLengthCode(block));
-        /*await*/ FlushMeta(token);
-
-        /*await*/ WriteData(token, block);
-
-        _stash.TryPoke4(BlockChecksum(block));
-        /*await*/ FlushMeta(token, true);
+        var length = FrameBlock(block, closing);
+        /*await*/ WriteData(token, block, length);
     }
 
     private void WriteOneByte(Token token, byte value) =>
@@ -42,6 +37,9 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
 
         _descriptor.AssertIsNotNull();
 
+        if (buffer.Length > 0)
+            EnsureNotMixed(false);
+
         if (_descriptor.ContentChecksum)
             UpdateContentChecksum(buffer.ToSpan());
 
@@ -55,6 +53,30 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
         }
     }
 
+    private /*async*/ void WriteRawBlock(Token token, ReadableBuffer block, bool compressed)
+    {
+        if (TryStashFrame())
+            /*await*/ FlushMeta(token);
+
+        // data written so far needs to be sent before pre-compressed block
+        var pending = FlushAndEncode();
+        if (pending.Ready) /*await*/ WriteBlock(token, pending);
+
+        /*await*/ WriteBlock(token, StashRawBlock(block.ToSpan(), compressed));
+    }
+
+    private /*async*/ void FlushBlock(Token token)
+    {
+        if (_encoder == null)
+            return;
+
+        var block = FlushAndEncode();
+        if (block.Ready) /*await*/ WriteBlock(token, block);
+
+        // waits for pending writes and flushes underlying stream (if it can be flushed)
+        /*await*/ FlushMeta(token, true);
+    }
+
     private /*async*/ bool OpenFrame(Token token)
     {
         if (!TryStashFrame())
@@ -72,16 +94,21 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
         try
         {
             /*await*/ WriteFrameTail(token);
-
-            if (_buffer is not null)
-                ReleaseBuffer(_buffer);
-            _encoder.Dispose();
+            /*await*/ FlushWrites(token);
         }
         finally
         {
+            // pending writes (if frame is closed after failure) need to finish before
+            // their buffers are released
+            /*await*/ AbandonWrites(token);
+            ReleaseBuffers();
+            _encoder.Dispose();
+
             _encoder = null;
+            _adaptiveEncoder = null;
             _descriptor = null;
             _buffer = null;
+            _rawBlocks = null;
         }
     }
 
@@ -89,7 +116,10 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>
     {
         var block = FlushAndEncode();
         if (block.Ready)
-            /*await*/ WriteBlock(token, block);
+        {
+            /*await*/ WriteBlock(token, block, true);
+            return;
+        }
 
         _stash.Poke4(0);
         _stash.TryPoke4(ContentChecksum());
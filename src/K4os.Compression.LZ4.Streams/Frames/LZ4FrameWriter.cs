@@ -1,4 +1,5 @@
-﻿using System.Diagnostics.CodeAnalysis;
+﻿using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
 using System.Runtime.CompilerServices;
 using K4os.Compression.LZ4.Encoders;
 using K4os.Compression.LZ4.Internal;
@@ -15,17 +16,35 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
     ILZ4FrameWriter
     where TStreamWriter: IStreamWriter<TStreamState>
 {
+    // block length, written in front of block payload
+    private const int BlockHeaderSize = sizeof(uint);
+
+    // block checksum, end mark, and content checksum, written after block payload
+    private const int BlockTrailerSize = 3 * sizeof(uint);
+
     private readonly TStreamWriter _writer;
+    private IStreamValueWriter<TStreamState>? _valueWriter;
     private TStreamState _stream;
     private Stash _stash = new();
 
     private readonly Func<ILZ4Descriptor, ILZ4Encoder> _encoderFactory;
     private ILZ4Descriptor? _descriptor;
     private ILZ4Encoder? _encoder;
+    private LZ4AdaptiveEncoder? _adaptiveEncoder;
+    private long _blockEnded;
+    private long _writeTicks;
 
     private byte[]? _buffer;
+    private int _bufferSize;
+
+    private Queue<(Task Write, byte[] Buffer)>? _pendingWrites;
+    private Task? _lastWrite;
+    private CancellationTokenSource? _writeCancel;
+    private Stack<byte[]>? _spareBuffers;
 
     private long _bytesWritten;
+    private int _blockLoaded;
+    private bool? _rawBlocks;
     private XXH32.State _contentChecksum;
 
     /// <summary>Creates new instance of <see cref="LZ4EncoderStream"/>.</summary>
@@ -53,6 +72,21 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
     /// </summary>
     protected TStreamState StreamState => _stream;
 
+    /// <summary>
+    /// Maximum number of encoded blocks which can be waiting to be written to inner stream
+    /// while next block is being compressed. It is applied to asynchronous operations only,
+    /// allowing compression of block N+1 to overlap with writing block N. Every pending
+    /// block holds its own buffer, so memory usage grows accordingly. Errors from pending
+    /// writes are reported by following write (or when frame is closed). Pending writes
+    /// are not bound to cancellation token of the call which started them (cancelling a call
+    /// stops waiting only), they are cancelled only if frame is closed after failure.
+    /// Default is <c>0</c> (blocks are written immediately after being compressed).
+    /// </summary>
+    public int MaxPendingWrites { get; set; }
+
+    private IStreamValueWriter<TStreamState> ValueWriter =>
+        _valueWriter ??= StreamValueAdapter.AsValueWriter<TStreamWriter, TStreamState>(_writer);
+
     [SuppressMessage("ReSharper", "InconsistentNaming")]
     private bool TryStashFrame()
     {
@@ -102,7 +136,13 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
         _stash.Poke1(HC);
 
         _encoder = CreateEncoder();
-        _buffer = AllocateBuffer(LZ4Codec.MaximumOutputSize(blockSize));
+        _adaptiveEncoder =
+            _encoder is LZ4AdaptiveEncoder { Controller: not null } adaptive ? adaptive : null;
+        _blockEnded = Stopwatch.GetTimestamp();
+        _writeTicks = 0;
+        _bufferSize =
+            BlockHeaderSize + LZ4Codec.MaximumOutputSize(blockSize) + BlockTrailerSize;
+        _buffer = AllocateBuffer(_bufferSize);
 
         return true;
     }
@@ -116,6 +156,15 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
     /// <param name="buffer">Previously allocated buffer.</param>
     protected virtual void ReleaseBuffer(byte[] buffer) => BufferPool.Free(buffer);
 
+    private void ReleaseBuffers()
+    {
+        if (_buffer is not null)
+            ReleaseBuffer(_buffer);
+
+        while (_spareBuffers is { Count: > 0 })
+            ReleaseBuffer(_spareBuffers.Pop());
+    }
+
     private ILZ4Encoder CreateEncoder()
     {
         _descriptor.AssertIsNotNull();
@@ -127,50 +176,218 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
         return encoder;
     }
 
+    private Span<byte> BlockPayload()
+    {
+        _buffer.AssertIsNotNull();
+        return _buffer.AsSpan(
+            BlockHeaderSize, _buffer.Length - BlockHeaderSize - BlockTrailerSize);
+    }
+
     private BlockInfo TopupAndEncode(
         ReadOnlySpan<byte> buffer, ref int offset, ref int count)
     {
         _buffer.AssertIsNotNull();
 
+        var started = StartBlock();
         var action = _encoder.TopupAndEncode(
             buffer.Slice(offset, count),
-            _buffer.AsSpan(),
+            BlockPayload(),
             false, true,
             out var loaded,
             out var encoded);
 
         _bytesWritten += loaded;
+        _blockLoaded += loaded;
         offset += loaded;
         count -= loaded;
 
-        return new BlockInfo(_buffer, action, encoded);
+        return Encoded(action, encoded, started);
     }
 
     private BlockInfo FlushAndEncode()
     {
         _buffer.AssertIsNotNull();
 
+        var started = StartBlock();
         var action = _encoder.FlushAndEncode(
-            _buffer.AsSpan(), true, out var encoded);
+            BlockPayload(), true, out var encoded);
 
-        return new BlockInfo(_buffer, action, encoded);
+        return Encoded(action, encoded, started);
     }
 
+    private BlockInfo Encoded(EncoderAction action, int encoded, long started)
+    {
+        _buffer.AssertIsNotNull();
+
+        var block = new BlockInfo(_buffer, BlockHeaderSize, action, encoded);
+        if (!block.Ready) return block;
+
+        LZ4Metrics.Block(
+            LZ4Metrics.Encode, LZ4Metrics.Frame,
+            _blockLoaded, block.Length, !block.Compressed, started);
+        AdaptLevel(block, started);
+        _blockLoaded = 0;
+
+        return block;
+    }
+
+    /// <summary>Starts measuring block (always, if compression level is adaptive).</summary>
+    private long StartBlock() =>
+        _adaptiveEncoder is null ? LZ4Metrics.StartBlock() : Stopwatch.GetTimestamp();
+
+    /// <summary>
+    /// Feeds level controller of adaptive encoder with time spent compressing block, time
+    /// elapsed since previous one and time spent writing blocks in the meantime, and sets
+    /// level for next block.
+    /// </summary>
+    private void AdaptLevel(in BlockInfo block, long started)
+    {
+        if (_adaptiveEncoder?.Controller is not { } controller)
+            return;
+
+        var now = Stopwatch.GetTimestamp();
+        var seconds = (double)(now - started) / Stopwatch.Frequency;
+        var elapsed = (double)(now - _blockEnded) / Stopwatch.Frequency;
+        var written = (double)Interlocked.Exchange(ref _writeTicks, 0) / Stopwatch.Frequency;
+        _blockEnded = now;
+
+        var level = controller.Update(_blockLoaded, block.Length, seconds, elapsed, written);
+        if (level != _adaptiveEncoder.Level)
+            LZ4Metrics.LevelChange(
+                LZ4Metrics.Encode, LZ4Metrics.Frame, level, controller.Reason);
+
+        _adaptiveEncoder.Level = level;
+    }
+
+    /// <summary>Starts measuring write (always, if compression level is adaptive).</summary>
+    private long StartWrite() =>
+        _adaptiveEncoder is null ? LZ4Metrics.StartWrite() : Stopwatch.GetTimestamp();
+
+    /// <summary>
+    /// Records time spent writing block. With pending writes it is called from write's
+    /// continuation, while next block is being compressed, so time is just accumulated
+    /// (see <see cref="AdaptLevel"/>).
+    /// </summary>
+    private void Written(long started)
+    {
+        LZ4Metrics.Write(LZ4Metrics.Encode, LZ4Metrics.Frame, started);
+        if (_adaptiveEncoder is not null)
+            Interlocked.Add(ref _writeTicks, Stopwatch.GetTimestamp() - started);
+    }
+
+    /// <summary>
+    /// Copies pre-compressed block into buffer, so it can be framed and sent the same way
+    /// as blocks produced by encoder.
+    /// </summary>
+    private BlockInfo StashRawBlock(ReadOnlySpan<byte> block, bool compressed)
+    {
+        _descriptor.AssertIsNotNull();
+        _buffer.AssertIsNotNull();
+
+        if (_descriptor.ContentChecksum)
+            throw InvalidOperation(
+                "Pre-compressed blocks cannot be written to frames with content checksum");
+
+        EnsureNotMixed(true);
+
+        var blockSize = _descriptor.BlockSize;
+        var length = block.Length;
+        if (length <= 0 || length > blockSize)
+            throw InvalidValue($"Invalid block length {length} for block size {blockSize}");
+
+        // walks block tokens only, it is much cheaper than decoding, but catches most problems
+        var decoded = compressed
+            ? LZ4Codec.GetDecodedLength(block, _descriptor.Chaining ? Mem.K64 : 0)
+            : length;
+        if (decoded <= 0 || decoded > blockSize)
+            throw InvalidValue("Block is not a valid LZ4 block for this frame");
+
+        block.CopyTo(_buffer.AsSpan(BlockHeaderSize));
+        _bytesWritten += decoded;
+
+        return new BlockInfo(
+            _buffer, BlockHeaderSize,
+            compressed ? EncoderAction.Encoded : EncoderAction.Copied,
+            length);
+    }
+
+    /// <summary>
+    /// Chained blocks reference previous ones, so encoder's history would not match
+    /// pre-compressed blocks (and vice versa). In chained frames, only one kind of
+    /// blocks can be written.
+    /// </summary>
+    private void EnsureNotMixed(bool raw)
+    {
+        _descriptor.AssertIsNotNull();
+
+        if (!_descriptor.Chaining || _rawBlocks == raw)
+            return;
+
+        if (_rawBlocks.HasValue)
+            throw InvalidOperation(
+                "Pre-compressed blocks and regular writes cannot be mixed in chained frame");
+
+        _rawBlocks = raw;
+    }
+
+    /// <summary>
+    /// Surrounds encoded block (already placed in buffer) with its length and checksum,
+    /// and optionally with frame end mark, so whole block can be sent to inner stream
+    /// with single write.
+    /// </summary>
+    /// <param name="block">Encoded block.</param>
+    /// <param name="closing">Indicates that frame tail should be appended as well.</param>
+    /// <returns>Length of framed block (starting at offset 0).</returns>
+    private int FrameBlock(in BlockInfo block, bool closing)
+    {
+        var buffer = block.Buffer;
+        var head = block.Offset - BlockHeaderSize;
+        var tail = block.Offset + block.Length;
+
+        Poke4(buffer, head, BlockLengthCode(block));
+        tail = TryPoke4(buffer, tail, BlockChecksum(block));
+
+        if (!closing) return tail;
+
+        tail = Poke4(buffer, tail, 0);
+        tail = TryPoke4(buffer, tail, ContentChecksum());
+        return tail;
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int Poke4(byte[] buffer, int offset, uint value)
+    {
+        Unsafe.WriteUnaligned(ref buffer[offset], value);
+        return offset + sizeof(uint);
+    }
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int TryPoke4(byte[] buffer, int offset, uint? value) =>
+        value.HasValue ? Poke4(buffer, offset, value.Value) : offset;
+
     private static uint BlockLengthCode(in BlockInfo block) =>
         (uint)block.Length | (block.Compressed ? 0 : 0x80000000);
 
     private void InitializeContentChecksum() =>
         XXH32.Reset(ref _contentChecksum);
 
-    private void UpdateContentChecksum(ReadOnlySpan<byte> buffer) =>
+    private void UpdateContentChecksum(ReadOnlySpan<byte> buffer)
+    {
+        var started = LZ4Metrics.StartChecksum();
         XXH32.Update(ref _contentChecksum, buffer);
+        LZ4Metrics.Checksum(LZ4Metrics.Encode, LZ4Metrics.Frame, started);
+    }
 
     private uint? BlockChecksum(BlockInfo block)
     {
         _descriptor.AssertIsNotNull();
-        return _descriptor.BlockChecksum
-            ? XXH32.DigestOf(block.Buffer, block.Offset, block.Length)
-            : null;
+        if (!_descriptor.BlockChecksum)
+            return null;
+
+        var started = LZ4Metrics.StartChecksum();
+        var checksum = XXH32.DigestOf(block.Buffer, block.Offset, block.Length);
+        LZ4Metrics.Checksum(LZ4Metrics.Encode, LZ4Metrics.Frame, started);
+        return checksum;
     }
 
     private uint? ContentChecksum()
@@ -212,6 +429,48 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
     public Task WriteManyBytesAsync(CancellationToken token, ReadOnlyMemory<byte> buffer) =>
         WriteManyBytes(token, buffer);
 
+    /// <summary>
+    /// Writes block which has already been compressed (for example, one read with
+    /// <see cref="LZ4RawFrameReader"/>), so frames can be re-framed, split or concatenated
+    /// without decoding and encoding. Data written so far is flushed as a block first.
+    /// Block is validated (by walking its tokens) but not decoded, so frames with content
+    /// checksum are not supported, and in chained frames pre-compressed blocks cannot be
+    /// mixed with regular writes.
+    /// </summary>
+    /// <param name="block">Block payload (compressed or stored).</param>
+    /// <param name="compressed">Indicates if block is compressed (<c>false</c> if it is
+    /// stored as is).</param>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public void WriteRawBlock(ReadOnlySpan<byte> block, bool compressed = true) =>
+        WriteRawBlock(EmptyToken.Value, block, compressed);
+
+    /// <summary>Async version of <see cref="WriteRawBlock(ReadOnlySpan{byte},bool)"/>.</summary>
+    /// <param name="token">Cancellation token.</param>
+    /// <param name="block">Block payload (compressed or stored).</param>
+    /// <param name="compressed">Indicates if block is compressed (<c>false</c> if it is
+    /// stored as is).</param>
+    /// <returns>Task indicating completion of the operation.</returns>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public Task WriteRawBlockAsync(
+        CancellationToken token, ReadOnlyMemory<byte> block, bool compressed = true) =>
+        WriteRawBlock(token, block, compressed);
+
+    /// <summary>
+    /// Compresses and writes data buffered so far as a block (even if block is not full),
+    /// and flushes underlying stream, so everything written so far can be decoded by
+    /// the reader. Frame stays open and, in chained frames, next block can still reference
+    /// data from previous ones, so it is much cheaper than closing the frame, although
+    /// frequent flushes make blocks smaller and compression ratio worse.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public void FlushBlock() => FlushBlock(EmptyToken.Value);
+
+    /// <summary>Async version of <see cref="FlushBlock()"/>.</summary>
+    /// <param name="token">Cancellation token.</param>
+    /// <returns>Task indicating completion of the operation.</returns>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public Task FlushBlockAsync(CancellationToken token = default) => FlushBlock(token);
+
     /// <inheritdoc />
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public bool OpenFrame() => OpenFrame(EmptyToken.Value);
@@ -285,6 +544,8 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
     // ReSharper disable once UnusedParameter.Local
     private void FlushMeta(EmptyToken _, bool eof = false)
     {
+        FlushWrites(EmptyToken.Value);
+
         var length = _stash.Flush();
 
         if (length > 0)
@@ -294,28 +555,168 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
             _writer.Flush(ref _stream);
     }
 
-    private async Task FlushMeta(CancellationToken token, bool eof = false)
+    private async ValueTask FlushMeta(CancellationToken token, bool eof = false)
     {
+        await FlushWrites(token).Weave();
+
         var length = _stash.Flush();
 
         if (length > 0)
-            _stream = await _writer.WriteAsync(_stream, _stash.Data, 0, length, token).Weave();
+            _stream = await ValueWriter
+                .WriteValueAsync(_stream, _stash.Data, 0, length, token)
+                .Weave();
 
         if (eof && _writer.CanFlush)
-            _stream = await _writer.FlushAsync(_stream, token).Weave();
+            _stream = await ValueWriter.FlushValueAsync(_stream, token).Weave();
     }
 
     // ReSharper disable once UnusedParameter.Local
-    private void WriteData(EmptyToken _, BlockInfo block)
+    private void WriteData(EmptyToken _, BlockInfo block, int length)
+    {
+        FlushWrites(EmptyToken.Value);
+
+        var started = StartWrite();
+
+        _writer.Write(ref _stream, block.Buffer, 0, length);
+
+        if (_writer.CanFlush)
+            _writer.Flush(ref _stream);
+
+        Written(started);
+    }
+
+    private async ValueTask WriteData(CancellationToken token, BlockInfo block, int length)
+    {
+        if (MaxPendingWrites > 0)
+        {
+            await EnqueueWrite(token, block.Buffer, length).Weave();
+            return;
+        }
+
+        await FlushWrites(token).Weave();
+        await WriteAndFlush(block.Buffer, length, token).Weave();
+    }
+
+    private async Task WriteAfter(
+        Task previous, byte[] buffer, int length, CancellationToken token)
     {
-        _writer.Write(ref _stream, block.Buffer, block.Offset, block.Length);
+        await previous.Weave();
+        await WriteAndFlush(buffer, length, token).Weave();
     }
 
-    private async Task WriteData(CancellationToken token, BlockInfo block)
+    private async ValueTask WriteAndFlush(byte[] buffer, int length, CancellationToken token)
     {
-        _stream = await _writer
-            .WriteAsync(_stream, block.Buffer, block.Offset, block.Length, token)
+        var started = StartWrite();
+
+        _stream = await ValueWriter
+            .WriteValueAsync(_stream, buffer, 0, length, token)
             .Weave();
+
+        if (_writer.CanFlush)
+            _stream = await ValueWriter.FlushValueAsync(_stream, token).Weave();
+
+        Written(started);
+    }
+
+    /// <summary>
+    /// Schedules write of given buffer after all pending writes, and replaces
+    /// current block buffer, so next block can be compressed while this one is
+    /// still being written.
+    /// </summary>
+    private async ValueTask EnqueueWrite(CancellationToken token, byte[] buffer, int length)
+    {
+        _pendingWrites ??= new Queue<(Task, byte[])>();
+        _spareBuffers ??= new Stack<byte[]>();
+
+        // pending writes outlive calls which started them, so they use writer's own token
+        var writeToken = (_writeCancel ??= new CancellationTokenSource()).Token;
+        var write = WriteAfter(_lastWrite ?? Task.CompletedTask, buffer, length, writeToken);
+        _pendingWrites.Enqueue((write, buffer));
+        _lastWrite = write;
+
+        try
+        {
+            while (_pendingWrites.Count > 0)
+            {
+                var (oldest, _) = _pendingWrites.Peek();
+                if (_pendingWrites.Count <= MaxPendingWrites && !oldest.IsCompleted)
+                    break;
+
+                await TakePendingWrite(token).Weave();
+            }
+        }
+        finally
+        {
+            // buffer is owned by pending write now, even if waiting was cancelled
+            _buffer = _spareBuffers.Count > 0
+                ? _spareBuffers.Pop()
+                : AllocateBuffer(_bufferSize);
+        }
+    }
+
+    /// <summary>
+    /// Waits for oldest pending write (token cancels waiting only), recycles its buffer
+    /// and reports its failure, if any.
+    /// </summary>
+    private async ValueTask TakePendingWrite(CancellationToken token)
+    {
+        _pendingWrites.AssertIsNotNull();
+
+        var (write, buffer) = _pendingWrites.Peek();
+        await write.WhenCompleted(token).Weave();
+        _pendingWrites.Dequeue();
+        (_spareBuffers ??= new Stack<byte[]>()).Push(buffer);
+        await write.Weave();
+    }
+
+    // ReSharper disable once UnusedParameter.Local
+    private void FlushWrites(EmptyToken _)
+    {
+        if (_pendingWrites is not { Count: > 0 })
+            return;
+
+        FlushWrites(CancellationToken.None).AsTask().GetAwaiter().GetResult();
+    }
+
+    private async ValueTask FlushWrites(CancellationToken token)
+    {
+        if (_pendingWrites is null)
+            return;
+
+        while (_pendingWrites.Count > 0)
+            await TakePendingWrite(token).Weave();
+
+        _lastWrite = null;
+    }
+
+    // ReSharper disable once UnusedParameter.Local
+    private void AbandonWrites(EmptyToken _)
+    {
+        if (_pendingWrites is not { Count: > 0 } && _writeCancel is null)
+            return;
+
+        AbandonWrites(CancellationToken.None).AsTask().GetAwaiter().GetResult();
+    }
+
+    /// <summary>
+    /// Cancels writes which are still pending (frame is closed after failure) and waits
+    /// for them, so their buffers can be returned to the pool.
+    /// </summary>
+    // ReSharper disable once UnusedParameter.Local
+    private async ValueTask AbandonWrites(CancellationToken _)
+    {
+        _writeCancel?.Cancel();
+
+        while (_pendingWrites is { Count: > 0 })
+        {
+            var (write, buffer) = _pendingWrites.Dequeue();
+            await Task.WhenAny(write).Weave();
+            (_spareBuffers ??= new Stack<byte[]>()).Push(buffer);
+        }
+
+        _lastWrite = null;
+        _writeCancel?.Dispose();
+        _writeCancel = null;
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -334,6 +735,9 @@ public partial class LZ4FrameWriter<TStreamWriter, TStreamState>:
     private static ArgumentException InvalidValue(string description) =>
         new(description);
 
+    private static InvalidOperationException InvalidOperation(string description) =>
+        new(description);
+
     private protected ArgumentException InvalidBlockSize(int blockSize) =>
         InvalidValue($"Invalid block size ${blockSize} for {GetType().Name}");
 }
@@ -0,0 +1,40 @@
+namespace K4os.Compression.LZ4.Streams.Frames;
+
+/// <summary>
+/// Block of LZ4 frame, as it is stored in the stream (not decoded),
+/// see <see cref="LZ4RawFrameReader"/>.
+/// </summary>
+public readonly struct LZ4RawBlock
+{
+    /// <summary>Descriptor (header flags) of frame this block belongs to.</summary>
+    public ILZ4Descriptor Descriptor { get; }
+
+    /// <summary>Index of frame (in the stream) this block belongs to.</summary>
+    public long Frame { get; }
+
+    /// <summary>Block payload. Please note, it is valid only until next block is read.</summary>
+    public ReadOnlyMemory<byte> Data { get; }
+
+    /// <summary>Indicates if block is compressed (<c>false</c> means it is stored as is).</summary>
+    public bool Compressed { get; }
+
+    /// <summary>Block checksum (if frame has block checksums).</summary>
+    public uint? Checksum { get; }
+
+    /// <summary>Creates new instance of <see cref="LZ4RawBlock"/>.</summary>
+    /// <param name="descriptor">Frame descriptor.</param>
+    /// <param name="frame">Frame index.</param>
+    /// <param name="data">Block payload.</param>
+    /// <param name="compressed">Compressed flag.</param>
+    /// <param name="checksum">Block checksum.</param>
+    public LZ4RawBlock(
+        ILZ4Descriptor descriptor, long frame,
+        ReadOnlyMemory<byte> data, bool compressed, uint? checksum)
+    {
+        Descriptor = descriptor;
+        Frame = frame;
+        Data = data;
+        Compressed = compressed;
+        Checksum = checksum;
+    }
+}
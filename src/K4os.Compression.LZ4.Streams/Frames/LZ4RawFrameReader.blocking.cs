@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+//
+// This file has been generated. All changes will be lost.
+//
+//------------------------------------------------------------------------------
+#define BLOCKING
+
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Internal;
+
+#if BLOCKING
+using Token = K4os.Compression.LZ4.Streams.Internal.EmptyToken;
+#else
+using Token = System.Threading.CancellationToken;
+#endif
+
+namespace K4os.Compression.LZ4.Streams.Frames;
+
+public partial class LZ4RawFrameReader
+{
+    private /*async*/ void ReadExactly(Token token, byte[] buffer, int offset, int length)
+    {
+        if (length > 0 && !/*await*/ TryReadExactly(token, buffer, offset, length))
+            throw UnexpectedEndOfStream();
+    }
+
+    private /*async*/ uint Read4(Token token)
+    {
+        /*await*/ ReadExactly(token, _header, 0, sizeof(uint));
+        return Peek4();
+    }
+
+    private /*async*/ void Skip(Token token, long length)
+    {
+        var buffer = new byte[Math.Min(length, Mem.K4)];
+        while (length > 0)
+        {
+            var chunk = (int)Math.Min(length, buffer.Length);
+            /*await*/ ReadExactly(token, buffer, 0, chunk);
+            length -= chunk;
+        }
+    }
+
+    private /*async*/ LZ4RawBlock? ReadBlock(Token token)
+    {
+        while (true)
+        {
+            if (_descriptor is null && !/*await*/ ReadHeader(token))
+                return null;
+
+            _descriptor.AssertIsNotNull();
+
+            var blockLength = /*await*/ Read4(token);
+            if (blockLength == 0)
+            {
+                if (_descriptor.ContentChecksum) /*await*/ Read4(token);
+                _descriptor = null;
+                continue;
+            }
+
+            var compressed = (blockLength & 0x80000000) == 0;
+            var length = (int)(blockLength & 0x7FFFFFFF);
+            if (length > _descriptor.BlockSize)
+                throw Corrupted($"Block length {length} exceeds maximum {_descriptor.BlockSize}");
+
+            /*await*/ ReadExactly(token, _buffer, 0, length);
+            var checksum = _descriptor.BlockChecksum ? /*await*/ Read4(token) : default(uint?);
+
+            return new LZ4RawBlock(
+                _descriptor, _frame, _buffer.AsMemory(0, length), compressed, checksum);
+        }
+    }
+
+    private /*async*/ bool ReadHeader(Token token)
+    {
+        while (true)
+        {
+            if (!/*await*/ TryReadExactly(token, _header, 0, sizeof(uint)))
+                return false;
+
+            var magic = Peek4();
+            if (LZ4FrameHeader.IsSkippable(magic))
+            {
+                /*await*/ Skip(token, /*await*/ Read4(token));
+                continue;
+            }
+
+            if (magic != LZ4FrameHeader.FrameMagic)
+                throw Corrupted("LZ4 frame magic number expected");
+
+            /*await*/ ReadExactly(token, _header, 0, LZ4FrameHeader.FlagsLength);
+            var error = LZ4FrameHeader.CheckFlags(_header);
+            if (error is not null)
+                throw Corrupted(error);
+
+            var length = LZ4FrameHeader.DescriptorLength(_header[0]) + 1;
+            /*await*/ ReadExactly(
+                    token, _header, LZ4FrameHeader.FlagsLength,
+                    length - LZ4FrameHeader.FlagsLength);
+
+            error = LZ4FrameHeader.Decode(_header, out var descriptor);
+            if (error is not null)
+                throw Corrupted(error);
+
+            descriptor.AssertIsNotNull();
+            _descriptor = descriptor;
+            _frame++;
+            EnsureBuffer(descriptor.BlockSize);
+
+            return true;
+        }
+    }
+}
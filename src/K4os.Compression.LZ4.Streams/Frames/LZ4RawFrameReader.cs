@@ -0,0 +1,121 @@
+using System.Buffers.Binary;
+using System.Runtime.CompilerServices;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Internal;
+
+namespace K4os.Compression.LZ4.Streams.Frames;
+
+/// <summary>
+/// Reads LZ4 frames block by block without decoding them. Every block is returned as
+/// it is stored in the stream (see <see cref="LZ4RawBlock"/>), so it can be inspected,
+/// filtered or forwarded (see <c>LZ4FrameWriter.WriteRawBlock</c>) without paying for
+/// decompression. Frame header checksums are verified, block checksums are returned
+/// (but not verified), content checksums are skipped. Skippable frames are ignored.
+/// </summary>
+public partial class LZ4RawFrameReader: IDisposable
+{
+    private readonly Stream _stream;
+    private readonly bool _leaveOpen;
+    private readonly byte[] _header = new byte[LZ4FrameHeader.MaxLength];
+
+    private byte[] _buffer = Mem.Empty;
+    private LZ4Descriptor? _descriptor;
+    private long _frame = -1;
+    private long _bytesRead;
+
+    /// <summary>Creates new instance of <see cref="LZ4RawFrameReader"/>.</summary>
+    /// <param name="stream">Stream containing LZ4 frames.</param>
+    /// <param name="leaveOpen">Indicates if stream should stay open after disposing reader.</param>
+    public LZ4RawFrameReader(Stream stream, bool leaveOpen = false)
+    {
+        _stream = stream;
+        _leaveOpen = leaveOpen;
+    }
+
+    /// <summary>Descriptor of current frame (<c>null</c> between frames).</summary>
+    public ILZ4Descriptor? Descriptor => _descriptor;
+
+    /// <summary>Returns how many bytes has been read from stream so far.</summary>
+    /// <returns>Number of bytes read.</returns>
+    public long GetBytesRead() => _bytesRead;
+
+    /// <summary>Reads next block (from current or following frame).</summary>
+    /// <returns>Next block, or <c>null</c> if end of stream has been reached.</returns>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public LZ4RawBlock? ReadBlock() => ReadBlock(EmptyToken.Value);
+
+    /// <summary>Reads next block (from current or following frame).</summary>
+    /// <param name="token">Cancellation token.</param>
+    /// <returns>Next block, or <c>null</c> if end of stream has been reached.</returns>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public Task<LZ4RawBlock?> ReadBlockAsync(CancellationToken token = default) =>
+        ReadBlock(token);
+
+    private uint Peek4() => BinaryPrimitives.ReadUInt32LittleEndian(_header);
+
+    private void EnsureBuffer(int blockSize)
+    {
+        if (_buffer.Length >= blockSize) return;
+
+        BufferPool.Free(_buffer);
+        _buffer = BufferPool.Alloc(blockSize);
+    }
+
+    // ReSharper disable once UnusedParameter.Local
+    private bool TryReadExactly(EmptyToken _, byte[] buffer, int offset, int length)
+    {
+        var read = 0;
+        while (read < length)
+        {
+            var chunk = _stream.Read(buffer, offset + read, length - read);
+            if (chunk <= 0) break;
+
+            read += chunk;
+        }
+
+        return Loaded(read, length);
+    }
+
+    private async ValueTask<bool> TryReadExactly(
+        CancellationToken token, byte[] buffer, int offset, int length)
+    {
+        var read = 0;
+        while (read < length)
+        {
+            var chunk = await _stream
+                .ReadAsync(buffer, offset + read, length - read, token)
+                .Weave();
+            if (chunk <= 0) break;
+
+            read += chunk;
+        }
+
+        return Loaded(read, length);
+    }
+
+    private bool Loaded(int read, int length)
+    {
+        _bytesRead += read;
+        return read == length || (read == 0 ? false : throw UnexpectedEndOfStream());
+    }
+
+    private static InvalidDataException UnexpectedEndOfStream() =>
+        Corrupted("Unexpected end of stream");
+
+    private static InvalidDataException Corrupted(string message) =>
+        new($"LZ4 frame is corrupted: {message}");
+
+    /// <summary>Disposes the reader and releases all resources.</summary>
+    /// <param name="disposing"><c>true</c> if called by user; <c>false</c> when called by garbage collector.</param>
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposing) return;
+
+        BufferPool.Free(_buffer);
+        _buffer = Mem.Empty;
+        if (!_leaveOpen) _stream.Dispose();
+    }
+
+    /// <inheritdoc />
+    public void Dispose() => Dispose(true);
+}
@@ -34,6 +34,33 @@ internal static class Extensions
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public static Span<byte> ToSpan(this Memory<byte> span) => span.Span;
 
+    /// <summary>
+    /// Waits for task to complete (without observing its result). Token cancels waiting only,
+    /// not the task itself, so it can be used for tasks which outlive the call waiting for them.
+    /// </summary>
+    /// <param name="task">Task to wait for.</param>
+    /// <param name="token">Cancellation token.</param>
+    /// <returns>Task completed when <paramref name="task"/> is completed.</returns>
+    public static async ValueTask WhenCompleted(this Task task, CancellationToken token)
+    {
+        if (task.IsCompleted)
+            return;
+
+        if (!token.CanBeCanceled)
+        {
+            await Task.WhenAny(task).Weave();
+            return;
+        }
+
+        var cancelled = new TaskCompletionSource<bool>(
+            TaskCreationOptions.RunContinuationsAsynchronously);
+        using (token.Register(() => cancelled.TrySetResult(true)))
+            await Task.WhenAny(task, cancelled.Task).Weave();
+
+        if (!task.IsCompleted)
+            token.ThrowIfCancellationRequested();
+    }
+
     /// <summary>
     /// Asserts that given argument is not null. As it is designed to be used only in
     /// situations when we 100% ure that value is not null, it actually does anything
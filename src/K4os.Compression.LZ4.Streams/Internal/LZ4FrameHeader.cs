@@ -0,0 +1,98 @@
+using System.Buffers.Binary;
+using System.Diagnostics.CodeAnalysis;
+using K4os.Compression.LZ4.Internal;
+using K4os.Hash.xxHash;
+
+namespace K4os.Compression.LZ4.Streams.Internal;
+
+/// <summary>
+/// Frame magic numbers and frame descriptor parsing, shared by readers which parse
+/// frame headers from buffers (raw frame reader and frame verifier).
+/// Parsing methods return error message (or <c>null</c>) instead of throwing,
+/// so every reader can report it its own way.
+/// </summary>
+[SuppressMessage("ReSharper", "InconsistentNaming")]
+internal static class LZ4FrameHeader
+{
+    public const uint FrameMagic = 0x184D2204;
+    public const uint SkippableMagic = 0x184D2A50;
+    private const uint SkippableMask = 0xFFFFFFF0;
+
+    /// <summary>Length of FLG and BD bytes (they tell how long the rest is).</summary>
+    public const int FlagsLength = 2;
+
+    /// <summary>Maximum length of frame descriptor, including header checksum.</summary>
+    public const int MaxLength = FlagsLength + sizeof(long) + sizeof(uint) + 1;
+
+    /// <summary>Checks if magic number denotes skippable frame.</summary>
+    public static bool IsSkippable(uint magic) => (magic & SkippableMask) == SkippableMagic;
+
+    /// <summary>Checks FLG and BD bytes (first two bytes of <paramref name="header"/>).</summary>
+    /// <returns>Error message, or <c>null</c> if they are valid.</returns>
+    public static string? CheckFlags(byte[] header)
+    {
+        var FLG = header[0];
+        var BD = header[1];
+
+        if (FLG >> 6 != 1)
+            return $"LZ4 frame version {FLG >> 6} is not supported";
+
+        var blockSizeCode = (BD >> 4) & 0x07;
+        if (blockSizeCode < 4)
+            return $"Invalid block size code {blockSizeCode}";
+
+        return null;
+    }
+
+    /// <summary>Length of frame descriptor (excluding header checksum which follows it)
+    /// starting with given FLG byte.</summary>
+    public static int DescriptorLength(byte FLG)
+    {
+        var hasContentSize = ((FLG >> 3) & 0x01) != 0;
+        var hasDictionary = (FLG & 0x01) != 0;
+        return FlagsLength +
+            (hasContentSize ? sizeof(long) : 0) +
+            (hasDictionary ? sizeof(uint) : 0);
+    }
+
+    /// <summary>Decodes frame descriptor, already checked with <see cref="CheckFlags"/>,
+    /// followed by header checksum.</summary>
+    /// <param name="header">Descriptor and header checksum.</param>
+    /// <param name="descriptor">Decoded descriptor.</param>
+    /// <returns>Error message, or <c>null</c> if descriptor is valid.</returns>
+    public static string? Decode(byte[] header, out LZ4Descriptor? descriptor)
+    {
+        var FLG = header[0];
+        var BD = header[1];
+        descriptor = null;
+
+        var chaining = ((FLG >> 5) & 0x01) == 0;
+        var blockChecksum = ((FLG >> 4) & 0x01) != 0;
+        var hasContentSize = ((FLG >> 3) & 0x01) != 0;
+        var contentChecksum = ((FLG >> 2) & 0x01) != 0;
+        var hasDictionary = (FLG & 0x01) != 0;
+        var descriptorLength = DescriptorLength(FLG);
+
+        var expectedHC = (byte)(XXH32.DigestOf(header, 0, descriptorLength) >> 8);
+        if (header[descriptorLength] != expectedHC)
+            return "Invalid frame header checksum";
+
+        var contentLength = hasContentSize
+            ? (long?)BinaryPrimitives.ReadInt64LittleEndian(header.AsSpan(FlagsLength))
+            : null;
+        var dictionaryId = hasDictionary
+            ? (uint?)BinaryPrimitives.ReadUInt32LittleEndian(
+                header.AsSpan(FlagsLength + (hasContentSize ? sizeof(long) : 0)))
+            : null;
+        var blockSize = ((BD >> 4) & 0x07) switch {
+            7 => Mem.M4,
+            6 => Mem.M1,
+            5 => Mem.K256,
+            _ => Mem.K64,
+        };
+
+        descriptor = new LZ4Descriptor(
+            contentLength, contentChecksum, chaining, blockChecksum, dictionaryId, blockSize);
+        return null;
+    }
+}
@@ -27,18 +27,17 @@ internal static class ReaderExtensions
         return progress;
     }
 
-    public static async Task<ReadResult<TStreamState>>
-        TryReadBlockAsync<TStreamReader, TStreamState>(
-            this TStreamReader stream, TStreamState state,
+    public static async ValueTask<ReadResult<TStreamState>>
+        TryReadBlockAsync<TStreamState>(
+            this IStreamValueReader<TStreamState> stream, TStreamState state,
             byte[] buffer, int offset, int count, bool optional,
             CancellationToken token)
-        where TStreamReader: IStreamReader<TStreamState>
     {
         var progress = 0;
         while (count > 0)
         {
             (state, var read) = await stream
-                .ReadAsync(state, buffer, offset + progress, count, token)
+                .ReadValueAsync(state, buffer, offset + progress, count, token)
                 .Weave();
 
             if (read == 0)
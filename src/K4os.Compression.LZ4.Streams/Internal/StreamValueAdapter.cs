@@ -0,0 +1,80 @@
+using K4os.Compression.LZ4.Streams.Abstractions;
+
+namespace K4os.Compression.LZ4.Streams.Internal;
+
+/// <summary>
+/// Exposes any stream reader/writer as <see cref="IStreamValueReader{TStreamState}"/>
+/// and <see cref="IStreamValueWriter{TStreamState}"/>. Adapters implementing these
+/// interfaces are used directly (boxed once, if they are structs), other ones get wrapped
+/// and their <see cref="Task{TResult}"/> based methods are used.
+/// </summary>
+internal static class StreamValueAdapter
+{
+    public static IStreamValueReader<TStreamState> AsValueReader<TStreamReader, TStreamState>(
+        TStreamReader reader)
+        where TStreamReader: IStreamReader<TStreamState> =>
+        reader as IStreamValueReader<TStreamState> ??
+        new TaskReader<TStreamReader, TStreamState>(reader);
+
+    public static IStreamValueWriter<TStreamState> AsValueWriter<TStreamWriter, TStreamState>(
+        TStreamWriter writer)
+        where TStreamWriter: IStreamWriter<TStreamState> =>
+        writer as IStreamValueWriter<TStreamState> ??
+        new TaskWriter<TStreamWriter, TStreamState>(writer);
+
+    private sealed class TaskReader<TStreamReader, TStreamState>:
+        IStreamValueReader<TStreamState>
+        where TStreamReader: IStreamReader<TStreamState>
+    {
+        private readonly TStreamReader _reader;
+
+        public TaskReader(TStreamReader reader) => _reader = reader;
+
+        public int Read(ref TStreamState state, byte[] buffer, int offset, int length) =>
+            _reader.Read(ref state, buffer, offset, length);
+
+        public Task<ReadResult<TStreamState>> ReadAsync(
+            TStreamState state, byte[] buffer, int offset, int length,
+            CancellationToken token) =>
+            _reader.ReadAsync(state, buffer, offset, length, token);
+
+        public ValueTask<ReadResult<TStreamState>> ReadValueAsync(
+            TStreamState state, byte[] buffer, int offset, int length,
+            CancellationToken token) =>
+            new(_reader.ReadAsync(state, buffer, offset, length, token));
+    }
+
+    private sealed class TaskWriter<TStreamWriter, TStreamState>:
+        IStreamValueWriter<TStreamState>
+        where TStreamWriter: IStreamWriter<TStreamState>
+    {
+        private readonly TStreamWriter _writer;
+
+        public TaskWriter(TStreamWriter writer) => _writer = writer;
+
+        public bool CanFlush => _writer.CanFlush;
+
+        public void Write(ref TStreamState state, byte[] buffer, int offset, int length) =>
+            _writer.Write(ref state, buffer, offset, length);
+
+        public Task<TStreamState> WriteAsync(
+            TStreamState state, byte[] buffer, int offset, int length,
+            CancellationToken token) =>
+            _writer.WriteAsync(state, buffer, offset, length, token);
+
+        public ValueTask<TStreamState> WriteValueAsync(
+            TStreamState state, byte[] buffer, int offset, int length,
+            CancellationToken token) =>
+            new(_writer.WriteAsync(state, buffer, offset, length, token));
+
+        public void Flush(ref TStreamState state) =>
+            _writer.Flush(ref state);
+
+        public Task<TStreamState> FlushAsync(TStreamState state, CancellationToken token) =>
+            _writer.FlushAsync(state, token);
+
+        public ValueTask<TStreamState> FlushValueAsync(
+            TStreamState state, CancellationToken token) =>
+            new(_writer.FlushAsync(state, token));
+    }
+}
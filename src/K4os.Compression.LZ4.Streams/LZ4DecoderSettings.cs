@@ -9,4 +9,11 @@ public class LZ4DecoderSettings
 
     /// <summary>Extra memory for decompression.</summary>
     public int ExtraMemory { get; set; }
+
+    /// <summary>
+    /// Number of compressed blocks to be read ahead from inner stream while current block
+    /// is being consumed (asynchronous reads only). It helps with high-latency sources at
+    /// the cost of one extra buffer per block. Default is <c>0</c> (no read-ahead).
+    /// </summary>
+    public int ReadAhead { get; set; }
 }
@@ -31,6 +31,17 @@ public class LZ4DecoderStream: LZ4StreamOnStreamEssentials
         _interactive = interactive;
     }
 
+    /// <summary>
+    /// Number of compressed blocks to be read ahead from inner stream while current block
+    /// is being consumed (asynchronous reads only).
+    /// See <see cref="LZ4FrameReader{TStreamReader,TStreamState}.ReadAhead"/>.
+    /// </summary>
+    public int ReadAhead
+    {
+        get => _reader.ReadAhead;
+        set => _reader.ReadAhead = value;
+    }
+
     /// <inheritdoc />
     public override int ReadByte() =>
         _reader.ReadOneByte();
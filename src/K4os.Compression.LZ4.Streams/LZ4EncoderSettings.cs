@@ -42,6 +42,38 @@ public class LZ4EncoderSettings
     /// <summary>Compression level.</summary>
     public LZ4Level CompressionLevel { get; set; } = LZ4Level.L00_FAST;
 
+    /// <summary>
+    /// Advanced compression parameters (search depth, target length, hash table size, etc.).
+    /// When set, they take precedence over <see cref="CompressionLevel"/>.
+    /// </summary>
+    public LZ4CompressionParameters? CompressionParameters { get; set; }
+
+    /// <summary>
+    /// Adaptive compression level. When set, level is chosen per block (starting with
+    /// <see cref="CompressionLevel"/>) from observed compression speed and ratio, so frame
+    /// writer meets throughput or CPU share target, or follows speed of inner stream
+    /// (see <see cref="LZ4AdaptiveParameters"/>). Backpressure works best combined with
+    /// <see cref="MaxPendingWrites"/>. <see cref="CompressionParameters"/> are ignored
+    /// in this mode.
+    /// </summary>
+    public LZ4AdaptiveParameters? AdaptiveLevel { get; set; }
+
     /// <summary>Extra memory (for the process, more is usually better).</summary>
     public int ExtraMemory { get; set; }
+
+    /// <summary>
+    /// Maximum number of compressed blocks which can be waiting to be written while next
+    /// block is being compressed (asynchronous writes only). Higher values allow compression
+    /// to overlap with slow I/O at the cost of one extra buffer per pending block.
+    /// Default is <c>0</c> (no pipelining).
+    /// </summary>
+    public int MaxPendingWrites { get; set; }
+
+    /// <summary>
+    /// Indicates if <see cref="Stream.Flush"/> on encoder stream should compress and write
+    /// data buffered so far as a (partial) block, so it can be decoded by the reader
+    /// straight away (useful for interactive protocols). When <c>false</c> (default) flush
+    /// only flushes inner stream and data is written when block is full or frame is closed.
+    /// </summary>
+    public bool FlushBlocks { get; set; }
 }
@@ -28,6 +28,37 @@ public class LZ4EncoderStream: LZ4StreamOnStreamEssentials
         _writer = new StreamLZ4FrameWriter(inner, true, encoderFactory, descriptor);
     }
 
+    /// <summary>
+    /// Maximum number of compressed blocks which can be waiting to be written to inner
+    /// stream while next block is being compressed (asynchronous writes only).
+    /// See <see cref="LZ4FrameWriter{TStreamWriter,TStreamState}.MaxPendingWrites"/>.
+    /// </summary>
+    public int MaxPendingWrites
+    {
+        get => _writer.MaxPendingWrites;
+        set => _writer.MaxPendingWrites = value;
+    }
+
+    /// <summary>
+    /// Indicates if <see cref="Flush"/> writes data buffered so far as a (partial) block.
+    /// See <see cref="LZ4FrameWriter{TStreamWriter,TStreamState}.FlushBlock()"/>.
+    /// </summary>
+    public bool FlushBlocks { get; set; }
+
+    /// <inheritdoc />
+    public override void Flush()
+    {
+        if (FlushBlocks) _writer.FlushBlock();
+        base.Flush();
+    }
+
+    /// <inheritdoc />
+    public override async Task FlushAsync(CancellationToken token)
+    {
+        if (FlushBlocks) await _writer.FlushBlockAsync(token).Weave();
+        await base.FlushAsync(token).Weave();
+    }
+
     /// <inheritdoc />
     protected override void Dispose(bool disposing)
     {
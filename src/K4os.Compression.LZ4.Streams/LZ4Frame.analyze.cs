@@ -0,0 +1,56 @@
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Frames;
+
+namespace K4os.Compression.LZ4.Streams;
+
+public static partial class LZ4Frame
+{
+    /// <summary>
+    /// Walks all frames in given stream, without decompressing them, and collects statistics
+    /// of compressed blocks (see <see cref="LZ4Analyzer"/>). Skippable frames are ignored.
+    /// Note, block and content checksums are not verified.
+    /// </summary>
+    /// <param name="stream">Stream containing LZ4 frames.</param>
+    /// <param name="stats">Statistics to add to (new one is created when <c>null</c>).</param>
+    /// <returns>Statistics.</returns>
+    /// <exception cref="InvalidDataException">Thrown when stream is corrupted.</exception>
+    public static LZ4BlockStats Analyze(Stream stream, LZ4BlockStats? stats = null)
+    {
+        stats ??= new LZ4BlockStats();
+        using var reader = new LZ4RawFrameReader(stream, true);
+
+        var frame = -1L;
+        var history = 0;
+
+        while (reader.ReadBlock() is { } block)
+        {
+            var descriptor = block.Descriptor;
+            if (block.Frame != frame)
+            {
+                frame = block.Frame;
+                // predefined dictionary is unknown, so its full size is assumed
+                history = descriptor.Dictionary.HasValue ? Mem.K64 : 0;
+            }
+
+            var before = stats.DecodedBytes;
+            if (block.Compressed)
+            {
+                LZ4Analyzer.Block(block.Data.Span, stats, descriptor.Chaining ? history : 0);
+            }
+            else
+            {
+                LZ4Analyzer.Stored(block.Data.Length, stats);
+            }
+
+            var decoded = (int)(stats.DecodedBytes - before);
+            if (decoded > descriptor.BlockSize)
+                throw new InvalidDataException(
+                    $"LZ4 frame is corrupted: Block decodes to {decoded} bytes, " +
+                    $"exceeding maximum {descriptor.BlockSize}");
+
+            history = Math.Min(Mem.K64, history + decoded);
+        }
+
+        return stats;
+    }
+}
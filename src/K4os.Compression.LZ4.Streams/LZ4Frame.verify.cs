@@ -0,0 +1,347 @@
+using System.Buffers.Binary;
+using K4os.Compression.LZ4.Encoders;
+using K4os.Compression.LZ4.Internal;
+using K4os.Compression.LZ4.Streams.Internal;
+using K4os.Hash.xxHash;
+
+namespace K4os.Compression.LZ4.Streams;
+
+public static partial class LZ4Frame
+{
+    /// <summary>
+    /// Verifies all frames in given stream without producing any output: header checksums,
+    /// block checksums, content checksums, content sizes and whether every block can actually
+    /// be decoded (into scratch buffers, which are reused). Block checksums (and decoding of
+    /// independent blocks) are calculated in parallel, one batch of blocks at a time.
+    /// Verification stops at first problem, reporting its offset in the stream.
+    /// </summary>
+    /// <param name="stream">Stream containing LZ4 frames.</param>
+    /// <param name="maxDegreeOfParallelism">Number of blocks verified at the same time,
+    /// (every one of them needs up to two block-sized buffers); <c>0</c> means number of
+    /// processors.</param>
+    /// <returns>Verification result.</returns>
+    public static LZ4VerifyResult Verify(Stream stream, int maxDegreeOfParallelism = 0)
+    {
+        if (maxDegreeOfParallelism <= 0)
+            maxDegreeOfParallelism = Environment.ProcessorCount;
+
+        using var verifier = new FrameVerifier(stream, maxDegreeOfParallelism);
+        return verifier.Verify();
+    }
+
+    private sealed class FrameVerifier: IDisposable
+    {
+        private sealed class CorruptedFrame: Exception
+        {
+            public long Offset { get; }
+
+            public CorruptedFrame(long offset, string message): base(message) =>
+                Offset = offset;
+        }
+
+        private sealed class Block
+        {
+            public byte[] Buffer = Mem.Empty;
+            public ILZ4Decoder? Output;
+            public long Offset;
+            public int Length;
+            public bool Stored;
+            public uint? Checksum;
+            public int Decoded;
+            public string? Error;
+        }
+
+        private readonly Stream _stream;
+        private readonly Block[] _batch;
+        private readonly byte[] _header = new byte[LZ4FrameHeader.MaxLength];
+        private readonly LZ4VerifyResult _result = new();
+        private ILZ4Decoder? _decoder;
+
+        public FrameVerifier(Stream stream, int parallelism)
+        {
+            _stream = stream;
+            _batch = new Block[parallelism];
+            for (var i = 0; i < parallelism; i++) _batch[i] = new Block();
+        }
+
+        public LZ4VerifyResult Verify()
+        {
+            try
+            {
+                while (TryRead(_header, sizeof(uint)))
+                {
+                    _result.Frames++;
+                    var offset = _result.BytesRead - sizeof(uint);
+                    var magic = BinaryPrimitives.ReadUInt32LittleEndian(_header);
+                    if (LZ4FrameHeader.IsSkippable(magic))
+                    {
+                        Read(_header, sizeof(uint), offset);
+                        Skip(BinaryPrimitives.ReadUInt32LittleEndian(_header), offset);
+                        continue;
+                    }
+
+                    if (magic != LZ4FrameHeader.FrameMagic)
+                        throw new CorruptedFrame(offset, "LZ4 frame magic number expected");
+
+                    VerifyFrame(offset);
+                }
+            }
+            catch (CorruptedFrame e)
+            {
+                _result.Error = e.Message;
+                _result.ErrorOffset = e.Offset;
+            }
+
+            return _result;
+        }
+
+        private void VerifyFrame(long frameOffset)
+        {
+            Read(_header, LZ4FrameHeader.FlagsLength, frameOffset);
+            var error = LZ4FrameHeader.CheckFlags(_header);
+            if (error is not null)
+                throw new CorruptedFrame(frameOffset, error);
+
+            var length = LZ4FrameHeader.DescriptorLength(_header[0]) + 1;
+            Read(
+                _header, length - LZ4FrameHeader.FlagsLength, frameOffset,
+                LZ4FrameHeader.FlagsLength);
+            error = LZ4FrameHeader.Decode(_header, out var descriptor);
+            if (error is not null)
+                throw new CorruptedFrame(frameOffset, error);
+
+            descriptor.AssertIsNotNull();
+            if (descriptor.Dictionary.HasValue)
+                throw new CorruptedFrame(
+                    frameOffset, "Predefined dictionaries feature is not implemented");
+
+            var chaining = descriptor.Chaining;
+            var blockChecksum = descriptor.BlockChecksum;
+            var contentChecksum = descriptor.ContentChecksum;
+            var contentSize = descriptor.ContentLength;
+            var blockSize = descriptor.BlockSize;
+
+            var content = new XXH32.State();
+            XXH32.Reset(ref content);
+            var decoded = 0L;
+
+            try
+            {
+                Allocate(blockSize, !chaining);
+                if (chaining) _decoder = LZ4Decoder.Create(true, blockSize);
+
+                while (true)
+                {
+                    var count = ReadBatch(blockSize, blockChecksum, out var finished);
+                    VerifyBatch(count, chaining, blockSize);
+
+                    for (var i = 0; i < count; i++)
+                    {
+                        var block = _batch[i];
+                        var output = DecodeBlock(block);
+                        if (contentChecksum) XXH32.Update(ref content, output);
+                        decoded += output.Length;
+                        _result.Blocks++;
+                    }
+
+                    if (finished) break;
+                }
+            }
+            finally
+            {
+                _decoder?.Dispose();
+                _decoder = null;
+            }
+
+            _result.BytesDecoded += decoded;
+
+            if (contentChecksum)
+            {
+                var offset = _result.BytesRead;
+                Read(_header, sizeof(uint), offset);
+                var expected = BinaryPrimitives.ReadUInt32LittleEndian(_header);
+                if (XXH32.Digest(in content) != expected)
+                    throw new CorruptedFrame(offset, "Invalid content checksum");
+            }
+
+            if (contentSize.HasValue && contentSize.Value != decoded)
+                throw new CorruptedFrame(
+                    frameOffset,
+                    $"Frame declares {contentSize.Value} bytes but {decoded} were decoded");
+        }
+
+        private int ReadBatch(int blockSize, bool blockChecksum, out bool finished)
+        {
+            var count = 0;
+            finished = false;
+
+            while (count < _batch.Length)
+            {
+                var offset = _result.BytesRead;
+                Read(_header, sizeof(uint), offset);
+                var blockLength = BinaryPrimitives.ReadUInt32LittleEndian(_header);
+                if (blockLength == 0)
+                {
+                    finished = true;
+                    break;
+                }
+
+                var block = _batch[count++];
+                block.Offset = offset;
+                block.Stored = (blockLength & 0x80000000) != 0;
+                block.Length = (int)(blockLength & 0x7FFFFFFF);
+                block.Error = null;
+
+                if (block.Length > blockSize)
+                    throw new CorruptedFrame(
+                        offset, $"Block length {block.Length} exceeds maximum {blockSize}");
+
+                Read(block.Buffer, block.Length, offset);
+
+                if (blockChecksum)
+                {
+                    Read(_header, sizeof(uint), offset);
+                    block.Checksum = BinaryPrimitives.ReadUInt32LittleEndian(_header);
+                }
+                else
+                {
+                    block.Checksum = null;
+                }
+            }
+
+            return count;
+        }
+
+        private void VerifyBatch(int count, bool chaining, int blockSize)
+        {
+            if (count <= 1)
+            {
+                for (var i = 0; i < count; i++) VerifyBlock(_batch[i], chaining, blockSize);
+                return;
+            }
+
+            Parallel.For(0, count, i => VerifyBlock(_batch[i], chaining, blockSize));
+        }
+
+        private static unsafe void VerifyBlock(Block block, bool chaining, int blockSize)
+        {
+            if (block.Checksum.HasValue &&
+                XXH32.DigestOf(block.Buffer, 0, block.Length) != block.Checksum.Value)
+            {
+                block.Error = "Invalid block checksum";
+                return;
+            }
+
+            // chained blocks depend on each other, so they can be decoded only sequentially
+            if (chaining || block.Stored)
+                return;
+
+            // block decoder (like one used by frame reader) is not reported as codec traffic
+            try
+            {
+                fixed (byte* source = block.Buffer)
+                    block.Decoded = block.Output!.Decode(source, block.Length);
+                if (block.Decoded > blockSize)
+                    block.Error = "Block cannot be decoded";
+            }
+            catch (InvalidOperationException)
+            {
+                block.Error = "Block cannot be decoded";
+            }
+        }
+
+        private unsafe ReadOnlySpan<byte> DecodeBlock(Block block)
+        {
+            if (block.Error is not null)
+                throw new CorruptedFrame(block.Offset, block.Error);
+
+            if (_decoder is null)
+                return block.Stored
+                    ? block.Buffer.AsSpan(0, block.Length)
+                    : new ReadOnlySpan<byte>(block.Output!.Peek(-block.Decoded), block.Decoded);
+
+            int decoded;
+            try
+            {
+                fixed (byte* source = block.Buffer)
+                {
+                    decoded = block.Stored
+                        ? _decoder.Inject(source, block.Length)
+                        : _decoder.Decode(source, block.Length);
+                }
+            }
+            catch (InvalidOperationException)
+            {
+                throw new CorruptedFrame(block.Offset, "Block cannot be decoded");
+            }
+
+            return new ReadOnlySpan<byte>(_decoder.Peek(-decoded), decoded);
+        }
+
+        private void Allocate(int blockSize, bool output)
+        {
+            foreach (var block in _batch)
+            {
+                if (block.Buffer.Length < blockSize)
+                {
+                    BufferPool.Free(block.Buffer);
+                    block.Buffer = BufferPool.Alloc(blockSize);
+                }
+
+                if (output && (block.Output is null || block.Output.BlockSize < blockSize))
+                {
+                    block.Output?.Dispose();
+                    block.Output = LZ4Decoder.Create(false, blockSize);
+                }
+            }
+        }
+
+        private bool TryRead(byte[] buffer, int length, int index = 0)
+        {
+            var read = 0;
+            while (read < length)
+            {
+                var chunk = _stream.Read(buffer, index + read, length - read);
+                if (chunk <= 0) break;
+
+                read += chunk;
+                _result.BytesRead += chunk;
+            }
+
+            return read == 0
+                ? length == 0
+                : read == length
+                    ? true
+                    : throw new CorruptedFrame(_result.BytesRead, "Unexpected end of stream");
+        }
+
+        private void Read(byte[] buffer, int length, long offset, int index = 0)
+        {
+            if (length > 0 && !TryRead(buffer, length, index))
+                throw new CorruptedFrame(offset, "Unexpected end of stream");
+        }
+
+        private void Skip(long length, long offset)
+        {
+            var buffer = new byte[Math.Min(length, Mem.K4)];
+            while (length > 0)
+            {
+                var chunk = (int)Math.Min(length, buffer.Length);
+                Read(buffer, chunk, offset);
+                length -= chunk;
+            }
+        }
+
+        public void Dispose()
+        {
+            _decoder?.Dispose();
+            foreach (var block in _batch)
+            {
+                BufferPool.Free(block.Buffer);
+                block.Output?.Dispose();
+                block.Buffer = Mem.Empty;
+                block.Output = null;
+            }
+        }
+    }
+}
@@ -17,7 +17,10 @@ public static class LZ4Stream
     {
         settings ??= LZ4EncoderSettings.Default;
         var frameInfo = settings.CreateDescriptor();
-        return new LZ4EncoderStream(stream, frameInfo, i => i.CreateEncoder(settings), leaveOpen);
+        return new LZ4EncoderStream(stream, frameInfo, i => i.CreateEncoder(settings), leaveOpen) {
+            MaxPendingWrites = settings.MaxPendingWrites,
+            FlushBlocks = settings.FlushBlocks,
+        };
     }
 
     /// <summary>Created compression stream on top of inner stream.</summary>
@@ -54,7 +57,9 @@ public static class LZ4Stream
     {
         settings ??= LZ4DecoderSettings.Default;
         return new LZ4DecoderStream(
-            stream, i => i.CreateDecoder(settings), leaveOpen, interactive);
+            stream, i => i.CreateDecoder(settings), leaveOpen, interactive) {
+            ReadAhead = settings.ReadAhead,
+        };
     }
 
     /// <summary>Creates decompression stream on top of inner stream.</summary>
@@ -0,0 +1,37 @@
+namespace K4os.Compression.LZ4.Streams;
+
+/// <summary>
+/// Result of frame verification (see <see cref="LZ4Frame.Verify"/>).
+/// </summary>
+public class LZ4VerifyResult
+{
+    /// <summary>Indicates if all frames are valid.</summary>
+    public bool Valid => Error is null;
+
+    /// <summary>Description of first problem found, or <c>null</c> if stream is valid.</summary>
+    public string? Error { get; internal set; }
+
+    /// <summary>
+    /// Offset (in verified stream) of frame header or block where first problem was
+    /// found, or <c>null</c> if stream is valid.
+    /// </summary>
+    public long? ErrorOffset { get; internal set; }
+
+    /// <summary>Number of frames verified (including skippable ones).</summary>
+    public long Frames { get; internal set; }
+
+    /// <summary>Number of blocks verified.</summary>
+    public long Blocks { get; internal set; }
+
+    /// <summary>Number of bytes read from verified stream.</summary>
+    public long BytesRead { get; internal set; }
+
+    /// <summary>Number of bytes decoded.</summary>
+    public long BytesDecoded { get; internal set; }
+
+    /// <inheritdoc />
+    public override string ToString() =>
+        Valid
+            ? $"Valid: {Frames} frame(s), {Blocks} block(s), {BytesRead} -> {BytesDecoded} bytes"
+            : $"Invalid at {ErrorOffset}: {Error}";
+}
@@ -0,0 +1,254 @@
+using System.Text;
+using K4os.Compression.LZ4.Encoders;
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+
+namespace K4os.Compression.LZ4.Tests;
+
+public class AdaptiveLevelTests
+{
+	private static readonly LZ4Level[] Levels = {
+		LZ4Level.L00_FAST, LZ4Level.L02_MID, LZ4Level.L09_HC, LZ4Level.L11_OPT,
+		LZ4Level.L02_MID, LZ4Level.L00_FAST, LZ4Level.L03_HC, LZ4Level.L12_MAX,
+		LZ4Level.L09_HC, LZ4Level.L13_ULTRA, LZ4Level.L10_OPT, LZ4Level.L00_FAST,
+		LZ4Level.L00_FAST, LZ4Level.L09_HC, LZ4Level.L02_MID, LZ4Level.L11_OPT,
+	};
+
+	private static byte[] Words(int length, int seed = 0)
+	{
+		var words = Lorem.Text.Split(' ');
+		var random = new Random(seed);
+		var text = new StringBuilder();
+		while (text.Length < length)
+			text.Append(words[random.Next(words.Length)]).Append(' ');
+		return Encoding.ASCII.GetBytes(text.ToString(0, length));
+	}
+
+	private static byte[] Noise(int length, int seed = 0)
+	{
+		var buffer = new byte[length];
+		new Random(seed).NextBytes(buffer);
+		return buffer;
+	}
+
+	private static LZ4AdaptiveParameters Throughput(double target) =>
+		new() { MinLevel = LZ4Level.L00_FAST, MaxLevel = LZ4Level.L09_HC, TargetThroughput = target };
+
+	[Theory]
+	[InlineData(0, false)]
+	[InlineData(0, true)]
+	[InlineData(3, false)]
+	public void LevelCanBeChangedBetweenChainedBlocks(int extraBlocks, bool enforce32)
+	{
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			const int blockSize = Mem.K32;
+			// every block repeats previous one, so it compresses well only if history is kept
+			// (hex digits do not compress on their own, but do not look incompressible either)
+			var hex = Encoding.ASCII.GetBytes(
+				string.Concat(Noise(blockSize / 2).Select(b => b.ToString("x2"))));
+
+			using var encoder = new LZ4AdaptiveEncoder(true, Levels[0], blockSize, extraBlocks);
+			using var decoder = LZ4Decoder.Create(true, blockSize);
+
+			var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+			var decoded = new byte[blockSize];
+
+			for (var i = 0; i < Levels.Length; i++)
+			{
+				encoder.Level = Levels[i];
+				var action = encoder.TopupAndEncode(
+					hex, target, true, true, out _, out var encoded);
+
+				if (action == EncoderAction.Copied)
+				{
+					decoder.Inject(target, 0, encoded);
+					decoder.Drain(decoded, -encoded, encoded);
+				}
+				else
+				{
+					decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out _);
+				}
+
+				Assert.Equal(hex, decoded);
+				if (i > 0)
+				{
+					Assert.Equal(EncoderAction.Encoded, action);
+					Assert.True(encoded < blockSize / 100, $"{Levels[i]}: {encoded}");
+				}
+			}
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+	}
+
+	[Fact]
+	public void LevelCanBeChangedWithinBlocksReferencingEachOther()
+	{
+		const int blockSize = Mem.K16;
+		var source = Words(Mem.M1);
+
+		using var encoder = new LZ4AdaptiveEncoder(true, LZ4Level.L00_FAST, blockSize);
+		using var decoder = LZ4Decoder.Create(true, blockSize);
+
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+		var decoded = new byte[blockSize];
+
+		for (int offset = 0, i = 0; offset < source.Length; offset += blockSize, i++)
+		{
+			encoder.Level = Levels[i % Levels.Length];
+			var chunk = source.AsSpan(offset, Math.Min(blockSize, source.Length - offset));
+			var action = encoder.TopupAndEncode(
+				chunk, target, true, false, out _, out var encoded);
+			Assert.Equal(EncoderAction.Encoded, action);
+
+			decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out var length);
+			Assert.Equal(chunk.ToArray(), decoded.AsSpan(0, length).ToArray());
+		}
+	}
+
+	[Fact]
+	public void LevelCanBeChangedBetweenIndependentBlocks()
+	{
+		const int blockSize = Mem.K64;
+		var source = Words(blockSize);
+
+		using var encoder = new LZ4AdaptiveEncoder(false, LZ4Level.L00_FAST, blockSize);
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+
+		foreach (var level in Levels)
+		{
+			encoder.Level = level;
+			encoder.TopupAndEncode(source, target, true, false, out _, out var encoded);
+			Assert.Equal(LZ4Codec.Encode(source, new byte[target.Length], level), encoded);
+			var decoded = new byte[blockSize];
+			Assert.Equal(blockSize, LZ4Codec.Decode(target, 0, encoded, decoded, 0, blockSize));
+			Assert.Equal(source, decoded);
+		}
+	}
+
+	[Fact]
+	public void ControllerNeedsTarget()
+	{
+		Assert.Throws<ArgumentException>(
+			() => new LZ4LevelController(new LZ4AdaptiveParameters(), LZ4Level.L00_FAST));
+	}
+
+	[Fact]
+	public void InitialLevelIsClamped()
+	{
+		var parameters = Throughput(1e9);
+		parameters.MinLevel = LZ4Level.L03_HC;
+		Assert.Equal(LZ4Level.L03_HC, new LZ4LevelController(parameters, LZ4Level.L00_FAST).Level);
+		Assert.Equal(LZ4Level.L09_HC, new LZ4LevelController(parameters, LZ4Level.L12_MAX).Level);
+	}
+
+	[Fact]
+	public void ControllerRaisesLevelWhenCompressionIsFastEnough()
+	{
+		// 64KB in 1us is way above 100MB/s target
+		var controller = new LZ4LevelController(Throughput(100e6), LZ4Level.L00_FAST);
+		for (var i = 0; i < 100; i++)
+			controller.Update(Mem.K64, Mem.K16, 1e-6, 1e-6);
+		Assert.Equal(LZ4Level.L09_HC, controller.Level);
+	}
+
+	[Fact]
+	public void ControllerFallsBackToFastestLevelUnderPressure()
+	{
+		var controller = new LZ4LevelController(Throughput(100e6), LZ4Level.L09_HC);
+		// 64KB in 10ms is 6.5MB/s, way below 100MB/s target
+		Assert.Equal(LZ4Level.L00_FAST, controller.Update(Mem.K64, Mem.K16, 0.01, 0.01));
+	}
+
+	[Fact]
+	public void ControllerLowersLevelOneStepWhenSlightlySlow()
+	{
+		var controller = new LZ4LevelController(Throughput(100e6), LZ4Level.L09_HC);
+		// 64KB in 1ms is 65MB/s
+		Assert.Equal(LZ4Level.L08_HC, controller.Update(Mem.K64, Mem.K16, 0.001, 0.001));
+	}
+
+	[Fact]
+	public void ControllerDoesNotGoBackToLevelWhichWasTooSlow()
+	{
+		var controller = new LZ4LevelController(Throughput(100e6), LZ4Level.L02_MID);
+		Assert.Equal(LZ4Level.L02_MID, controller.Update(Mem.K64, Mem.K16, 0.0001, 0.0001));
+		// 0.1ms for 64KB at 100MB/s target is 15% of the budget, so next level is tried
+		Assert.Equal(LZ4Level.L03_HC, controller.Update(Mem.K64, Mem.K16, 0.0001, 0.0001));
+		// ...but it turns out to be too slow
+		Assert.Equal(LZ4Level.L02_MID, controller.Update(Mem.K64, Mem.K16, 0.001, 0.001));
+		for (var i = 0; i < 10; i++)
+			Assert.Equal(LZ4Level.L02_MID, controller.Update(Mem.K64, Mem.K16, 0.0001, 0.0001));
+	}
+
+	[Fact]
+	public void ControllerKeepsCpuShare()
+	{
+		var parameters = new LZ4AdaptiveParameters {
+			MaxLevel = LZ4Level.L12_MAX, TargetCpuShare = 0.5,
+		};
+		var controller = new LZ4LevelController(parameters, LZ4Level.L09_HC);
+		// compression takes 90% of the time
+		Assert.Equal(LZ4Level.L08_HC, controller.Update(Mem.K64, Mem.K16, 0.009, 0.01));
+		// compression takes 10% of the time
+		controller = new LZ4LevelController(parameters, LZ4Level.L09_HC);
+		for (var i = 0; i < 3; i++) controller.Update(Mem.K64, Mem.K16, 0.001, 0.01);
+		Assert.Equal(LZ4Level.L10_OPT, controller.Level);
+	}
+
+	[Fact]
+	public void BackpressureIsEnoughOfTarget()
+	{
+		var parameters = new LZ4AdaptiveParameters { Backpressure = true };
+		Assert.Equal(LZ4Level.L00_FAST, new LZ4LevelController(parameters, LZ4Level.L00_FAST).Level);
+	}
+
+	[Fact]
+	public void BackpressureRaisesLevelWhenWritesAreSlow()
+	{
+		var parameters = new LZ4AdaptiveParameters { Backpressure = true };
+		var controller = new LZ4LevelController(parameters, LZ4Level.L00_FAST);
+		// compression takes 0.1ms, writing takes 10ms
+		for (var i = 0; i < 100; i++)
+			controller.Update(Mem.K64, Mem.K16, 0.0001, 0.0001, 0.01);
+		Assert.Equal(LZ4Level.L09_HC, controller.Level);
+		Assert.Equal(LZ4LevelController.Headroom, controller.Reason);
+	}
+
+	[Fact]
+	public void BackpressureLowersLevelWhenCompressionIsSlow()
+	{
+		var parameters = new LZ4AdaptiveParameters { Backpressure = true };
+		var controller = new LZ4LevelController(parameters, LZ4Level.L09_HC);
+		// compression takes 1.5ms, writing takes 1ms
+		Assert.Equal(LZ4Level.L08_HC, controller.Update(Mem.K64, Mem.K16, 0.0015, 0.0015, 0.001));
+		Assert.Equal(LZ4LevelController.Slow, controller.Reason);
+		// compression takes 10ms, writing takes 1ms
+		Assert.Equal(LZ4Level.L00_FAST, controller.Update(Mem.K64, Mem.K16, 0.01, 0.01, 0.001));
+		Assert.Equal(LZ4LevelController.Overloaded, controller.Reason);
+	}
+
+	[Fact]
+	public void BackpressureIsCombinedWithThroughputTarget()
+	{
+		var parameters = Throughput(100e6);
+		parameters.Backpressure = true;
+		var controller = new LZ4LevelController(parameters, LZ4Level.L09_HC);
+		// writes are very slow, but 64KB in 1ms is still below 100MB/s
+		Assert.Equal(LZ4Level.L08_HC, controller.Update(Mem.K64, Mem.K16, 0.001, 0.001, 1));
+	}
+
+	[Fact]
+	public void ControllerDoesNotRaiseLevelForIncompressibleData()
+	{
+		var controller = new LZ4LevelController(Throughput(100e6), LZ4Level.L03_HC);
+		for (var i = 0; i < 10; i++)
+			controller.Update(Mem.K64, Mem.K64, 1e-6, 1e-6);
+		Assert.Equal(LZ4Level.L00_FAST, controller.Level);
+		Assert.Equal(LZ4LevelController.Incompressible, controller.Reason);
+	}
+}
@@ -0,0 +1,94 @@
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+
+namespace K4os.Compression.LZ4.Tests;
+
+public class AnalyzerTests
+{
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST, Mem.K64)]
+	[InlineData(LZ4Level.L09_HC, Mem.K64)]
+	[InlineData(LZ4Level.L12_MAX, Mem.K256)]
+	public void BlockStatsAddUpToDecodedLength(LZ4Level level, int length)
+	{
+		var source = Lorem.Create(length);
+		var encoded = new byte[LZ4Codec.MaximumOutputSize(length)];
+		var encodedLength = LZ4Codec.Encode(source, encoded, level);
+
+		var stats = LZ4Analyzer.Block(encoded.AsSpan(0, encodedLength));
+
+		Assert.Equal(1, stats.Blocks);
+		Assert.Equal(0, stats.StoredBlocks);
+		Assert.Equal(encodedLength, stats.CompressedBytes);
+		Assert.Equal(length, stats.DecodedBytes);
+		Assert.Equal(length, stats.LiteralBytes + stats.MatchBytes);
+		Assert.Equal(stats.Sequences, stats.LiteralLengths.Sum());
+		Assert.Equal(stats.Matches, stats.MatchLengths.Sum());
+		Assert.Equal(stats.Matches, stats.Offsets.Sum());
+		Assert.Equal(stats.Matches + 1, stats.Sequences);
+		Assert.True(stats.DecodeCost >= stats.Sequences * LZ4Analyzer.SequenceCost);
+	}
+
+	[Fact]
+	public void RunsAreReportedAsOverlappingMatches()
+	{
+		var source = new byte[Mem.K64];
+		var encoded = LZ4Pickler.Pickle(source);
+
+		var stats = LZ4Analyzer.Pickle(encoded);
+
+		Assert.Equal(source.Length, stats.DecodedBytes);
+		Assert.True(stats.OverlappingMatches > 0);
+		Assert.Equal(stats.Matches, stats.Offsets[LZ4BlockStats.Bucket(1)]);
+	}
+
+	[Fact]
+	public void IncompressiblePickleIsReportedAsStored()
+	{
+		var source = new byte[Mem.K4];
+		new Random(0).NextBytes(source);
+		var encoded = LZ4Pickler.Pickle(source);
+
+		var stats = LZ4Analyzer.Pickle(encoded);
+
+		Assert.Equal(1, stats.StoredBlocks);
+		Assert.Equal(source.Length, stats.DecodedBytes);
+		Assert.Equal(0, stats.Sequences);
+	}
+
+	[Fact]
+	public void StatsCanBeMerged()
+	{
+		var first = LZ4Analyzer.Pickle(LZ4Pickler.Pickle(Lorem.Create(Mem.K16)));
+		var second = LZ4Analyzer.Pickle(LZ4Pickler.Pickle(Lorem.Create(Mem.K32)));
+		var both = new LZ4BlockStats();
+		both.Add(first);
+		both.Add(second);
+
+		Assert.Equal(2, both.Blocks);
+		Assert.Equal(Mem.K16 + Mem.K32, both.DecodedBytes);
+		Assert.Equal(first.Sequences + second.Sequences, both.Sequences);
+		Assert.Equal(first.DecodeCost + second.DecodeCost, both.DecodeCost);
+	}
+
+	[Theory]
+	[InlineData(new byte[] { 0x13, 0x61, 0x02, 0x00, 0x50, 0x62, 0x63, 0x64, 0x65, 0x66 })] // offset beyond output
+	[InlineData(new byte[] { 0x13, 0x00, 0x01, 0x00, 0x15, 0xA8 })] // literals too close to end of block
+	[InlineData(new byte[] { 0x1F, 0x61, 0x01, 0x00, 0x00, 0x40, 0x62, 0x63, 0x64, 0x65 })] // too few last literals
+	[InlineData(new byte[] { 0x10, 0x61, 0x01, 0x00, 0x50, 0x62, 0x63, 0x64, 0x65, 0x66 })] // match too close to end
+	[InlineData(new byte[] { 0x50, 0x61, 0x62 })] // literals beyond block
+	[InlineData(new byte[] { 0x10, 0x61, 0x01, 0x00 })] // no last literals
+	[InlineData(new byte[] { 0xF0, 0xFF })] // length beyond block
+	public void CorruptedBlockIsRejected(byte[] block)
+	{
+		Assert.Throws<InvalidDataException>(() => LZ4Analyzer.Block(block));
+	}
+
+	[Fact]
+	public void DictionaryAllowsOffsetsBeforeBlock()
+	{
+		var block = new byte[] { 0x13, 0x61, 0x05, 0x00, 0x50, 0x62, 0x63, 0x64, 0x65, 0x66 };
+		var stats = LZ4Analyzer.Block(block, dictionaryLength: 4);
+		Assert.Equal(1 + 7 + 5, stats.DecodedBytes);
+	}
+}
@@ -0,0 +1,110 @@
+using K4os.Compression.LZ4.Internal;
+
+namespace K4os.Compression.LZ4.Tests;
+
+// pool is static and shared with every frame reader and writer, so tests checking
+// which buffers it holds cannot run in parallel with anything else
+[CollectionDefinition(nameof(BlockBufferPoolTests), DisableParallelization = true)]
+public class BlockBufferPoolCollection { }
+
+[Collection(nameof(BlockBufferPoolTests))]
+public class BlockBufferPoolTests
+{
+	[Theory]
+	[InlineData(Mem.K64)]
+	[InlineData(Mem.K256)]
+	[InlineData(Mem.M1)]
+	[InlineData(Mem.M4)]
+	public void FrameBuffersAreServedFromBlockPool(int blockSize)
+	{
+		var expected = BlockBufferPool.BufferLength(blockSize);
+		var maximum = LZ4Codec.MaximumOutputSize(blockSize) + 16;
+
+		var buffer = BufferPool.Alloc(maximum);
+		Assert.Equal(expected, buffer.Length);
+		BufferPool.Free(buffer);
+
+		buffer = BufferPool.Alloc(blockSize);
+		Assert.Equal(expected, buffer.Length);
+		BufferPool.Free(buffer);
+	}
+
+	[Fact]
+	public void ReturnedBufferIsReused()
+	{
+		var size = BlockBufferPool.BufferLength(Mem.M4);
+		BlockBufferPool.Trim(); // buffers cached by other tests could be served instead
+		var hits = BlockBufferPool.Hits;
+
+		var first = BufferPool.Alloc(size);
+		BufferPool.Free(first);
+		var second = BufferPool.Alloc(size);
+		BufferPool.Free(second);
+
+		Assert.Same(first, second);
+		Assert.True(BlockBufferPool.Hits > hits);
+	}
+
+	[Theory]
+	[InlineData(1000)]
+	[InlineData(Mem.K16)]
+	[InlineData(Mem.M4 * 2)]
+	public void OtherSizesAreNotAffected(int size)
+	{
+		var buffer = BufferPool.Alloc(size);
+		Assert.NotEqual(BlockBufferPool.BufferLength(Mem.M4), buffer.Length);
+		Assert.False(BlockBufferPool.TryReturn(buffer));
+		BufferPool.Free(buffer);
+	}
+
+	[Fact]
+	public void TrimReleasesCachedBuffers()
+	{
+		var buffer = BufferPool.Alloc(Mem.K256);
+		BufferPool.Free(buffer);
+		var trims = BlockBufferPool.Trims;
+
+		BlockBufferPool.Trim();
+
+		Assert.True(BlockBufferPool.Trims > trims);
+		Assert.Equal(0, BlockBufferPool.CachedBuffers);
+	}
+
+	[Fact]
+	public void TrimStopsTimerWhenPoolIsEmpty()
+	{
+		BlockBufferPool.Trim();
+		Assert.False(BlockBufferPool.TrimScheduled);
+
+		BufferPool.Free(BufferPool.Alloc(Mem.K64));
+		Assert.True(BlockBufferPool.TrimScheduled);
+
+		BlockBufferPool.Trim();
+		Assert.False(BlockBufferPool.TrimScheduled);
+	}
+
+	[Fact]
+	public void CachedBytesAreLimited()
+	{
+		var size = BlockBufferPool.BufferLength(Mem.M1);
+		var limit = BlockBufferPool.MaxCachedBytes;
+		BlockBufferPool.Trim();
+		try
+		{
+			BlockBufferPool.MaxCachedBytes = size * 2;
+			var drops = BlockBufferPool.Drops;
+
+			var buffers = Enumerable.Range(0, 3).Select(_ => BufferPool.Alloc(size)).ToArray();
+			foreach (var buffer in buffers) BufferPool.Free(buffer);
+
+			Assert.Equal(2, BlockBufferPool.CachedBuffers);
+			Assert.Equal(size * 2, BlockBufferPool.CachedBytes);
+			Assert.True(BlockBufferPool.Drops > drops);
+		}
+		finally
+		{
+			BlockBufferPool.MaxCachedBytes = limit;
+			BlockBufferPool.Trim();
+		}
+	}
+}
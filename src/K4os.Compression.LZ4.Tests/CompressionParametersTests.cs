@@ -0,0 +1,339 @@
+using System.Text;
+using K4os.Compression.LZ4.Encoders;
+using K4os.Compression.LZ4.Engine;
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+
+namespace K4os.Compression.LZ4.Tests;
+
+public class CompressionParametersTests
+{
+	private static byte[] Words(int length, int seed = 0)
+	{
+		var words = Lorem.Text.Split(' ');
+		var random = new Random(seed);
+		var text = new StringBuilder();
+		while (text.Length < length)
+			text.Append(words[random.Next(words.Length)]).Append(' ');
+		return Encoding.ASCII.GetBytes(text.ToString(0, length));
+	}
+
+	private static byte[] Encode(byte[] source, LZ4Level level)
+	{
+		var encoded = new byte[LZ4Codec.MaximumOutputSize(source.Length)];
+		var encodedLength = LZ4Codec.Encode(source, encoded, level);
+		Assert.True(encodedLength >= 0);
+		return encoded.AsSpan(0, encodedLength).ToArray();
+	}
+
+	private static byte[] Encode(byte[] source, LZ4CompressionParameters parameters)
+	{
+		var encoded = new byte[LZ4Codec.MaximumOutputSize(source.Length)];
+		var encodedLength = LZ4Codec.Encode(source, encoded, parameters);
+		Assert.True(encodedLength >= 0);
+		return encoded.AsSpan(0, encodedLength).ToArray();
+	}
+
+	private static byte[] Decode(byte[] encoded, int length)
+	{
+		var decoded = new byte[length];
+		Assert.Equal(length, LZ4Codec.Decode(encoded, decoded));
+		return decoded;
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST)]
+	[InlineData(LZ4Level.L02_MID)]
+	[InlineData(LZ4Level.L09_HC)]
+	[InlineData(LZ4Level.L12_MAX)]
+	public void DefaultParametersProduceSameOutputAsLevel(LZ4Level level)
+	{
+		var source = Words(Mem.K256);
+		Assert.Equal(
+			Encode(source, level),
+			Encode(source, new LZ4CompressionParameters(level)));
+	}
+
+	[Theory]
+	[InlineData(1337, 8, false)]
+	[InlineData(Mem.K64, 8, false)]
+	[InlineData(Mem.K64, 10, true)]
+	[InlineData(Mem.M1, 8, false)]
+	[InlineData(Mem.M1, 10, true)]
+	[InlineData(Mem.M1, 2, false)]
+	[InlineData(Mem.M1, 20, false)]
+	public void SmallerHashTableCanBeDecoded(int length, int hashLog, bool enforce32)
+	{
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			var source = Words(length);
+			var parameters = new LZ4CompressionParameters { HashLog = hashLog };
+			var encoded = Encode(source, parameters);
+			Assert.Equal(source, Decode(encoded, length));
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+	}
+
+	[Fact]
+	public void SmallerHashTableFindsFewerMatches()
+	{
+		var source = Words(Mem.M1);
+		var small = Encode(source, new LZ4CompressionParameters { HashLog = 8 }).Length;
+		var large = Encode(source, new LZ4CompressionParameters { HashLog = 12 }).Length;
+		Assert.True(large < small, $"large:{large} small:{small}");
+	}
+
+	[Fact]
+	public void AccelerationTradesRatio()
+	{
+		var source = Words(Mem.M1);
+		var normal = Encode(source, new LZ4CompressionParameters()).Length;
+		var encoded = Encode(source, new LZ4CompressionParameters { Acceleration = 32 });
+		Assert.True(normal < encoded.Length, $"normal:{normal} accelerated:{encoded.Length}");
+		Assert.Equal(source, Decode(encoded, source.Length));
+	}
+
+	[Fact]
+	public void SearchDepthOverridesLevel()
+	{
+		// L09 is just hash chain with search depth of 256
+		var source = Words(Mem.K256);
+		var parameters = new LZ4CompressionParameters(LZ4Level.L03_HC) { SearchDepth = 256 };
+		Assert.Equal(Encode(source, LZ4Level.L09_HC), Encode(source, parameters));
+		Assert.NotEqual(Encode(source, LZ4Level.L03_HC), Encode(source, parameters));
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L10_OPT, 16, 32)]
+	[InlineData(LZ4Level.L11_OPT, 1024, 4096)]
+	[InlineData(LZ4Level.L11_OPT, 0, 100000)]
+	[InlineData(LZ4Level.L12_MAX, 64, 0)]
+	public void SearchParametersCanBeDecoded(LZ4Level level, int depth, int target)
+	{
+		var source = Words(Mem.K256);
+		var parameters = new LZ4CompressionParameters(level) {
+			SearchDepth = depth, TargetLength = target,
+		};
+		var encoded = Encode(source, parameters);
+		Assert.Equal(source, Decode(encoded, source.Length));
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L03_HC)]
+	[InlineData(LZ4Level.L09_HC)]
+	[InlineData(LZ4Level.L11_OPT)]
+	[InlineData(LZ4Level.L12_MAX)]
+	public void FavoringDecompressionSpeedAvoidsShortOffsets(LZ4Level level)
+	{
+		var source = Words(Mem.K256);
+		source.AsSpan(Mem.K64, Mem.K1).Fill(0);
+		var parameters = new LZ4CompressionParameters(level) {
+			FavorDecompressionSpeed = true,
+		};
+
+		var favored = Encode(source, parameters);
+		var regular = Encode(source, level);
+		Assert.Equal(source, Decode(favored, source.Length));
+
+		var favoredStats = LZ4Analyzer.Block(favored);
+		var regularStats = LZ4Analyzer.Block(regular);
+		var favoredShort = favoredStats.OverlappingMatches;
+		var regularShort = regularStats.OverlappingMatches;
+		Assert.True(favoredShort < regularShort, $"favored:{favoredShort} regular:{regularShort}");
+		Assert.True(favoredStats.DecodeCost <= regularStats.DecodeCost);
+		Assert.True(favoredStats.Sequences <= regularStats.Sequences);
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L10_OPT, false, false)]
+	[InlineData(LZ4Level.L11_OPT, false, false)]
+	[InlineData(LZ4Level.L12_MAX, false, false)]
+	[InlineData(LZ4Level.L11_OPT, true, false)]
+	[InlineData(LZ4Level.L12_MAX, false, true)]
+	public void BinaryTreeMatchFinderIsAsGoodAsHashChain(
+		LZ4Level level, bool favor, bool enforce32)
+	{
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			var source = Words(Mem.K256);
+			// long repetitions are degenerate case for binary tree
+			source.AsSpan(Mem.K64, Mem.K8).Fill(0);
+			source.AsSpan(Mem.K128, Mem.K8).Fill(1);
+			var parameters = new LZ4CompressionParameters(level) {
+				FavorDecompressionSpeed = favor,
+			};
+			var chain = Encode(source, parameters);
+			parameters.BinaryTreeMatchFinder = true;
+			var tree = Encode(source, parameters);
+
+			Assert.Equal(source, Decode(tree, source.Length));
+			Assert.True(tree.Length <= chain.Length * 1.01, $"tree:{tree.Length} chain:{chain.Length}");
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L11_OPT, false)]
+	[InlineData(LZ4Level.L11_OPT, true)]
+	[InlineData(LZ4Level.L12_MAX, false)]
+	public unsafe void BinaryTreeMatchFinderSurvivesDictionaryReload(
+		LZ4Level level, bool enforce32)
+	{
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			const int blockSize = Mem.K64;
+			var source = Words(16 * blockSize);
+			source.AsSpan(5 * blockSize, Mem.K8).Fill(0);
+			var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+			var decoded = new byte[source.Length];
+
+			using var context = new Pubternal.HighContext(level, true);
+			for (var offset = 0; offset < source.Length; offset += blockSize)
+			{
+				int encoded;
+				fixed (byte* sourceP = source)
+				fixed (byte* targetP = target)
+				{
+					// reloading history (like stream does when its index overflows)
+					// indexes it with hash chain only
+					if (offset > 0 && offset % (3 * blockSize) == 0)
+						Pubternal.LoadDictHigh(context, sourceP + offset - Mem.K64, Mem.K64);
+					encoded = Pubternal.CompressHigh(
+						context, sourceP + offset, targetP, blockSize, target.Length);
+				}
+
+				Assert.True(encoded > 0);
+				var dictionaryLength = Math.Min(offset, Mem.K64);
+				Assert.Equal(
+					blockSize,
+					LZ4Codec.Decode(
+						target, 0, encoded,
+						decoded, offset, blockSize,
+						decoded, offset - dictionaryLength, dictionaryLength));
+				Assert.Equal(
+					source.AsSpan(offset, blockSize).ToArray(),
+					decoded.AsSpan(offset, blockSize).ToArray());
+			}
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+	}
+
+	[Fact]
+	public void BinaryTreeMatchFinderIsIgnoredBelowOptimalLevels()
+	{
+		var source = Words(Mem.K64);
+		var parameters = new LZ4CompressionParameters(LZ4Level.L09_HC) {
+			BinaryTreeMatchFinder = true,
+		};
+		Assert.Equal(Encode(source, LZ4Level.L09_HC), Encode(source, parameters));
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L10_OPT, 0, false)]
+	[InlineData(LZ4Level.L10_OPT, LZ4CompressionParameters.MinParseWindow, false)]
+	[InlineData(LZ4Level.L11_OPT, LZ4CompressionParameters.UltraParseWindow, true)]
+	[InlineData(LZ4Level.L12_MAX, LZ4CompressionParameters.UltraParseWindow, false)]
+	[InlineData(LZ4Level.L12_MAX, 1 << 20, false)]
+	public void ParseWindowCanBeDecoded(LZ4Level level, int window, bool binaryTree)
+	{
+		var source = Words(Mem.K256);
+		source.AsSpan(Mem.K64, Mem.K32).Fill(0);
+		var parameters = new LZ4CompressionParameters(level) {
+			ParseWindow = window, TargetLength = window, BinaryTreeMatchFinder = binaryTree,
+		};
+		var encoded = Encode(source, parameters);
+		Assert.Equal(source, Decode(encoded, source.Length));
+	}
+
+	[Fact]
+	public void DefaultParseWindowProducesSameOutputAsLevel()
+	{
+		var source = Words(Mem.K256);
+		var parameters = new LZ4CompressionParameters(LZ4Level.L12_MAX) {
+			ParseWindow = LZ4CompressionParameters.DefaultParseWindow,
+		};
+		Assert.Equal(Encode(source, LZ4Level.L12_MAX), Encode(source, parameters));
+	}
+
+	[Theory]
+	[InlineData(false)]
+	[InlineData(true)]
+	public void UltraLevelIsNotWorseThanMax(bool enforce32)
+	{
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			var source = Words(Mem.K256);
+			source.AsSpan(Mem.K64, Mem.K32).Fill(0);
+			var max = Encode(source, LZ4Level.L12_MAX);
+			var ultra = Encode(source, LZ4Level.L13_ULTRA);
+			Assert.Equal(source, Decode(ultra, source.Length));
+			Assert.True(ultra.Length <= max.Length, $"ultra:{ultra.Length} max:{max.Length}");
+			Assert.Equal(ultra, Encode(source, new LZ4CompressionParameters(LZ4Level.L13_ULTRA)));
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+	}
+
+	[Fact]
+	public void PicklerAcceptsParameters()
+	{
+		var source = Words(Mem.K64);
+		var parameters = new LZ4CompressionParameters(LZ4Level.L03_HC) { SearchDepth = 256 };
+		var pickled = LZ4Pickler.Pickle(source, parameters);
+		Assert.Equal(source, LZ4Pickler.Unpickle(pickled));
+		Assert.Equal(LZ4Pickler.Pickle(source, LZ4Level.L09_HC), pickled);
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST, typeof(LZ4FastChainEncoder))]
+	[InlineData(LZ4Level.L02_MID, typeof(LZ4MidChainEncoder))]
+	[InlineData(LZ4Level.L10_OPT, typeof(LZ4HighChainEncoder))]
+	[InlineData(LZ4Level.L12_MAX, typeof(LZ4HighChainEncoder))]
+	[InlineData(LZ4Level.L13_ULTRA, typeof(LZ4HighChainEncoder))]
+	public void ChainedEncodersAcceptParameters(LZ4Level level, Type expected)
+	{
+		const int blockSize = Mem.K64;
+		var source = Words(Mem.M1);
+		var parameters = new LZ4CompressionParameters(level) {
+			HashLog = 10, SearchDepth = 32, FavorDecompressionSpeed = true,
+			BinaryTreeMatchFinder = true, ParseWindow = LZ4CompressionParameters.UltraParseWindow,
+		};
+
+		using var encoder = LZ4Encoder.Create(true, parameters, blockSize);
+		using var decoder = LZ4Decoder.Create(true, blockSize);
+		Assert.Equal(expected, encoder.GetType());
+
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+		var decoded = new byte[blockSize];
+
+		for (var offset = 0; offset < source.Length; offset += blockSize)
+		{
+			var chunk = Math.Min(blockSize, source.Length - offset);
+			var action = encoder.TopupAndEncode(
+				source.AsSpan(offset, chunk), target, true, false,
+				out var loaded, out var encoded);
+			Assert.Equal(EncoderAction.Encoded, action);
+			Assert.Equal(chunk, loaded);
+
+			decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out var decodedLength);
+			Assert.Equal(
+				source.AsSpan(offset, chunk).ToArray(),
+				decoded.AsSpan(0, decodedLength).ToArray());
+		}
+	}
+}
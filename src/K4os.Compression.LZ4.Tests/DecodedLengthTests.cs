@@ -0,0 +1,119 @@
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+
+namespace K4os.Compression.LZ4.Tests;
+
+public class DecodedLengthTests
+{
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST, 0)]
+	[InlineData(LZ4Level.L00_FAST, 1)]
+	[InlineData(LZ4Level.L00_FAST, 15)]
+	[InlineData(LZ4Level.L00_FAST, Mem.K64)]
+	[InlineData(LZ4Level.L09_HC, Mem.K64 + 1337)]
+	[InlineData(LZ4Level.L12_MAX, Mem.M1)]
+	public void DecodedLengthMatchesOriginal(LZ4Level level, int length)
+	{
+		var source = Lorem.Create(length);
+		var encoded = new byte[LZ4Codec.MaximumOutputSize(length)];
+		var encodedLength = LZ4Codec.Encode(source, encoded, level);
+
+		Assert.Equal(length, LZ4Codec.GetDecodedLength(encoded.AsSpan(0, encodedLength)));
+		Assert.Equal(length, LZ4Codec.GetDecodedLength(encoded, 0, encodedLength));
+	}
+
+	[Theory]
+	[InlineData(Mem.K64)]
+	[InlineData(Mem.M4)]
+	public void LongRunsAndIncompressibleDataAreMeasured(int length)
+	{
+		var zeros = new byte[length];
+		var random = new byte[length];
+		new Random(0).NextBytes(random);
+
+		foreach (var source in new[] { zeros, random })
+		{
+			var encoded = new byte[LZ4Codec.MaximumOutputSize(length)];
+			var encodedLength = LZ4Codec.Encode(source, encoded);
+			Assert.Equal(length, LZ4Codec.GetDecodedLength(encoded.AsSpan(0, encodedLength)));
+		}
+	}
+
+	[Theory]
+	[InlineData(new byte[] { 0x13, 0x61, 0x02, 0x00, 0x50, 0x62, 0x63, 0x64, 0x65, 0x66 })] // offset beyond output
+	[InlineData(new byte[] { 0x13, 0x00, 0x01, 0x00, 0x15, 0xA8 })] // literals too close to end of block
+	[InlineData(new byte[] { 0x50, 0x61, 0x62 })] // literals beyond block
+	[InlineData(new byte[] { 0x10, 0x61, 0x01, 0x00 })] // no last literals
+	[InlineData(new byte[] { 0x10, 0x61, 0x01 })] // truncated offset
+	[InlineData(new byte[] { 0xF0, 0xFF })] // length beyond block
+	public void CorruptedBlockIsRejected(byte[] block)
+	{
+		Assert.True(LZ4Codec.GetDecodedLength(block) < 0);
+		Assert.True(LZ4Codec.Decode(block, new byte[Mem.K4]) < 0);
+	}
+
+	[Theory]
+	[InlineData(new byte[] { 0x1F, 0x61, 0x01, 0x00, 0x00, 0x40, 0x62, 0x63, 0x64, 0x65 }, 24)] // too few last literals
+	[InlineData(new byte[] { 0x10, 0x61, 0x01, 0x00, 0x50, 0x62, 0x63, 0x64, 0x65, 0x66 }, 10)] // match too close to end
+	public void BlockNotDecodableIntoExactBufferIsRejected(byte[] block, int length)
+	{
+		Assert.True(LZ4Codec.GetDecodedLength(block) < 0);
+		Assert.True(LZ4Codec.Decode(block, new byte[length]) < 0);
+	}
+
+	[Fact]
+	public void EmptyBlocksAreMeasuredLikeDecoderDoes()
+	{
+		Assert.Equal(0, LZ4Codec.GetDecodedLength(Array.Empty<byte>()));
+		Assert.Equal(0, LZ4Codec.Decode(Array.Empty<byte>(), Array.Empty<byte>()));
+		Assert.Equal(0, LZ4Analyzer.Block(Array.Empty<byte>()).DecodedBytes);
+
+		var nothing = new byte[] { 0x00 };
+		Assert.True(LZ4Codec.GetDecodedLength(nothing) < 0);
+		Assert.True(LZ4Codec.Decode(nothing, new byte[Mem.K4]) < 0);
+		Assert.Throws<InvalidDataException>(() => LZ4Analyzer.Block(nothing));
+	}
+
+	[Fact]
+	public void ZeroOffsetIsAcceptedLikeDecoderDoes()
+	{
+		var block = new byte[] { 0x13, 0x61, 0x00, 0x00, 0x50, 0x62, 0x63, 0x64, 0x65, 0x66 };
+		Assert.Equal(1 + 7 + 5, LZ4Codec.GetDecodedLength(block));
+		Assert.Equal(1 + 7 + 5, LZ4Codec.Decode(block, new byte[1 + 7 + 5]));
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST)]
+	[InlineData(LZ4Level.L09_HC)]
+	public void MutatedBlockIsMeasuredIfAndOnlyIfItCanBeDecoded(LZ4Level level)
+	{
+		var source = Lorem.Create(Mem.K4);
+		var encoded = new byte[LZ4Codec.MaximumOutputSize(source.Length)];
+		encoded = encoded.AsSpan(0, LZ4Codec.Encode(source, encoded, level)).ToArray();
+		var random = new Random(0);
+
+		for (var i = 0; i < 10000; i++)
+		{
+			var block = encoded.AsSpan(0, random.Next(encoded.Length) + 1).ToArray();
+			for (var j = random.Next(4); j >= 0; j--)
+				block[random.Next(block.Length)] = (byte) random.Next(256);
+
+			var length = LZ4Codec.GetDecodedLength(block);
+			if (length >= 0)
+				Assert.Equal(length, LZ4Codec.Decode(block, new byte[length]));
+
+			// ...and the other way around, when it decodes into buffer of exact size
+			var decoded = LZ4Codec.Decode(block, new byte[Mem.K64]);
+			if (decoded > 0 && LZ4Codec.Decode(block, new byte[decoded]) == decoded)
+				Assert.Equal(decoded, length);
+		}
+	}
+
+	[Fact]
+	public void DictionaryAllowsOffsetsBeforeBlock()
+	{
+		var block = new byte[] { 0x13, 0x61, 0x05, 0x00, 0x50, 0x62, 0x63, 0x64, 0x65, 0x66 };
+		Assert.True(LZ4Codec.GetDecodedLength(block, 3) < 0);
+		Assert.Equal(1 + 7 + 5, LZ4Codec.GetDecodedLength(block, 4));
+	}
+}
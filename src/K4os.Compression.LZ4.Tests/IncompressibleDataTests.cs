@@ -0,0 +1,206 @@
+using System.Text;
+using K4os.Compression.LZ4.Encoders;
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+
+namespace K4os.Compression.LZ4.Tests;
+
+public class IncompressibleDataTests
+{
+	private static byte[] Words(int length, int seed = 0)
+	{
+		var words = Lorem.Text.Split(' ');
+		var random = new Random(seed);
+		var text = new StringBuilder();
+		while (text.Length < length)
+			text.Append(words[random.Next(words.Length)]).Append(' ');
+		return Encoding.ASCII.GetBytes(text.ToString(0, length));
+	}
+
+	private static byte[] Noise(int length, int seed = 0)
+	{
+		var buffer = new byte[length];
+		new Random(seed).NextBytes(buffer);
+		return buffer;
+	}
+
+	private static byte[] Periodic(int length, int period)
+	{
+		var buffer = new byte[length];
+		var chunk = Noise(period);
+		for (var offset = 0; offset < length; offset += period)
+			chunk.AsSpan(0, Math.Min(period, length - offset)).CopyTo(buffer.AsSpan(offset));
+		return buffer;
+	}
+
+	[Fact]
+	public void NoiseLooksIncompressible()
+	{
+		Assert.True(Compressibility.LooksIncompressible(Noise(Mem.K4)));
+		Assert.True(Compressibility.LooksIncompressible(Noise(Mem.K64)));
+		Assert.True(Compressibility.LooksIncompressible(Noise(Mem.M4)));
+	}
+
+	[Fact]
+	public void ShortBlocksNeverLookIncompressible()
+	{
+		Assert.False(Compressibility.LooksIncompressible(Noise(Compressibility.MinLength - 1)));
+		Assert.False(Compressibility.LooksIncompressible(ReadOnlySpan<byte>.Empty));
+	}
+
+	[Fact]
+	public void CompressibleDataDoesNotLookIncompressible()
+	{
+		Assert.False(Compressibility.LooksIncompressible(Words(Mem.K64)));
+		Assert.False(Compressibility.LooksIncompressible(new byte[Mem.K64]));
+
+		// byte distribution is flat, but it repeats
+		var repeated = new byte[Mem.K64];
+		var chunk = Noise(Mem.K4);
+		for (var offset = 0; offset < repeated.Length; offset += chunk.Length)
+			chunk.CopyTo(repeated, offset);
+		Assert.False(Compressibility.LooksIncompressible(repeated));
+
+		// flat distribution of few symbols
+		var hex = Encoding.ASCII.GetBytes(string.Concat(Noise(Mem.K32).Select(b => b.ToString("x2"))));
+		Assert.False(Compressibility.LooksIncompressible(hex));
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST)]
+	[InlineData(LZ4Level.L02_MID)]
+	[InlineData(LZ4Level.L09_HC)]
+	[InlineData(LZ4Level.L11_OPT)]
+	public void IncompressibleBlocksAreCopiedInChainedBlocks(LZ4Level level)
+	{
+		const int blockSize = Mem.K64;
+		var words = Words(blockSize);
+		var noise = Noise(blockSize);
+		// incompressible block in the middle of compressible ones, referencing older blocks
+		var source = words.Concat(noise).Concat(words).Concat(noise).Concat(words).ToArray();
+
+		using var encoder = LZ4Encoder.Create(true, level, blockSize);
+		using var decoder = LZ4Decoder.Create(true, blockSize);
+
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+		var decoded = new byte[blockSize];
+
+		for (var offset = 0; offset < source.Length; offset += blockSize)
+		{
+			var chunk = source.AsSpan(offset, blockSize);
+			var action = encoder.TopupAndEncode(
+				chunk, target, true, true, out _, out var encoded);
+			var compressible = offset % (2 * blockSize) == 0;
+			Assert.Equal(compressible ? EncoderAction.Encoded : EncoderAction.Copied, action);
+
+			if (action == EncoderAction.Copied)
+			{
+				decoder.Inject(target, 0, encoded);
+				decoder.Drain(decoded, -encoded, encoded);
+			}
+			else
+			{
+				decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out _);
+			}
+
+			Assert.Equal(chunk.ToArray(), decoded);
+		}
+	}
+
+	[Fact]
+	public void PeriodicNoiseIsNotIncompressible()
+	{
+		// sampler is fooled by it, but fast compressor is not
+		var source = Periodic(Mem.K64, 5000);
+		Assert.True(Compressibility.LooksIncompressible(source));
+		Assert.False(Compressibility.IsIncompressible(source, new byte[source.Length]));
+		Assert.True(Compressibility.IsIncompressible(Noise(Mem.K64), new byte[Mem.K64]));
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L09_HC)]
+	[InlineData(LZ4Level.L12_MAX)]
+	public void PeriodicNoiseIsCompressedByHighLevels(LZ4Level level)
+	{
+		const int blockSize = Mem.K64;
+		var source = Periodic(4 * blockSize, 5000);
+
+		var pickled = LZ4Pickler.Pickle(source.AsSpan(0, blockSize), level);
+		var fast = LZ4Pickler.Pickle(source.AsSpan(0, blockSize), LZ4Level.L00_FAST);
+		Assert.True(pickled.Length <= fast.Length, $"{pickled.Length} > {fast.Length}");
+
+		using var encoder = LZ4Encoder.Create(true, level, blockSize);
+		using var decoder = LZ4Decoder.Create(true, blockSize);
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+		var decoded = new byte[blockSize];
+		var total = 0;
+
+		for (var offset = 0; offset < source.Length; offset += blockSize)
+		{
+			var chunk = source.AsSpan(offset, blockSize);
+			var action = encoder.TopupAndEncode(
+				chunk, target, true, true, out _, out var encoded);
+			Assert.Equal(EncoderAction.Encoded, action);
+			total += encoded;
+
+			decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out _);
+			Assert.Equal(chunk.ToArray(), decoded);
+		}
+
+		Assert.True(total < 2 * fast.Length, $"{total}");
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L09_HC)]
+	[InlineData(LZ4Level.L11_OPT)]
+	public void RepeatedNoiseBlockReferencesSkippedOne(LZ4Level level)
+	{
+		const int blockSize = Mem.K32;
+		var noise = Noise(blockSize);
+
+		using var encoder = LZ4Encoder.Create(true, level, blockSize);
+		using var decoder = LZ4Decoder.Create(true, blockSize);
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+		var decoded = new byte[blockSize];
+
+		var action = encoder.TopupAndEncode(
+			noise, target, true, true, out _, out var encoded);
+		Assert.Equal(EncoderAction.Copied, action);
+		decoder.Inject(target, 0, encoded);
+		decoder.Drain(decoded, -encoded, encoded);
+
+		// second block does not compress on its own, but it is a copy of the first one
+		action = encoder.TopupAndEncode(
+			noise, target, true, true, out _, out encoded);
+		Assert.Equal(EncoderAction.Encoded, action);
+		Assert.True(encoded < blockSize / 100, $"{encoded}");
+		decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out _);
+		Assert.Equal(noise, decoded);
+	}
+
+	[Fact]
+	public void IncompressibleBlockFailsWithoutCopyingWhenTargetIsTooSmall()
+	{
+		var source = Noise(Mem.K64);
+		using var encoder = LZ4Encoder.Create(false, LZ4Level.L09_HC, source.Length);
+		var target = new byte[source.Length];
+		Assert.Equal(source.Length, encoder.Topup(source, 0, source.Length));
+		Assert.Throws<InvalidOperationException>(() => encoder.Encode(target, 0, target.Length, false));
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST)]
+	[InlineData(LZ4Level.L09_HC)]
+	[InlineData(LZ4Level.L12_MAX)]
+	public void IncompressiblePicklesAreStored(LZ4Level level)
+	{
+		var source = Noise(Mem.K256);
+		var pickled = LZ4Pickler.Pickle(source, level);
+		Assert.Equal(source.Length + 1, pickled.Length);
+		Assert.Equal(source, LZ4Pickler.Unpickle(pickled));
+
+		var writer = new BufferWriter();
+		LZ4Pickler.Pickle(source, writer, level);
+		Assert.Equal(pickled, writer.WrittenSpan.ToArray());
+	}
+}
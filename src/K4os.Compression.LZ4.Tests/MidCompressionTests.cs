@@ -0,0 +1,130 @@
+using System.Text;
+using K4os.Compression.LZ4.Encoders;
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+
+namespace K4os.Compression.LZ4.Tests;
+
+public class MidCompressionTests
+{
+	// plain Lorem repeats every few hundred bytes, so every compressor finds the same matches
+	private static byte[] Words(int length, int seed = 0)
+	{
+		var words = Lorem.Text.Split(' ');
+		var random = new Random(seed);
+		var text = new StringBuilder();
+		while (text.Length < length)
+			text.Append(words[random.Next(words.Length)]).Append(' ');
+		return Encoding.ASCII.GetBytes(text.ToString(0, length));
+	}
+
+	private static byte[] Encode(byte[] source, LZ4Level level)
+	{
+		var encoded = new byte[LZ4Codec.MaximumOutputSize(source.Length)];
+		var encodedLength = LZ4Codec.Encode(source, encoded, level);
+		Assert.True(encodedLength >= 0);
+		return encoded.AsSpan(0, encodedLength).ToArray();
+	}
+
+	private static byte[] Decode(byte[] encoded, int length)
+	{
+		var decoded = new byte[length];
+		Assert.Equal(length, LZ4Codec.Decode(encoded, decoded));
+		return decoded;
+	}
+
+	[Theory]
+	[InlineData(0, false)]
+	[InlineData(1, false)]
+	[InlineData(13, false)]
+	[InlineData(1337, false)]
+	[InlineData(Mem.K64, false)]
+	[InlineData(Mem.K64, true)]
+	[InlineData(Mem.M1 + 1337, false)]
+	[InlineData(Mem.M1 + 1337, true)]
+	public void CompressedBlocksCanBeDecoded(int length, bool enforce32)
+	{
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			var source = Words(length);
+			var encoded = Encode(source, LZ4Level.L02_MID);
+			Assert.Equal(source, Decode(encoded, length));
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+	}
+
+	[Fact]
+	public void RunsAndIncompressibleDataCanBeDecoded()
+	{
+		var source = new byte[Mem.K256];
+		new Random(0).NextBytes(source.AsSpan(Mem.K64, Mem.K64));
+		source.AsSpan(Mem.K128, Mem.K64).Fill(0xAA);
+
+		var encoded = Encode(source, LZ4Level.L02_MID);
+		Assert.Equal(source, Decode(encoded, source.Length));
+	}
+
+	[Fact]
+	public void CompressionRatioIsBetweenFastAndHigh()
+	{
+		var source = Words(Mem.M1);
+
+		var fast = Encode(source, LZ4Level.L00_FAST).Length;
+		var mid = Encode(source, LZ4Level.L02_MID).Length;
+		var high = Encode(source, LZ4Level.L09_HC).Length;
+
+		Assert.True(mid < fast, $"mid:{mid} fast:{fast}");
+		Assert.True(high < mid, $"high:{high} mid:{mid}");
+	}
+
+	[Fact]
+	public void TooSmallTargetIsReported()
+	{
+		var source = Words(Mem.K64);
+		var encoded = new byte[Mem.K1];
+		Assert.True(LZ4Codec.Encode(source, encoded, LZ4Level.L02_MID) < 0);
+	}
+
+	[Theory]
+	[InlineData(Mem.K64, Mem.M1, 0)]
+	[InlineData(Mem.K64, Mem.M1, 3)]
+	[InlineData(Mem.K1, Mem.K128, 0)]
+	[InlineData(Mem.K256, Mem.M1, 1)]
+	public void ChainedBlocksCanBeDecoded(int blockSize, int length, int extraBlocks)
+	{
+		var source = Words(length);
+
+		using var encoder = LZ4Encoder.Create(true, LZ4Level.L02_MID, blockSize, extraBlocks);
+		using var decoder = LZ4Decoder.Create(true, blockSize, extraBlocks);
+		Assert.IsType<LZ4MidChainEncoder>(encoder);
+
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+		var decoded = new byte[blockSize];
+		var chained = 0;
+		var independent = 0;
+
+		for (var offset = 0; offset < length; offset += blockSize)
+		{
+			var chunk = Math.Min(blockSize, length - offset);
+			var action = encoder.TopupAndEncode(
+				source.AsSpan(offset, chunk), target, true, false,
+				out var loaded, out var encoded);
+			Assert.Equal(EncoderAction.Encoded, action);
+			Assert.Equal(chunk, loaded);
+			chained += encoded;
+			independent += Encode(source.AsSpan(offset, chunk).ToArray(), LZ4Level.L02_MID).Length;
+
+			decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out var decodedLength);
+			Assert.Equal(
+				source.AsSpan(offset, chunk).ToArray(),
+				decoded.AsSpan(0, decodedLength).ToArray());
+		}
+
+		// history from previous blocks is used
+		Assert.True(chained < independent, $"chained:{chained} independent:{independent}");
+	}
+}
@@ -20,6 +20,7 @@ namespace K4os.Compression.LZ4.Tests
 		[InlineData(0x172a5, LZ4Level.L09_HC)]
 		[InlineData(0x172a5, LZ4Level.L11_OPT)]
 		[InlineData(0x172a5, LZ4Level.L12_MAX)]
+		[InlineData(0x172a5, LZ4Level.L13_ULTRA)]
 		[InlineData(Mem.M4, LZ4Level.L12_MAX)]
 		public unsafe void PickleLorem(int length, LZ4Level level = LZ4Level.L00_FAST)
 		{
@@ -0,0 +1,133 @@
+using System.Text;
+using K4os.Compression.LZ4.Encoders;
+using K4os.Compression.LZ4.Internal;
+using TestHelpers;
+
+namespace K4os.Compression.LZ4.Tests;
+
+public class RunBlockTests
+{
+	private static byte[] Words(int length, int seed = 0)
+	{
+		var words = Lorem.Text.Split(' ');
+		var random = new Random(seed);
+		var text = new StringBuilder();
+		while (text.Length < length)
+			text.Append(words[random.Next(words.Length)]).Append(' ');
+		return Encoding.ASCII.GetBytes(text.ToString(0, length));
+	}
+
+	private static byte[] Run(int length, byte value)
+	{
+		var buffer = new byte[length];
+		buffer.AsSpan().Fill(value);
+		return buffer;
+	}
+
+	// token, literal, offset, extra match length bytes, token, last literals
+	private static int RunSize(int length)
+	{
+		var matchLength = length - 1 - 5 - 4;
+		return 1 + 1 + 2 + (matchLength >= 15 ? (matchLength - 15) / 255 + 1 : 0) + 1 + 5;
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST, 13, 0, false)]
+	[InlineData(LZ4Level.L00_FAST, 24, 0, false)]
+	[InlineData(LZ4Level.L00_FAST, 25, 0, false)]
+	[InlineData(LZ4Level.L00_FAST, 25 + 255, 0xAA, false)]
+	[InlineData(LZ4Level.L00_FAST, Mem.K64, 0, false)]
+	[InlineData(LZ4Level.L00_FAST, Mem.M4, 0, true)]
+	[InlineData(LZ4Level.L02_MID, Mem.K64, 0xFF, false)]
+	[InlineData(LZ4Level.L09_HC, 1337, 0, false)]
+	[InlineData(LZ4Level.L09_HC, Mem.M1, 0, true)]
+	[InlineData(LZ4Level.L12_MAX, Mem.K64, 7, false)]
+	[InlineData(LZ4Level.L13_ULTRA, Mem.M1, 0, false)]
+	public void RunBlocksAreEncodedAsSingleMatch(LZ4Level level, int length, byte value, bool enforce32)
+	{
+		LZ4Codec.Enforce32 = enforce32;
+		try
+		{
+			var source = Run(length, value);
+			var encoded = new byte[LZ4Codec.MaximumOutputSize(length)];
+			var encodedLength = LZ4Codec.Encode(source, encoded, level);
+			Assert.Equal(RunSize(length), encodedLength);
+
+			var stats = LZ4Analyzer.Block(encoded.AsSpan(0, encodedLength));
+			Assert.Equal(1, stats.Matches);
+
+			var decoded = new byte[length];
+			Assert.Equal(length, LZ4Codec.Decode(encoded, 0, encodedLength, decoded, 0, length));
+			Assert.Equal(source, decoded);
+		}
+		finally
+		{
+			LZ4Codec.Enforce32 = false;
+		}
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST)]
+	[InlineData(LZ4Level.L09_HC)]
+	public void RunBlockFailsWhenTargetIsTooSmall(LZ4Level level)
+	{
+		var source = Run(Mem.K64, 0);
+		var encoded = new byte[RunSize(source.Length) - 1];
+		Assert.True(LZ4Codec.Encode(source, encoded, level) <= 0);
+	}
+
+	[Fact]
+	public void AlmostRunBlocksAreStillEncodedCorrectly()
+	{
+		var source = Run(Mem.K64, 0);
+		source[source.Length - 1] = 1;
+		var encoded = new byte[LZ4Codec.MaximumOutputSize(source.Length)];
+		var encodedLength = LZ4Codec.Encode(source, encoded, LZ4Level.L00_FAST);
+		var decoded = new byte[source.Length];
+		Assert.Equal(source.Length, LZ4Codec.Decode(encoded, 0, encodedLength, decoded, 0, source.Length));
+		Assert.Equal(source, decoded);
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST)]
+	[InlineData(LZ4Level.L02_MID)]
+	[InlineData(LZ4Level.L09_HC)]
+	[InlineData(LZ4Level.L11_OPT)]
+	public void RunBlocksCanBeChained(LZ4Level level)
+	{
+		const int blockSize = Mem.K64;
+		var words = Words(blockSize);
+		var zeros = Run(blockSize, 0);
+		// runs between regular blocks, which still reference each other
+		var source = words.Concat(zeros).Concat(words).Concat(zeros).Concat(zeros).Concat(words).ToArray();
+
+		using var encoder = LZ4Encoder.Create(true, level, blockSize);
+		using var decoder = LZ4Decoder.Create(true, blockSize);
+
+		var target = new byte[LZ4Codec.MaximumOutputSize(blockSize)];
+		var decoded = new byte[blockSize];
+
+		for (var offset = 0; offset < source.Length; offset += blockSize)
+		{
+			var chunk = source.AsSpan(offset, blockSize);
+			var action = encoder.TopupAndEncode(
+				chunk, target, true, false, out _, out var encoded);
+			Assert.Equal(EncoderAction.Encoded, action);
+			if (chunk[0] == 0) Assert.Equal(RunSize(blockSize), encoded);
+
+			decoder.DecodeAndDrain(target.AsSpan(0, encoded), decoded, out _);
+			Assert.Equal(chunk.ToArray(), decoded);
+		}
+	}
+
+	[Theory]
+	[InlineData(LZ4Level.L00_FAST)]
+	[InlineData(LZ4Level.L12_MAX)]
+	public void RunPicklesAreCompact(LZ4Level level)
+	{
+		var source = Run(Mem.M1, 0);
+		var pickled = LZ4Pickler.Pickle(source, level);
+		Assert.True(pickled.Length < RunSize(source.Length) + 8);
+		Assert.Equal(source, LZ4Pickler.Unpickle(pickled));
+	}
+}
@@ -0,0 +1,197 @@
+using K4os.Compression.LZ4.Engine;
+using K4os.Compression.LZ4.Internal;
+
+namespace K4os.Compression.LZ4.Encoders;
+
+// fast and high encoder contexts
+using LZ4FastContext = LL.LZ4_stream_t;
+using LZ4HighContext = LL.LZ4_streamHC_t;
+
+/// <summary>
+/// LZ4 encoder which allows compression level to be changed between blocks
+/// (see <see cref="Level"/>), so it can follow changing data or CPU budget while still
+/// producing single stream. With dependent blocks it keeps contexts of both fast and high
+/// compressors. Changing between HC and optimal levels is free, but when switching to fast
+/// compressor (or between mid and HC compressors, which use different tables) last 64KB
+/// of data needs to be loaded into other context, so it should not happen on every block.
+/// </summary>
+public unsafe class LZ4AdaptiveEncoder: LZ4EncoderBase
+{
+	private enum Compressor { None, Fast, Mid, High }
+
+	private readonly bool _chaining;
+
+	private PinnedMemory _fastPin;
+	private PinnedMemory _highPin;
+	private PinnedMemory _optPin;
+	private int _optNum;
+
+	private LZ4Level _level;
+	private Compressor _active;
+
+	// start of data preceding next block (blocks are contiguous in input buffer)
+	private byte* _history;
+
+	private LZ4FastContext* FastContext => _fastPin.Reference<LZ4FastContext>();
+	private LZ4HighContext* HighContext => _highPin.Reference<LZ4HighContext>();
+
+	/// <summary>Creates new instance of <see cref="LZ4AdaptiveEncoder"/></summary>
+	/// <param name="chaining">Needs to be <c>true</c> if using dependent blocks.</param>
+	/// <param name="level">Initial compression level.</param>
+	/// <param name="blockSize">Block size.</param>
+	/// <param name="extraBlocks">Number of extra blocks.</param>
+	public LZ4AdaptiveEncoder(
+		bool chaining, LZ4Level level, int blockSize, int extraBlocks = 0):
+		base(chaining, blockSize, extraBlocks)
+	{
+		_chaining = chaining;
+		Level = level;
+	}
+
+	/// <summary>
+	/// Compression level used for next block. It can be changed at any time, data already
+	/// buffered (see <see cref="ILZ4Encoder.BytesReady"/>) will be compressed with new level.
+	/// </summary>
+	public LZ4Level Level
+	{
+		get => _level;
+		set => _level =
+			value < LZ4Level.L00_FAST ? LZ4Level.L00_FAST :
+			value > LZ4Level.L13_ULTRA ? LZ4Level.L13_ULTRA :
+			value;
+	}
+
+	/// <summary>
+	/// Optional controller choosing level of next block. Encoder does not use it on its own,
+	/// it is fed with measurements by whoever drives the encoder (for example frame writer).
+	/// </summary>
+	public LZ4LevelController Controller { get; set; }
+
+	private static Compressor CompressorFor(LZ4Level level) =>
+		level < LZ4Level.L02_MID ? Compressor.Fast :
+		level < LZ4Level.L03_HC ? Compressor.Mid :
+		Compressor.High;
+
+	/// <inheritdoc />
+	protected override void ReleaseUnmanaged()
+	{
+		base.ReleaseUnmanaged();
+		_fastPin.Free();
+		_highPin.Free();
+		_optPin.Free();
+	}
+
+	/// <inheritdoc />
+	protected override int EncodeBlock(
+		byte* source, int sourceLength, byte* target, int targetLength)
+	{
+		if (!_chaining)
+			return LZ4Codec.EncodeBlock(source, sourceLength, target, targetLength, _level);
+
+		var compressor = Activate(source);
+		var encoded = compressor == Compressor.Fast
+			? LLxx.LZ4_compress_fast_continue(
+				FastContext, source, target, sourceLength, targetLength, 1)
+			: LLxx.LZ4_compress_HC_continue(
+				HighContext, source, target, sourceLength, targetLength);
+		if (_history == null) _history = source;
+
+		return encoded;
+	}
+
+	/// <inheritdoc />
+	protected override bool SkipBlock(byte* source, int sourceLength, byte* target)
+	{
+		// same as LZ4BlockEncoder and LZ4HighChainEncoder, only HC levels skip blocks
+		if (_level < LZ4Level.L03_HC || !IsIncompressible(source, sourceLength, target))
+			return false;
+
+		if (!_chaining)
+			return true;
+
+		Activate(source);
+		LL.LZ4_skipBlockHC(HighContext, source, sourceLength);
+		if (_history == null) _history = source;
+
+		return true;
+	}
+
+	/// <inheritdoc />
+	protected override int CopyDict(byte* target, int length)
+	{
+		if (!_chaining)
+			return 0;
+
+		var dictionaryLength = _active == Compressor.Fast
+			? LL.LZ4_saveDict(FastContext, target, length)
+			: LL.LZ4_saveDictHC(HighContext, target, length);
+		_history = target;
+
+		return dictionaryLength;
+	}
+
+	/// <summary>
+	/// Makes sure compressor for current level holds history (and is set to current level).
+	/// </summary>
+	private Compressor Activate(byte* source)
+	{
+		var compressor = CompressorFor(_level);
+
+		if (compressor == Compressor.High && _level >= LZ4Level.L10_OPT)
+			AttachOptimalState();
+
+		if (compressor == _active)
+		{
+			if (compressor != Compressor.Fast)
+				LL.LZ4_setCompressionLevel(HighContext, (int) _level);
+			return compressor;
+		}
+
+		var historyLength = _history == null ? 0 : (int) Math.Min(source - _history, Mem.K64);
+		var history = source - historyLength;
+
+		if (compressor == Compressor.Fast)
+		{
+			if (_fastPin.Pointer == null)
+				PinnedMemory.Alloc<LZ4FastContext>(out _fastPin, false);
+			LLxx.LZ4_loadDict(FastContext, history, historyLength);
+		}
+		else
+		{
+			AllocateHighContext();
+			LL.LZ4_setCompressionLevel(HighContext, (int) _level);
+			LL.LZ4_loadDictHC(HighContext, history, historyLength);
+		}
+
+		_active = compressor;
+		return compressor;
+	}
+
+	private void AllocateHighContext()
+	{
+		if (_highPin.Pointer != null)
+			return;
+
+		PinnedMemory.Alloc<LZ4HighContext>(out _highPin, false);
+		LL.LZ4_initStreamHC(HighContext);
+	}
+
+	private void AttachOptimalState()
+	{
+		AllocateHighContext();
+
+		var optNum = LL.LZ4HC_getOptNum((int) _level, 0);
+		if (optNum == _optNum)
+			return;
+
+		var size = LL.LZ4_sizeofStateOptHC(optNum, false);
+		if (_optPin.Pointer == null || _optPin.Span.Length < size)
+		{
+			_optPin.Free();
+			PinnedMemory.Alloc(out _optPin, size, false);
+		}
+
+		LL.LZ4_attachOptHC(HighContext, LL.LZ4_initStateOptHC(_optPin.Pointer, optNum, false));
+		_optNum = optNum;
+	}
+}
@@ -46,7 +46,7 @@ public unsafe class LZ4BlockDecoder: UnmanagedResources, ILZ4Decoder
 		if (blockSize > _blockSize)
 			throw new InvalidOperationException();
 
-		var decoded = LZ4Codec.Decode(source, length, OutputBuffer, _outputLength);
+		var decoded = LZ4Codec.DecodeBlock(source, length, OutputBuffer, _outputLength);
 		if (decoded < 0)
 			throw new InvalidOperationException();
 
@@ -7,6 +7,7 @@
 public unsafe class LZ4BlockEncoder: LZ4EncoderBase
 {
 	private readonly LZ4Level _level;
+	private readonly LZ4CompressionParameters _parameters;
 
 	/// <summary>Creates new instance of <see cref="LZ4BlockEncoder"/></summary>
 	/// <param name="level">Compression level.</param>
@@ -14,10 +15,30 @@ public unsafe class LZ4BlockEncoder: LZ4EncoderBase
 	public LZ4BlockEncoder(LZ4Level level, int blockSize): base(false, blockSize, 0) => 
 		_level = level;
 
+	/// <summary>Creates new instance of <see cref="LZ4BlockEncoder"/></summary>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <param name="blockSize">Block size.</param>
+	public LZ4BlockEncoder(LZ4CompressionParameters parameters, int blockSize):
+		base(false, blockSize, 0)
+	{
+		_parameters = parameters.Clone();
+		_level = _parameters.Level;
+	}
+
 	/// <inheritdoc />
 	protected override int EncodeBlock(
 		byte* source, int sourceLength, byte* target, int targetLength) =>
-		LZ4Codec.Encode(source, sourceLength, target, targetLength, _level);
+		_parameters is null
+			? LZ4Codec.EncodeBlock(source, sourceLength, target, targetLength, _level)
+			: LZ4Codec.EncodeBlock(source, sourceLength, target, targetLength, _parameters);
+
+	/// <inheritdoc />
+	protected override bool SkipBlock(byte* source, int sourceLength, byte* target)
+	{
+		// fast and mid compressors skip over incompressible data on their own (quickly enough)
+		return _level >= LZ4Level.L03_HC
+			&& IsIncompressible(source, sourceLength, target);
+	}
 
 	/// <inheritdoc />
 	protected override int CopyDict(byte* target, int dictionaryLength) => 0;
@@ -14,9 +14,23 @@ public static class LZ4Encoder
 	public static ILZ4Encoder Create(
 		bool chaining, LZ4Level level, int blockSize, int extraBlocks = 0) =>
 		!chaining ? CreateBlockEncoder(level, blockSize) :
-			level < LZ4Level.L03_HC 
-				? CreateFastEncoder(blockSize, extraBlocks) 
-				: CreateHighEncoder(level, blockSize, extraBlocks);
+			level < LZ4Level.L02_MID ? CreateFastEncoder(blockSize, extraBlocks) :
+			level < LZ4Level.L03_HC ? CreateMidEncoder(blockSize, extraBlocks) :
+			CreateHighEncoder(level, blockSize, extraBlocks);
+
+	/// <summary>Creates appropriate decoder for given parameters.</summary>
+	/// <param name="chaining">Dependent blocks.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <param name="blockSize">Block size.</param>
+	/// <param name="extraBlocks">Number of extra blocks.</param>
+	/// <returns>LZ4 encoder.</returns>
+	public static ILZ4Encoder Create(
+		bool chaining, LZ4CompressionParameters parameters, int blockSize, int extraBlocks = 0) =>
+		!chaining ? new LZ4BlockEncoder(parameters, blockSize) :
+			parameters.Level < LZ4Level.L02_MID ?
+				new LZ4FastChainEncoder(parameters, blockSize, extraBlocks) :
+			parameters.Level < LZ4Level.L03_HC ? CreateMidEncoder(blockSize, extraBlocks) :
+			new LZ4HighChainEncoder(parameters, blockSize, extraBlocks);
 
 	private static ILZ4Encoder CreateBlockEncoder(LZ4Level level, int blockSize) =>
 		new LZ4BlockEncoder(level, blockSize);
@@ -24,6 +38,9 @@ public static class LZ4Encoder
 	private static ILZ4Encoder CreateFastEncoder(int blockSize, int extraBlocks) =>
 		new LZ4FastChainEncoder(blockSize, extraBlocks);
 
+	private static ILZ4Encoder CreateMidEncoder(int blockSize, int extraBlocks) =>
+		new LZ4MidChainEncoder(blockSize, extraBlocks);
+
 	private static ILZ4Encoder CreateHighEncoder(
 		LZ4Level level, int blockSize, int extraBlocks) => 
 		new LZ4HighChainEncoder(level, blockSize, extraBlocks);
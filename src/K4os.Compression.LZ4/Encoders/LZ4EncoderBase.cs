@@ -6,7 +6,7 @@ namespace K4os.Compression.LZ4.Encoders;
 /// <summary>
 /// Base class for LZ4 encoders. Provides basic functionality shared by
 /// <see cref="LZ4BlockEncoder"/>, <see cref="LZ4FastChainEncoder"/>,
-/// and <see cref="LZ4HighChainEncoder"/> encoders. Do not used directly.
+/// <see cref="LZ4MidChainEncoder"/>, and <see cref="LZ4HighChainEncoder"/> encoders. Do not used directly.
 /// </summary>
 public abstract unsafe class LZ4EncoderBase: UnmanagedResources, ILZ4Encoder
 {
@@ -14,6 +14,7 @@ public abstract unsafe class LZ4EncoderBase: UnmanagedResources, ILZ4Encoder
 	
 	private readonly int _inputLength;
 	private readonly int _blockSize;
+	private readonly bool _chaining;
 
 	private int _inputIndex;
 	private int _inputPointer;
@@ -31,6 +32,7 @@ public abstract unsafe class LZ4EncoderBase: UnmanagedResources, ILZ4Encoder
 		var dictSize = chaining ? Mem.K64 : 0;
 
 		_blockSize = blockSize;
+		_chaining = chaining;
 		_inputLength = dictSize + (1 + extraBlocks) * blockSize + 32;
 		_inputIndex = _inputPointer = 0;
 		PinnedMemory.Alloc(out _inputBufferPin, _inputLength + 8, false);
@@ -70,13 +72,21 @@ public abstract unsafe class LZ4EncoderBase: UnmanagedResources, ILZ4Encoder
 		if (sourceLength <= 0)
 			return 0;
 
-		var encoded = EncodeBlock(InputBuffer + _inputIndex, sourceLength, target, length);
+		var source = InputBuffer + _inputIndex;
 
-		if (encoded <= 0)
+		// when block can be stored uncompressed, output is capped at source length, so
+		// compressor gives up as soon as it knows block does not compress (or does not even
+		// start, if block looks incompressible)
+		var copyable = allowCopy && length >= sourceLength;
+		var encoded =
+			copyable && SkipBlock(source, sourceLength, target) ? 0 :
+			EncodeBlock(source, sourceLength, target, copyable ? sourceLength : length);
+
+		if (encoded <= 0 && !copyable)
 			throw new InvalidOperationException(
 				"Failed to encode chunk. Target buffer too small.");
 
-		if (allowCopy && encoded >= sourceLength)
+		if (copyable && (encoded <= 0 || encoded >= sourceLength))
 		{
 			Mem.Move(target, InputBuffer + _inputIndex, sourceLength);
 			encoded = -sourceLength;
@@ -105,6 +115,34 @@ public abstract unsafe class LZ4EncoderBase: UnmanagedResources, ILZ4Encoder
 	protected abstract int EncodeBlock(
 		byte* source, int sourceLength, byte* target, int targetLength);
 
+	/// <summary>
+	/// Checks if block should be stored uncompressed without even trying to compress it
+	/// (see <see cref="Compressibility"/>). If so, encoder needs to update its state as if
+	/// block was compressed (in chained encoders following blocks can reference it).
+	/// Default implementation always returns <c>false</c>.
+	/// </summary>
+	/// <param name="source">Source buffer.</param>
+	/// <param name="sourceLength">Source buffer length.</param>
+	/// <param name="target">Target buffer (at least <paramref name="sourceLength"/> long),
+	/// it can be used as scratch buffer.</param>
+	/// <returns><c>true</c> if block was skipped.</returns>
+	protected virtual bool SkipBlock(byte* source, int sourceLength, byte* target) => false;
+
+	/// <summary>
+	/// Checks if block is not worth compressing (see
+	/// <see cref="Compressibility.IsIncompressible(byte*,int,int,byte*)"/>). With dependent
+	/// blocks, data preceding block in input buffer is taken into account as well.
+	/// </summary>
+	/// <param name="source">Source buffer.</param>
+	/// <param name="sourceLength">Source buffer length.</param>
+	/// <param name="target">Target buffer (at least <paramref name="sourceLength"/> long).</param>
+	/// <returns><c>true</c> if block is incompressible.</returns>
+	protected bool IsIncompressible(byte* source, int sourceLength, byte* target)
+	{
+		var historyLength = _chaining ? (int)Math.Min(source - InputBuffer, Mem.K64) : 0;
+		return Compressibility.IsIncompressible(source, sourceLength, historyLength, target);
+	}
+
 	/// <summary>Copies current dictionary.</summary>
 	/// <param name="target">Target buffer.</param>
 	/// <param name="dictionaryLength">Dictionary length.</param>
@@ -12,6 +12,8 @@ using LZ4Context = LL.LZ4_stream_t;
 public unsafe class LZ4FastChainEncoder: LZ4EncoderBase
 {
 	private PinnedMemory _contextPin;
+	private readonly int _acceleration = 1;
+	private readonly int _hashLog = LZ4CompressionParameters.MaxHashLog;
 
 	private LZ4Context* Context => _contextPin.Reference<LZ4Context>();
 
@@ -24,6 +26,18 @@ public unsafe class LZ4FastChainEncoder: LZ4EncoderBase
 		PinnedMemory.Alloc<LZ4Context>(out _contextPin);
 	}
 
+	/// <summary>Creates new instance of <see cref="LZ4FastChainEncoder"/></summary>
+	/// <param name="parameters">Compression parameters (acceleration and hash log).</param>
+	/// <param name="blockSize">Block size.</param>
+	/// <param name="extraBlocks">Number of extra blocks.</param>
+	public LZ4FastChainEncoder(
+		LZ4CompressionParameters parameters, int blockSize, int extraBlocks = 0):
+		this(blockSize, extraBlocks)
+	{
+		_acceleration = parameters.Acceleration;
+		_hashLog = parameters.HashLog;
+	}
+
 	/// <inheritdoc />
 	protected override void ReleaseUnmanaged()
 	{
@@ -34,7 +48,8 @@ public unsafe class LZ4FastChainEncoder: LZ4EncoderBase
 	/// <inheritdoc />
 	protected override int EncodeBlock(
 		byte* source, int sourceLength, byte* target, int targetLength) =>
-		LLxx.LZ4_compress_fast_continue(Context, source, target, sourceLength, targetLength, 1);
+		LLxx.LZ4_compress_fast_continue(
+			Context, source, target, sourceLength, targetLength, _acceleration, _hashLog);
 
 	/// <inheritdoc />
 	protected override int CopyDict(byte* target, int length) =>
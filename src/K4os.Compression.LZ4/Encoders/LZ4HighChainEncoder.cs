@@ -12,6 +12,7 @@ using LZ4Context = LL.LZ4_streamHC_t;
 public unsafe class LZ4HighChainEncoder: LZ4EncoderBase
 {
 	private PinnedMemory _contextPin;
+	private PinnedMemory _optPin;
 
 	private LZ4Context* Context => _contextPin.Reference<LZ4Context>();
 
@@ -20,20 +21,48 @@ public unsafe class LZ4HighChainEncoder: LZ4EncoderBase
 	/// <param name="blockSize">Block size.</param>
 	/// <param name="extraBlocks">Number of extra blocks.</param>
 	public LZ4HighChainEncoder(LZ4Level level, int blockSize, int extraBlocks = 0):
+		this(level, blockSize, extraBlocks, 0, false) { }
+
+	private LZ4HighChainEncoder(
+		LZ4Level level, int blockSize, int extraBlocks, int parseWindow, bool binaryTree):
 		base(true, blockSize, extraBlocks)
 	{
 		if (level < LZ4Level.L03_HC) level = LZ4Level.L03_HC;
-		if (level > LZ4Level.L12_MAX) level = LZ4Level.L12_MAX;
+		if (level > LZ4Level.L13_ULTRA) level = LZ4Level.L13_ULTRA;
 		PinnedMemory.Alloc<LZ4Context>(out _contextPin, false);
 		LL.LZ4_initStreamHC(Context);
+		if (level >= LZ4Level.L10_OPT)
+		{
+			parseWindow = LL.LZ4HC_getOptNum((int) level, parseWindow);
+			PinnedMemory.Alloc(
+				out _optPin, LL.LZ4_sizeofStateOptHC(parseWindow, binaryTree), false);
+			LL.LZ4_attachOptHC(
+				Context, LL.LZ4_initStateOptHC(_optPin.Pointer, parseWindow, binaryTree));
+		}
 		LL.LZ4_resetStreamHC_fast(Context, (int) level);
 	}
 
+	/// <summary>Creates new instance of <see cref="LZ4HighChainEncoder"/></summary>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <param name="blockSize">Block size.</param>
+	/// <param name="extraBlocks">Number of extra blocks.</param>
+	public LZ4HighChainEncoder(
+		LZ4CompressionParameters parameters, int blockSize, int extraBlocks = 0):
+		this(
+			parameters.Level, blockSize, extraBlocks,
+			parameters.ParseWindow ?? 0, parameters.BinaryTreeMatchFinder)
+	{
+		LL.LZ4_setSearchParameters(
+			Context, parameters.SearchDepth ?? 0, parameters.TargetLength ?? 0);
+		LL.LZ4_favorDecompressionSpeed(Context, parameters.FavorDecompressionSpeed ? 1 : 0);
+	}
+
 	/// <inheritdoc />
 	protected override void ReleaseUnmanaged()
 	{
 		base.ReleaseUnmanaged();
 		_contextPin.Free();
+		_optPin.Free();
 	}
 
 	/// <inheritdoc />
@@ -41,6 +70,16 @@ public unsafe class LZ4HighChainEncoder: LZ4EncoderBase
 		byte* source, int sourceLength, byte* target, int targetLength) =>
 		LLxx.LZ4_compress_HC_continue(Context, source, target, sourceLength, targetLength);
 
+	/// <inheritdoc />
+	protected override bool SkipBlock(byte* source, int sourceLength, byte* target)
+	{
+		if (!IsIncompressible(source, sourceLength, target))
+			return false;
+
+		LL.LZ4_skipBlockHC(Context, source, sourceLength);
+		return true;
+	}
+
 	/// <inheritdoc />
 	protected override int CopyDict(byte* target, int length) =>
 		LL.LZ4_saveDictHC(Context, target, length);
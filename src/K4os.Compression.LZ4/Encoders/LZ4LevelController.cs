@@ -0,0 +1,188 @@
+using System;
+using System.Linq;
+
+namespace K4os.Compression.LZ4.Encoders;
+
+/// <summary>
+/// Chooses compression level of next block (for <see cref="LZ4AdaptiveEncoder"/>) from
+/// measurements of previous blocks: time spent compressing, time spent elsewhere (producing
+/// and writing data) and achieved compression ratio. It remembers recent cost of every level
+/// it has used, so it does not keep trying levels which turned out to be too slow. When
+/// compression takes more than twice its budget it falls back to fastest level straight
+/// away, otherwise it moves one level at a time. Blocks which do not compress (ratio above
+/// 90%) make it go down as well, as higher levels would not get much better.
+/// With backpressure enabled, time spent writing blocks is a budget as well, so level goes up
+/// when inner stream is the bottleneck and goes down when compression is.
+/// It is not thread-safe, every encoder needs its own controller.
+/// </summary>
+public class LZ4LevelController
+{
+	/// <summary>Compression using more than this share of its budget falls back to fastest level.</summary>
+	private const double PressureLoad = 2;
+
+	/// <summary>Level which has not been used recently is tried only when current one is that cheap.</summary>
+	private const double RaiseLoad = 0.5;
+
+	/// <summary>Blocks compressed worse than that are not worth higher levels.</summary>
+	private const double PoorRatio = 0.9;
+
+	/// <summary>Number of blocks compressed with new level before trying higher one.</summary>
+	private const int SettleBlocks = 2;
+
+	/// <summary>Number of blocks after which cost of level is forgotten (data might have changed).</summary>
+	private const int MemoryBlocks = 64;
+
+	/// <summary>Reason of level change: compression took more than twice its budget.</summary>
+	public const string Overloaded = "overloaded";
+
+	/// <summary>Reason of level change: compression took longer than its budget.</summary>
+	public const string Slow = "slow";
+
+	/// <summary>Reason of level change: blocks did not compress.</summary>
+	public const string Incompressible = "incompressible";
+
+	/// <summary>Reason of level change: compression took much less than its budget.</summary>
+	public const string Headroom = "headroom";
+
+	private readonly LZ4Level[] _levels;
+	private readonly double _targetThroughput;
+	private readonly double _targetCpuShare;
+	private readonly bool _backpressure;
+
+	private readonly double[] _cost; // seconds per byte
+	private readonly long[] _measured; // block number
+	private double _idle; // seconds per byte
+	private double _write; // seconds per byte
+
+	private int _index;
+	private long _blocks;
+	private long _changed;
+
+	/// <summary>Creates new instance of <see cref="LZ4LevelController"/>.</summary>
+	/// <param name="parameters">Adaptive level parameters.</param>
+	/// <param name="level">Initial level (it is clamped to allowed levels).</param>
+	public LZ4LevelController(LZ4AdaptiveParameters parameters, LZ4Level level)
+	{
+		if (parameters.TargetThroughput is not > 0 &&
+			parameters.TargetCpuShare is not > 0 &&
+			!parameters.Backpressure)
+			throw new ArgumentException(
+				"Adaptive compression level needs throughput, CPU share or backpressure target");
+
+		var minLevel = parameters.MinLevel;
+		var maxLevel = parameters.MaxLevel < minLevel ? minLevel : parameters.MaxLevel;
+		var levels = Enum.GetValues(typeof(LZ4Level))
+			.Cast<LZ4Level>()
+			.Where(l => l >= minLevel && l <= maxLevel)
+			.Distinct()
+			.OrderBy(l => l)
+			.ToArray();
+
+		_levels = levels.Length > 0 ? levels : new[] { LZ4Level.L00_FAST };
+		_targetThroughput = parameters.TargetThroughput ?? 0;
+		_targetCpuShare = parameters.TargetCpuShare ?? 0;
+		_backpressure = parameters.Backpressure;
+		_cost = new double[_levels.Length];
+		_measured = new long[_levels.Length];
+		_index = Math.Max(0, Array.FindLastIndex(_levels, l => l <= level));
+	}
+
+	/// <summary>Level to be used for next block.</summary>
+	public LZ4Level Level => _levels[_index];
+
+	/// <summary>
+	/// Reason of last level change (<see cref="Overloaded"/>, <see cref="Slow"/>,
+	/// <see cref="Incompressible"/> or <see cref="Headroom"/>), <c>null</c> if level
+	/// has not been changed yet.
+	/// </summary>
+	public string Reason { get; private set; }
+
+	/// <summary>Records block compressed with current <see cref="Level"/>.</summary>
+	/// <param name="bytesIn">Uncompressed length of block.</param>
+	/// <param name="bytesOut">Compressed length of block.</param>
+	/// <param name="seconds">Time spent compressing block.</param>
+	/// <param name="elapsed">Time elapsed since previous block was compressed (including
+	/// compression of this one).</param>
+	/// <param name="written">Time spent writing blocks to inner stream since previous
+	/// block was compressed (used with backpressure only, <c>0</c> if unknown).</param>
+	/// <returns>Level to be used for next block.</returns>
+	public LZ4Level Update(
+		int bytesIn, int bytesOut, double seconds, double elapsed, double written = 0)
+	{
+		if (bytesIn <= 0)
+			return Level;
+
+		_blocks++;
+
+		var cost = Math.Max(seconds, 0) / bytesIn;
+		var idle = Math.Max(elapsed - seconds, 0) / bytesIn;
+		_cost[_index] = Known(_index) ? (_cost[_index] + cost) / 2 : cost;
+		_measured[_index] = _blocks;
+		_idle = _blocks > 1 ? (_idle + idle) / 2 : idle;
+
+		// writes complete asynchronously, so some blocks see none and some see few of them
+		var write = Math.Max(written, 0) / bytesIn;
+		if (write > 0) _write = _write > 0 ? (_write + write) / 2 : write;
+
+		var load = Load(_index);
+
+		return
+			load > PressureLoad ? Change(0, Overloaded) :
+			load > 1 ? Change(Lower(), Slow) :
+			bytesOut >= bytesIn * PoorRatio ? Change(_index - 1, Incompressible) :
+			CanRaise(load) ? Change(_index + 1, Headroom) :
+			Level;
+	}
+
+	private bool Known(int index) =>
+		_measured[index] > 0 && _blocks - _measured[index] < MemoryBlocks;
+
+	/// <summary>
+	/// Ratio of (expected) cost of given level to its budget, above <c>1</c> means
+	/// level is too slow.
+	/// </summary>
+	private double Load(int index)
+	{
+		var cost = _cost[index];
+		var load = 0.0;
+		if (_targetThroughput > 0)
+			load = cost * _targetThroughput;
+		if (_targetCpuShare > 0 && cost > 0)
+			load = Math.Max(load, cost / (cost + _idle) / _targetCpuShare);
+		if (_backpressure && _write > 0)
+			load = Math.Max(load, cost / _write);
+		return load;
+	}
+
+	private int Lower()
+	{
+		// highest lower level which is known to fit in the budget
+		for (var i = _index - 1; i >= 0; i--)
+			if (Known(i) && Load(i) <= 1)
+				return i;
+
+		return _index - 1;
+	}
+
+	private bool CanRaise(double load)
+	{
+		var next = _index + 1;
+		if (next >= _levels.Length || _blocks - _changed < SettleBlocks)
+			return false;
+
+		return Known(next) ? Load(next) <= 1 : load < RaiseLoad;
+	}
+
+	private LZ4Level Change(int index, string reason)
+	{
+		index = Math.Max(0, Math.Min(index, _levels.Length - 1));
+		if (index != _index)
+		{
+			_index = index;
+			_changed = _blocks;
+			Reason = reason;
+		}
+
+		return Level;
+	}
+}
@@ -19,11 +19,57 @@ namespace K4os.Compression.LZ4.Engine
 		[MethodImpl(MethodImplOptions.AggressiveInlining)]
 		public static int LZ4_sizeofStateHC() => sizeof(LZ4_streamHC_t);
 
+		/* parse window used by given level, unless set explicitly */
+		public static int LZ4HC_getOptNum(int cLevel, int optNum) =>
+			optNum > 0 ? optNum :
+			cLevel >= LZ4HC_CLEVEL_ULTRA ? LZ4_OPT_NUM_ULTRA :
+			LZ4_OPT_NUM;
+
+		private static int LZ4HC_clampOptNum(int optNum) =>
+			optNum <= 0 ? LZ4_OPT_NUM :
+			optNum < LZ4_OPT_NUM_MIN ? LZ4_OPT_NUM_MIN :
+			optNum > LZ4_OPT_NUM_ULTRA ? LZ4_OPT_NUM_ULTRA :
+			optNum;
+
+		private static int LZ4HC_sizeofOptHeader() => (sizeof(LZ4HC_opt_t) + 15) & ~15;
+
+		public static int LZ4_sizeofStateOptHC(int optNum, bool binaryTree) =>
+			LZ4HC_sizeofOptHeader()
+			+ (LZ4HC_clampOptNum(optNum) + LZ4HC_OPT_TRAILING_LITERALS) * sizeof(LZ4HC_optimal_t)
+			+ (binaryTree ? 2 * LZ4HC_MAXD * sizeof(ushort) : 0);
+
+		/* lays out state of optimal parser in given buffer, which needs to be at least
+		 * LZ4_sizeofStateOptHC(optNum, binaryTree) bytes; optNum of 0 means default */
+		public static LZ4HC_opt_t* LZ4_initStateOptHC(void* buffer, int optNum, bool binaryTree)
+		{
+			if (buffer == null) return null;
+
+			optNum = LZ4HC_clampOptNum(optNum);
+			LZ4HC_opt_t* state = (LZ4HC_opt_t*) buffer;
+			LZ4HC_optimal_t* parse = (LZ4HC_optimal_t*) ((byte*) buffer + LZ4HC_sizeofOptHeader());
+			state->optNum = optNum;
+			state->parse = parse;
+			state->binTree = null;
+			state->binTreeLow = 0;
+			if (binaryTree)
+			{
+				state->binTree = (ushort*) (parse + optNum + LZ4HC_OPT_TRAILING_LITERALS);
+				Mem.Zero((byte*) state->binTree, 2 * LZ4HC_MAXD * sizeof(ushort));
+			}
+
+			return state;
+		}
+
+		public static void LZ4_attachOptHC(LZ4_streamHC_t* LZ4_streamHCPtr, LZ4HC_opt_t* opt)
+		{
+			LZ4_streamHCPtr->opt = opt;
+		}
+
 		public static void LZ4_setCompressionLevel(
 			LZ4_streamHC_t* LZ4_streamHCPtr, int compressionLevel)
 		{
 			if (compressionLevel < 1) compressionLevel = LZ4HC_CLEVEL_DEFAULT;
-			if (compressionLevel > LZ4HC_CLEVEL_MAX) compressionLevel = LZ4HC_CLEVEL_MAX;
+			if (compressionLevel > LZ4HC_CLEVEL_ULTRA) compressionLevel = LZ4HC_CLEVEL_ULTRA;
 			LZ4_streamHCPtr->compressionLevel = (short) compressionLevel;
 		}
 
@@ -31,6 +77,13 @@ namespace K4os.Compression.LZ4.Engine
 		{
 			LZ4_streamHCPtr->favorDecSpeed = (favor != 0);
 		}
+
+		public static void LZ4_setSearchParameters(
+			LZ4_streamHC_t* LZ4_streamHCPtr, int nbSearches, int targetLength)
+		{
+			LZ4_streamHCPtr->nbSearches = nbSearches < 0 ? 0 : (uint) nbSearches;
+			LZ4_streamHCPtr->targetLength = targetLength < 0 ? 0 : (uint) targetLength;
+		}
 		
 		/*
 		Memory allocation has been moved to array pool, but I keep these methods for reference.
@@ -62,6 +115,9 @@ namespace K4os.Compression.LZ4.Engine
 			LZ4_streamHCPtr->end = (byte*) -1;
 			LZ4_streamHCPtr->@base = null;
 			LZ4_streamHCPtr->dictCtx = null;
+			LZ4_streamHCPtr->opt = null;
+			LZ4_streamHCPtr->nbSearches = 0;
+			LZ4_streamHCPtr->targetLength = 0;
 			LZ4_streamHCPtr->favorDecSpeed = false;
 			LZ4_streamHCPtr->dirty = false;
 			LZ4_setCompressionLevel(LZ4_streamHCPtr, LZ4HC_CLEVEL_DEFAULT);
@@ -76,7 +132,9 @@ namespace K4os.Compression.LZ4.Engine
 		{
 			if (LZ4_streamHCPtr->dirty)
 			{
+				LZ4HC_opt_t* opt = LZ4_streamHCPtr->opt;
 				LZ4_initStreamHC(LZ4_streamHCPtr);
+				LZ4_streamHCPtr->opt = opt;
 			}
 			else
 			{
@@ -119,11 +177,58 @@ namespace K4os.Compression.LZ4.Engine
 			}
 
 			hc4->nextToUpdate = target;
+			LZ4HC_skipBinTree(hc4, target);
+		}
+
+		/* positions below target are not (or no longer) in binary tree, so tree cannot be
+		 * followed to them; tree continues from there once nextToUpdate catches up */
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		private static void LZ4HC_skipBinTree(LZ4_streamHC_t* hc4, uint target)
+		{
+			LZ4HC_opt_t* opt = hc4->opt;
+			if (opt != null && opt->binTreeLow < target) opt->binTreeLow = target;
+		}
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static uint LZ4MID_hash4Ptr(void* ptr) =>
+			(Mem.Peek4(ptr) * 2654435761U) >> (32 - LZ4MID_HASHLOG);
+
+		/* note: hashes lower 56 bits (input is read as little endian) */
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static uint LZ4MID_hash8Ptr(void* ptr) =>
+			(uint) (((Mem.Peek8(ptr) << (64 - 56)) * 58295818150454627UL) >> (64 - LZ4MID_HASHLOG));
+
+		/* Fill hash tables with references into dictionary.
+		 * The resulting table is only exploitable by LZ4MID (level 2) */
+		public static void LZ4MID_fillHTable(LZ4_streamHC_t* cctx, byte* dict, size_t size)
+		{
+			uint* hash4Table = cctx->hashTable;
+			uint* hash8Table = hash4Table + LZ4MID_HASHTABLESIZE;
+			byte* prefixPtr = dict;
+			uint prefixIdx = cctx->dictLimit;
+			uint target = prefixIdx + size - LZ4MID_HASHSIZE;
+			uint idx = cctx->nextToUpdate;
+			Assert(dict == cctx->@base + cctx->dictLimit);
+			if (size <= LZ4MID_HASHSIZE)
+				return;
+
+			for (; idx < target; idx += 3)
+			{
+				hash4Table[LZ4MID_hash4Ptr(prefixPtr + idx - prefixIdx)] = idx;
+				hash8Table[LZ4MID_hash8Ptr(prefixPtr + idx + 1 - prefixIdx)] = idx + 1;
+			}
+
+			idx = (size > 32 * KB + LZ4MID_HASHSIZE) ? target - 32 * KB : cctx->nextToUpdate;
+			for (; idx < target; idx += 1)
+				hash8Table[LZ4MID_hash8Ptr(prefixPtr + idx - prefixIdx)] = idx;
+
+			cctx->nextToUpdate = target;
 		}
 
 		public static void LZ4HC_setExternalDict(LZ4_streamHC_t* ctxPtr, byte* newBlock)
 		{
-			if (ctxPtr->end >= ctxPtr->@base + ctxPtr->dictLimit + 4)
+			if (ctxPtr->end >= ctxPtr->@base + ctxPtr->dictLimit + 4
+				&& LZ4HC_getCLevelParams(ctxPtr->compressionLevel).strat != lz4hc_strat_e.lz4mid)
 				LZ4HC_Insert(
 					ctxPtr, ctxPtr->end - 3); /* Referencing remaining dictionary content */
 
@@ -139,6 +244,37 @@ namespace K4os.Compression.LZ4.Engine
 			ctxPtr->dictCtx = null;
 		}
 
+		/* registers block which is not compressed at all (it is stored as is), so history of
+		 * following blocks stays correct; mirrors LZ4_compressHC_continue_generic, but block
+		 * positions are not indexed now, they are inserted lazily when next block is
+		 * compressed (only last LZ4_DISTANCE_MAX bytes, as nothing before can be referenced) */
+		public static void LZ4_skipBlockHC(LZ4_streamHC_t* LZ4_streamHCPtr, byte* src, int srcSize)
+		{
+			LZ4_streamHC_t* ctxPtr = LZ4_streamHCPtr;
+			if (ctxPtr->@base == null) LZ4HC_init_internal(ctxPtr, src);
+			if (src != ctxPtr->end) LZ4HC_setExternalDict(ctxPtr, src);
+
+			{
+				byte* sourceEnd = src + srcSize;
+				byte* dictBegin = ctxPtr->dictBase + ctxPtr->lowLimit;
+				byte* dictEnd = ctxPtr->dictBase + ctxPtr->dictLimit;
+				if ((sourceEnd > dictBegin) && (src < dictEnd))
+				{
+					if (sourceEnd > dictEnd) sourceEnd = dictEnd;
+					ctxPtr->lowLimit = (uint) (sourceEnd - ctxPtr->dictBase);
+					if (ctxPtr->dictLimit - ctxPtr->lowLimit < 4)
+						ctxPtr->lowLimit = ctxPtr->dictLimit;
+				}
+			}
+
+			ctxPtr->end += srcSize;
+			{
+				uint endIndex = (uint) (ctxPtr->end - ctxPtr->@base);
+				uint windowStart = endIndex > LZ4_DISTANCE_MAX ? endIndex - LZ4_DISTANCE_MAX : 0;
+				if (ctxPtr->nextToUpdate < windowStart) ctxPtr->nextToUpdate = windowStart;
+			}
+		}
+
 		public static void LZ4HC_clearTables(LZ4_streamHC_t* hc4)
 		{
 			// uint hashTable[LZ4HC_HASHTABLESIZE];
@@ -157,6 +293,7 @@ namespace K4os.Compression.LZ4.Engine
 			}
 
 			startingOffset += 64 * KB;
+			if (hc4->opt != null) hc4->opt->binTreeLow = (uint) startingOffset;
 			hc4->nextToUpdate = (uint) startingOffset;
 			hc4->@base = start - startingOffset;
 			hc4->end = start;
@@ -197,15 +334,47 @@ namespace K4os.Compression.LZ4.Engine
 			/* need a full initialization, there are bad side-effects when using resetFast() */
 			{
 				int cLevel = ctxPtr->compressionLevel;
+				LZ4HC_opt_t* opt = ctxPtr->opt;
 				LZ4_initStreamHC(LZ4_streamHCPtr);
 				LZ4_setCompressionLevel(LZ4_streamHCPtr, cLevel);
+				LZ4_attachOptHC(LZ4_streamHCPtr, opt);
 			}
 			LZ4HC_init_internal(ctxPtr, (byte*) dictionary);
 			ctxPtr->end = (byte*) dictionary + dictSize;
-			if (dictSize >= 4) LZ4HC_Insert(ctxPtr, ctxPtr->end - 3);
+			if (LZ4HC_getCLevelParams(ctxPtr->compressionLevel).strat == lz4hc_strat_e.lz4mid)
+				LZ4MID_fillHTable(ctxPtr, dictionary, (size_t) dictSize);
+			else if (dictSize >= 4)
+				LZ4HC_Insert(ctxPtr, ctxPtr->end - 3);
 			return dictSize;
 		}
 
+		protected static readonly cParams_t[] clTable = {
+			new cParams_t(lz4hc_strat_e.lz4mid, 2, 16), /* 0, unused */
+			new cParams_t(lz4hc_strat_e.lz4mid, 2, 16), /* 1, unused */
+			new cParams_t(lz4hc_strat_e.lz4mid, 2, 16), /* 2 */
+			new cParams_t(lz4hc_strat_e.lz4hc, 4, 16), /* 3 */
+			new cParams_t(lz4hc_strat_e.lz4hc, 8, 16), /* 4 */
+			new cParams_t(lz4hc_strat_e.lz4hc, 16, 16), /* 5 */
+			new cParams_t(lz4hc_strat_e.lz4hc, 32, 16), /* 6 */
+			new cParams_t(lz4hc_strat_e.lz4hc, 64, 16), /* 7 */
+			new cParams_t(lz4hc_strat_e.lz4hc, 128, 16), /* 8 */
+			new cParams_t(lz4hc_strat_e.lz4hc, 256, 16), /* 9 */
+			new cParams_t(lz4hc_strat_e.lz4opt, 96, 64), /*10==LZ4HC_CLEVEL_OPT_MIN*/
+			new cParams_t(lz4hc_strat_e.lz4opt, 512, 128), /*11 */
+			new cParams_t(lz4hc_strat_e.lz4opt, 16384, LZ4_OPT_NUM), /* 12==LZ4HC_CLEVEL_MAX */
+			/* 13==LZ4HC_CLEVEL_ULTRA: whole window searched, no early commit */
+			new cParams_t(lz4hc_strat_e.lz4opt, LZ4_DISTANCE_MAX + 1, LZ4_OPT_NUM_ULTRA),
+		};
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static cParams_t LZ4HC_getCLevelParams(int cLevel)
+		{
+			/* note : convention is different from lz4frame, maybe something to review */
+			if (cLevel < 1) cLevel = LZ4HC_CLEVEL_DEFAULT;
+			cLevel = MIN(LZ4HC_CLEVEL_ULTRA, cLevel);
+			return clTable[cLevel];
+		}
+
 		[MethodImpl(MethodImplOptions.AggressiveInlining)]
 		public static uint LZ4HC_rotl32(uint x, int r) => ((x << r) | (x >> (32 - r)));
 
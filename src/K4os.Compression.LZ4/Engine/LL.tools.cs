@@ -43,17 +43,53 @@ namespace K4os.Compression.LZ4.Engine
 		internal static int LZ4_decoderRingBufferSize(int isize) =>
 			65536 + 14 + isize;
 
+		/* encodes block of single repeated byte (srcSize >= LZ4_minLength) as one literal
+		 * followed by one match with offset 1 covering whole block (but last literals),
+		 * which is both smallest possible encoding and fastest one to decode;
+		 * returns 0 if it does not fit in dst */
+		protected static int LZ4_compress_run(byte* src, byte* dst, int srcSize, int dstCapacity)
+		{
+			Assert(srcSize >= LZ4_minLength);
+			var matchLength = srcSize - 1 - LASTLITERALS - MINMATCH;
+			var extraLength = matchLength >= ML_MASK ? (matchLength - (int) ML_MASK) / 255 + 1 : 0;
+			var compressedSize = 1 + 1 + 2 + extraLength + 1 + LASTLITERALS;
+			if (compressedSize > dstCapacity) return 0;
+
+			var op = dst;
+			*op++ = (byte) ((1 << ML_BITS) | MIN(matchLength, (int) ML_MASK));
+			*op++ = *src;
+			Mem.Poke2(op, 1);
+			op += 2;
+
+			if (matchLength >= ML_MASK)
+			{
+				var accumulator = matchLength - (int) ML_MASK;
+				Mem.Fill(op, 255, accumulator / 255);
+				op += accumulator / 255;
+				*op++ = (byte) (accumulator % 255);
+			}
+
+			*op++ = (byte) (LASTLITERALS << ML_BITS);
+			Mem.Fill(op, *src, LASTLITERALS);
+			op += LASTLITERALS;
+
+			Assert(op - dst == compressedSize);
+			return compressedSize;
+		}
+
 		[MethodImpl(MethodImplOptions.AggressiveInlining)]
-		protected static uint LZ4_hash4(uint sequence, tableType_t tableType)
+		protected static uint LZ4_hash4(
+			uint sequence, tableType_t tableType, int hashLog = LZ4_HASHLOG)
 		{
-			var hashLog = tableType == tableType_t.byU16 ? LZ4_HASHLOG + 1 : LZ4_HASHLOG;
+			if (tableType == tableType_t.byU16) hashLog++;
 			return unchecked((sequence * 2654435761u) >> (MINMATCH * 8 - hashLog));
 		}
 
 		[MethodImpl(MethodImplOptions.AggressiveInlining)]
-		protected static uint LZ4_hash5(ulong sequence, tableType_t tableType)
+		protected static uint LZ4_hash5(
+			ulong sequence, tableType_t tableType, int hashLog = LZ4_HASHLOG)
 		{
-			var hashLog = tableType == tableType_t.byU16 ? LZ4_HASHLOG + 1 : LZ4_HASHLOG;
+			if (tableType == tableType_t.byU16) hashLog++;
 			return unchecked((uint) (((sequence << 24) * 889523592379ul) >> (64 - hashLog)));
 		}
 
@@ -238,6 +274,17 @@ namespace K4os.Compression.LZ4.Engine
 			return buffer;
 		}
 
+		/* clears only the part of hash table which is going to be used with given hashLog */
+		public static LZ4_stream_t* LZ4_initStream(LZ4_stream_t* buffer, int hashLog)
+		{
+			Assert(hashLog >= LZ4_HASHLOG_MIN && hashLog <= LZ4_HASHLOG);
+			Mem.Zero((byte*) buffer, sizeof(uint) << hashLog);
+			Mem.Zero(
+				(byte*) buffer + LZ4_HASHTABLESIZE,
+				sizeof(LZ4_stream_t) - LZ4_HASHTABLESIZE);
+			return buffer;
+		}
+
 		public static void LZ4_setStreamDecode(
 			LZ4_streamDecode_t* LZ4_streamDecode, byte* dictionary, int dictSize)
 		{
@@ -20,7 +20,8 @@ namespace K4os.Compression.LZ4.Engine
 		protected const int LZ4_DISTANCE_MAX = 65535;
 		protected const int LZ4_DISTANCE_ABSOLUTE_MAX = 65535;
 
-		protected const int LZ4_HASHLOG = LZ4_MEMORY_USAGE - 2;
+		internal const int LZ4_HASHLOG = LZ4_MEMORY_USAGE - 2;
+		internal const int LZ4_HASHLOG_MIN = 8;
 		protected const int LZ4_HASHTABLESIZE = 1 << LZ4_MEMORY_USAGE;
 		protected const int LZ4_HASH_SIZE_U32 = 1 << LZ4_HASHLOG;
 
@@ -72,7 +73,9 @@ namespace K4os.Compression.LZ4.Engine
 		protected const uint RUN_MASK = (1U << RUN_BITS) - 1;
 		
 		protected const int OPTIMAL_ML = (int) ((ML_MASK - 1) + MINMATCH);
-		protected const int LZ4_OPT_NUM = (1 << 12);
+		internal const int LZ4_OPT_NUM = (1 << 12);
+		internal const int LZ4_OPT_NUM_MIN = (1 << 8);
+		internal const int LZ4_OPT_NUM_ULTRA = (1 << 15);
 
 		protected const int LZ4_64Klimit = 64 * KB + (MFLIMIT - 1);
 		protected const int LZ4_skipTrigger = 6;
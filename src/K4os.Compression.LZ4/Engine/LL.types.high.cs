@@ -24,10 +24,15 @@ internal unsafe partial class LL
 	protected const int LZ4HC_HASHTABLESIZE = (1 << LZ4HC_HASH_LOG);
 	protected const int LZ4HC_HASH_MASK = (LZ4HC_HASHTABLESIZE - 1);
 
+	protected const int LZ4MID_HASHSIZE = 8;
+	protected const int LZ4MID_HASHLOG = LZ4HC_HASH_LOG - 1;
+	protected const int LZ4MID_HASHTABLESIZE = 1 << LZ4MID_HASHLOG;
+
 	protected const int LZ4HC_CLEVEL_MIN = 3;
 	protected const int LZ4HC_CLEVEL_DEFAULT = 9;
 	protected const int LZ4HC_CLEVEL_OPT_MIN = 10;
 	protected const int LZ4HC_CLEVEL_MAX = 12;
+	protected const int LZ4HC_CLEVEL_ULTRA = 13;
 
 	[StructLayout(LayoutKind.Sequential)]
 	public struct LZ4_streamHC_t
@@ -41,9 +46,37 @@ internal unsafe partial class LL
 		public uint lowLimit; /* below that point, no more dict */
 		public uint nextToUpdate; /* index from which to continue dictionary update */
 		public short compressionLevel;
+		public uint nbSearches; /* overrides compression level search depth if not 0 */
+		public uint targetLength; /* overrides compression level target length if not 0 */
 		public bool favorDecSpeed; /* favor decompression speed if this flag set */
 		public bool dirty; /* stream has to be fully reset if this flag is set */
 		public LZ4_streamHC_t* dictCtx;
+		public LZ4HC_opt_t* opt; /* optional state of optimal parser, not owned */
+	}
+
+	protected const int LZ4HC_BT_MATCHES_MAX = 64;
+	protected const int LZ4HC_BT_SKIP_LENGTH = 384;
+	protected const int LZ4HC_OPT_TRAILING_LITERALS = 3;
+
+	/* favorDecSpeed: matches closer than 16 bytes re-read what decoder has just written
+	 * (overlapping copy or store forwarding stall), short matches and short sequences are
+	 * not worth token, offset and copy setup */
+	protected const int LZ4HC_FAVOR_MIN_OFFSET = 16;
+	protected const int LZ4HC_FAVOR_MIN_MATCH = MINMATCH + 1;
+	protected const int LZ4HC_FAVOR_SEQUENCE_PRICE = 1;
+
+	/* state used by optimal parser (levels 10+), allocated separately, as it is large and
+	 * not needed by other levels; buffers follow the header (see LZ4_initStateOptHC) */
+	[StructLayout(LayoutKind.Sequential)]
+	public struct LZ4HC_opt_t
+	{
+		public int optNum; /* parse window: positions priced before committing to a sequence */
+		public LZ4HC_optimal_t* parse; /* optNum + LZ4HC_OPT_TRAILING_LITERALS entries */
+		/* binary tree: smaller and larger child of every position (as distance to parent),
+		 * null when hash chain is used */
+		public ushort* binTree;
+		/* positions below were indexed by hash chain only (their tree links are stale) */
+		public uint binTreeLow;
 	}
 
 	protected enum repeat_state_e { rep_untested, rep_not, rep_confirmed }
@@ -66,7 +99,7 @@ internal unsafe partial class LL
 		public int litlen;
 	}
 
-	public enum lz4hc_strat_e { lz4hc, lz4opt }
+	public enum lz4hc_strat_e { lz4mid, lz4hc, lz4opt }
 
 	[StructLayout(LayoutKind.Sequential)]
 	public struct cParams_t
@@ -0,0 +1,116 @@
+// ReSharper disable IdentifierTypo
+// ReSharper disable InconsistentNaming
+// ReSharper disable BuiltInTypeReferenceStyle
+
+using System.Runtime.CompilerServices;
+using K4os.Compression.LZ4.Internal;
+
+namespace K4os.Compression.LZ4.Engine
+{
+	/// <summary>Receives sequences found by <see cref="LL.LZ4_walkBlock{TVisitor}"/>.</summary>
+	internal interface ILZ4BlockVisitor
+	{
+		/// <summary>Literal run (possibly empty).</summary>
+		/// <param name="length">Number of literals.</param>
+		/// <param name="extra">Number of additional length bytes.</param>
+		void Literals(int length, int extra);
+
+		/// <summary>Match (already including <c>MINMATCH</c>).</summary>
+		/// <param name="length">Match length.</param>
+		/// <param name="offset">Match offset.</param>
+		/// <param name="extra">Number of additional length bytes.</param>
+		void Match(int length, int offset, int extra);
+	}
+
+	internal unsafe partial class LL
+	{
+		/// <summary>Visitor which ignores everything (when only decoded length is needed).</summary>
+		internal struct LZ4_nullVisitor: ILZ4BlockVisitor
+		{
+			[MethodImpl(MethodImplOptions.AggressiveInlining)]
+			public void Literals(int length, int extra) { }
+
+			[MethodImpl(MethodImplOptions.AggressiveInlining)]
+			public void Match(int length, int offset, int extra) { }
+		}
+
+		/* walks block the same way LZ4_decompress_safe_usingDict does (with output buffer of
+		 * exactly decoded size) but without producing any output; parsing restrictions on both
+		 * input and output side are the same as decoder's, so it never accepts a block decoder
+		 * would reject (it is only stricter than decoder's shortcut for malformed blocks);
+		 * returns decoded length or, like decoder, negative value when block is corrupted */
+		public static int LZ4_walkBlock<TVisitor>(
+			byte* src, int srcSize, int dictSize, ref TVisitor visitor)
+			where TVisitor: struct, ILZ4BlockVisitor
+		{
+			if (src == null || srcSize <= 0) return -1;
+
+			var ip = src;
+			var iend = src + srcSize;
+			var op = 0L;
+			var literalsEnd = 0L; /* end of last literals followed by a match */
+			var matchEnd = 0L; /* end of last match */
+
+			while (true)
+			{
+				var token = (uint) *ip++;
+				var start = ip;
+
+				/* literal length */
+				long length = token >> ML_BITS;
+				if (length == RUN_MASK)
+				{
+					var error = variable_length_error.ok;
+					length += LZ4_readVLE(&ip, iend - RUN_MASK, true, true, &error);
+					if (error == variable_length_error.initial_error) goto _output_error;
+				}
+
+				if (length > iend - ip) goto _output_error;
+
+				visitor.Literals((int) length, (int) (ip - start));
+				ip += length;
+				op += length;
+
+				/* last literals have to consume input exactly */
+				if (ip == iend) break;
+
+				if (ip > iend - (2 + 1 + LASTLITERALS)) goto _output_error;
+
+				literalsEnd = op;
+
+				/* offset */
+				var offset = Mem.Peek2(ip);
+				ip += 2;
+				if (offset > op + dictSize) goto _output_error;
+
+				/* match length */
+				start = ip;
+				length = token & ML_MASK;
+				if (length == ML_MASK)
+				{
+					var error = variable_length_error.ok;
+					length += LZ4_readVLE(&ip, iend - LASTLITERALS + 1, true, false, &error);
+					if (error != variable_length_error.ok) goto _output_error;
+				}
+
+				length += MINMATCH;
+				op += length;
+				if (op > int.MaxValue) goto _output_error;
+
+				visitor.Match((int) length, offset, (int) (ip - start));
+				matchEnd = op;
+			}
+
+			/* last LASTLITERALS bytes must be literals, last match must start
+			 * at least MFLIMIT bytes before end of block */
+			if (op > int.MaxValue) goto _output_error;
+			if (matchEnd > 0 && (matchEnd > op - LASTLITERALS || literalsEnd > op - MFLIMIT))
+				goto _output_error;
+
+			return (int) op;
+
+			_output_error:
+			return (int) -(ip - src) - 1;
+		}
+	}
+}
@@ -65,12 +65,12 @@ internal static unsafe class LLxx
 	[MethodImpl(MethodImplOptions.NoInlining)]
 	public static int LZ4_compress_fast(
 		byte* source, byte* target, int sourceLength, int targetLength,
-		int acceleration) =>
+		int acceleration, int hashLog = LL.LZ4_HASHLOG) =>
 		LL.Algorithm switch {
 			Algorithm.X64 => LL64.LZ4_compress_fast(
-				source, target, sourceLength, targetLength, acceleration),
+				source, target, sourceLength, targetLength, acceleration, hashLog),
 			Algorithm.X32 => LL32.LZ4_compress_fast(
-				source, target, sourceLength, targetLength, acceleration),
+				source, target, sourceLength, targetLength, acceleration, hashLog),
 			_ => throw AlgorithmNotImplemented(nameof(LZ4_compress_fast))
 		};
 
@@ -78,19 +78,28 @@ internal static unsafe class LLxx
 	public static int LZ4_compress_fast_continue(
 		LL.LZ4_stream_t* context,
 		byte* source, byte* target, int sourceLength, int targetLength,
-		int acceleration) =>
+		int acceleration, int hashLog = LL.LZ4_HASHLOG) =>
 		LL.Algorithm switch {
 			Algorithm.X64 => LL64.LZ4_compress_fast_continue(
 				context,
 				source, target, sourceLength, targetLength,
-				acceleration),
+				acceleration, hashLog),
 			Algorithm.X32 => LL32.LZ4_compress_fast_continue(
 				context,
 				source, target, sourceLength, targetLength,
-				acceleration),
+				acceleration, hashLog),
 			_ => throw AlgorithmNotImplemented(nameof(LZ4_compress_fast_continue))
 		};
 
+	[MethodImpl(MethodImplOptions.NoInlining)]
+	public static int LZ4_loadDict(
+		LL.LZ4_stream_t* context, byte* dictionary, int dictionaryLength) =>
+		LL.Algorithm switch {
+			Algorithm.X64 => LL64.LZ4_loadDict(context, dictionary, dictionaryLength),
+			Algorithm.X32 => LL32.LZ4_loadDict(context, dictionary, dictionaryLength),
+			_ => throw AlgorithmNotImplemented(nameof(LZ4_loadDict))
+		};
+
 	[MethodImpl(MethodImplOptions.NoInlining)]
 	public static int LZ4_compress_HC(
 		byte* source, byte* target, int sourceLength, int targetLength, int level) =>
@@ -102,6 +111,21 @@ internal static unsafe class LLxx
 			_ => throw AlgorithmNotImplemented(nameof(LZ4_compress_HC))
 		};
 
+	[MethodImpl(MethodImplOptions.NoInlining)]
+	public static int LZ4_compress_HC(
+		byte* source, byte* target, int sourceLength, int targetLength, int level,
+		int nbSearches, int targetMatchLength, bool favorDecSpeed, bool binaryTree,
+		int parseWindow) =>
+		LL.Algorithm switch {
+			Algorithm.X64 => LL64.LZ4_compress_HC(
+				source, target, sourceLength, targetLength, level,
+				nbSearches, targetMatchLength, favorDecSpeed, binaryTree, parseWindow),
+			Algorithm.X32 => LL32.LZ4_compress_HC(
+				source, target, sourceLength, targetLength, level,
+				nbSearches, targetMatchLength, favorDecSpeed, binaryTree, parseWindow),
+			_ => throw AlgorithmNotImplemented(nameof(LZ4_compress_HC))
+		};
+
 	[MethodImpl(MethodImplOptions.NoInlining)]
 	public static int LZ4_compress_HC_continue(
 		LL.LZ4_streamHC_t* context,
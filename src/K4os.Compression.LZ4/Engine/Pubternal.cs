@@ -1,5 +1,6 @@
 #nullable enable
 
+using System.Runtime.CompilerServices;
 using K4os.Compression.LZ4.Internal;
 
 namespace K4os.Compression.LZ4.Engine;
@@ -27,6 +28,46 @@ public static unsafe class Pubternal
 		protected override void ReleaseUnmanaged() => Mem.Free(Context);
 	}
 
+	/// <summary>Pubternal wrapper for LZ4_streamHC_t.</summary>
+	public class HighContext: UnmanagedResources
+	{
+		internal LL.LZ4_streamHC_t* Context { get; }
+
+		private readonly void* _opt;
+
+		/// <summary>Creates new instance of wrapper for LZ4_streamHC_t.</summary>
+		public HighContext()
+		{
+			var size = sizeof(LL.LZ4_streamHC_t);
+			Context = LL.LZ4_initStreamHC(Mem.AllocZero(size), size);
+		}
+
+		/// <summary>Creates new instance of wrapper for LZ4_streamHC_t with given
+		/// compression level (and state of optimal parser, if level needs it).</summary>
+		/// <param name="level">Compression level.</param>
+		/// <param name="binaryTree">Use binary tree match finder (optimal levels only).</param>
+		public HighContext(LZ4Level level, bool binaryTree = false): this()
+		{
+			LL.LZ4_setCompressionLevel(Context, (int) level);
+			if (level < LZ4Level.L10_OPT) return;
+
+			var optNum = LL.LZ4HC_getOptNum((int) level, 0);
+			_opt = Mem.Alloc(LL.LZ4_sizeofStateOptHC(optNum, binaryTree));
+			LL.LZ4_attachOptHC(Context, LL.LZ4_initStateOptHC(_opt, optNum, binaryTree));
+		}
+
+		/// <summary>Resets context, so next block starts at given address.</summary>
+		/// <param name="start">Block address.</param>
+		public void Reset(byte* start) => LL.LZ4HC_init_internal(Context, start);
+
+		/// <inheritdoc/>
+		protected override void ReleaseUnmanaged()
+		{
+			Mem.Free(_opt);
+			Mem.Free(Context);
+		}
+	}
+
 	/// <summary>
 	/// Compresses chunk of data using LZ4_compress_fast_continue.
 	/// </summary>
@@ -47,4 +88,98 @@ public static unsafe class Pubternal
 			source, target,
 			sourceLength, targetLength,
 			acceleration);
+
+	/// <summary>
+	/// Compresses chunk of data using LZ4_compress_HC_continue.
+	/// </summary>
+	/// <param name="context">Wrapper for LZ4_streamHC_t</param>
+	/// <param name="source">Source block address.</param>
+	/// <param name="target">Target block address.</param>
+	/// <param name="sourceLength">Source block length.</param>
+	/// <param name="targetLength">Target block length.</param>
+	/// <returns>Number of bytes actually written to target.</returns>
+	public static int CompressHigh(
+		HighContext context,
+		byte* source, byte* target,
+		int sourceLength, int targetLength) =>
+		LLxx.LZ4_compress_HC_continue(
+			context.Context,
+			source, target,
+			sourceLength, targetLength);
+
+	/// <summary>
+	/// Loads dictionary using LZ4_loadDictHC (as stream does when its index overflows).
+	/// </summary>
+	/// <param name="context">Wrapper for LZ4_streamHC_t</param>
+	/// <param name="dictionary">Dictionary address.</param>
+	/// <param name="dictionaryLength">Dictionary length.</param>
+	/// <returns>Number of bytes actually loaded (at most 64KB).</returns>
+	public static int LoadDictHigh(
+		HighContext context, byte* dictionary, int dictionaryLength) =>
+		LL.LZ4_loadDictHC(context.Context, dictionary, dictionaryLength);
+
+	/// <summary>Kernel: LZ4_count.</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static uint Count(byte* pIn, byte* pMatch, byte* pInLimit) =>
+		LL.Algorithm == Algorithm.X32
+			? LL32.Kernels.Count(pIn, pMatch, pInLimit)
+			: LL64.Kernels.Count(pIn, pMatch, pInLimit);
+
+	/// <summary>Kernel: LZ4_hash4 (for small, 64KB tables, or regular ones).</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static uint Hash4(uint sequence, bool small) =>
+		LL.Algorithm == Algorithm.X32
+			? LL32.Kernels.Hash4(sequence, small)
+			: LL64.Kernels.Hash4(sequence, small);
+
+	/// <summary>Kernel: LZ4_hash5 (for small, 64KB tables, or regular ones).</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static uint Hash5(ulong sequence, bool small) =>
+		LL.Algorithm == Algorithm.X32
+			? LL32.Kernels.Hash5(sequence, small)
+			: LL64.Kernels.Hash5(sequence, small);
+
+	/// <summary>Kernel: LZ4_hashPosition (hash4 or hash5, depending on algorithm).</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static uint HashPosition(void* p, bool small) =>
+		LL.Algorithm == Algorithm.X32
+			? LL32.Kernels.HashPosition(p, small)
+			: LL64.Kernels.HashPosition(p, small);
+
+	/// <summary>Kernel: LZ4_wildCopy8.</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static void WildCopy8(byte* target, byte* source, void* limit)
+	{
+		if (LL.Algorithm == Algorithm.X32)
+			LL32.Kernels.WildCopy8(target, source, limit);
+		else
+			LL64.Kernels.WildCopy8(target, source, limit);
+	}
+
+	/// <summary>Kernel: LZ4_memcpy_using_offset (copying match, which may overlap).</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static void MatchCopy(byte* target, byte* match, byte* limit, uint offset)
+	{
+		if (LL.Algorithm == Algorithm.X32)
+			LL32.Kernels.MatchCopy(target, match, limit, offset);
+		else
+			LL64.Kernels.MatchCopy(target, match, limit, offset);
+	}
+
+	/// <summary>Kernel: LZ4HC_Insert.</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static void Insert(HighContext context, byte* ip) =>
+		LL.LZ4HC_Insert(context.Context, ip);
+
+	/// <summary>Kernel: LZ4HC_countPattern.</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static uint CountPattern(byte* ip, byte* iEnd, uint pattern) =>
+		LL.Algorithm == Algorithm.X32
+			? LL32.Kernels.CountPattern(ip, iEnd, pattern)
+			: LL64.Kernels.CountPattern(ip, iEnd, pattern);
+
+	/// <summary>Kernel: LZ4HC_countBack.</summary>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static int CountBack(byte* ip, byte* match, byte* iMin, byte* mMin) =>
+		LL.LZ4HC_countBack(ip, match, iMin, mMin);
 }
@@ -36,8 +36,6 @@ internal unsafe partial class LL32
 internal unsafe partial class LL64
 #endif
 {
-	#if LZ4_FAST_DEC_LOOP
-
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	private static void LZ4_memcpy_using_offset_base(
 		byte* dstPtr, byte* srcPtr, byte* dstEnd, uint offset)
@@ -63,6 +61,8 @@ internal unsafe partial class LL64
 		Mem.WildCopy8(dstPtr, srcPtr, dstEnd);
 	}
 
+	#if LZ4_FAST_DEC_LOOP
+
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	private static void LZ4_memcpy_using_offset(byte* dstPtr, byte* srcPtr, byte* dstEnd, size_t offset)
 	{
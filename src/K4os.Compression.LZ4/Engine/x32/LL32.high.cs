@@ -22,6 +22,11 @@ using System;
 using System.Runtime.CompilerServices;
 using K4os.Compression.LZ4.Internal;
 
+#if NET7_0_OR_GREATER && !BIT32
+using System.Numerics;
+using System.Runtime.Intrinsics;
+#endif
+
 #if BIT32
 using reg_t = System.UInt32;
 using Mem = K4os.Compression.LZ4.Internal.Mem32;
@@ -51,6 +56,23 @@ internal unsafe partial class LL64
 		pattern |= pattern << 32;
 		#endif
 
+		#if NET7_0_OR_GREATER && !BIT32
+
+		if (Vector256.IsHardwareAccelerated)
+		{
+			var patternV = Vector256.Create(pattern32).AsByte();
+			while (ip < iEnd - 31)
+			{
+				var mask = Vector256.Equals(Vector256.Load(ip), patternV).ExtractMostSignificantBits();
+				if (mask != uint.MaxValue)
+					return (uint) (ip + BitOperations.TrailingZeroCount(~mask) - iStart);
+
+				ip += 32;
+			}
+		}
+
+		#endif
+
 		while ((ip < iEnd - (ARCH - 1)))
 		{
 			reg_t diff = Mem.PeekW(ip) ^ pattern;
@@ -117,9 +139,11 @@ internal unsafe partial class LL64
 			int matchLength = 0;
 			nbAttempts--;
 			Assert(matchIndex < ipIndex);
-			if (favorDecSpeed != 0 && (ipIndex - matchIndex < 8))
+			if (favorDecSpeed != 0 && (ipIndex - matchIndex < LZ4HC_FAVOR_MIN_OFFSET))
 			{
-				/* do nothing */
+				/* do nothing, but do not count it as attempt either (there are only few such
+				 * positions, but in repetitive data they could exhaust shallow search) */
+				nbAttempts++;
 			}
 			else if (matchIndex >= dictLimit)
 			{
@@ -396,7 +420,8 @@ internal unsafe partial class LL64
 		byte** matchpos,
 		int maxNbAttempts,
 		bool patternAnalysis,
-		dictCtx_directive dict)
+		dictCtx_directive dict,
+		HCfavor_e favorDecSpeed)
 	{
 		byte* uselessPtr = ip;
 		/* note : LZ4HC_InsertAndGetWiderMatch() is able to modify the starting position of a match (*startpos),
@@ -404,7 +429,7 @@ internal unsafe partial class LL64
 		* so LZ4HC_InsertAndGetWiderMatch() won't be allowed to search past ip */
 		return LZ4HC_InsertAndGetWiderMatch(
 			hc4, ip, ip, iLimit, MINMATCH - 1, matchpos, &uselessPtr, maxNbAttempts,
-			patternAnalysis, false /*chainSwap*/, dict, HCfavor_e.favorCompressionRatio);
+			patternAnalysis, false /*chainSwap*/, dict, favorDecSpeed);
 	}
 
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
@@ -439,6 +464,211 @@ internal unsafe partial class LL64
 		return match;
 	}
 
+	/* binary tree match finder (optimal levels only), see zstd's bt strategies:
+	 * every position is a node of the tree, hash table points to the root (most recent
+	 * position), children are older positions sorted by content (smaller/larger),
+	 * so the tree is split and re-rooted at each inserted position.
+	 * Links are stored as distance to parent (0 means "none"), window is limited to
+	 * LZ4_DISTANCE_MAX, so links never exceed 16 bits. Works on prefix only (no extDict).
+	 * Positions indexed by hash chain only (LZ4HC_Insert) are not in the tree, so walk
+	 * stops at them (opt->binTreeLow), their slots may hold links of older positions.
+	 * Insertion returns number of positions which can be skipped by next insertion. */
+
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	private static int LZ4HC_BinTree_insert(
+		LZ4_streamHC_t* ctx, ushort* tree,
+		byte* ip, byte* iHighLimit,
+		int minLen, int nbSearches,
+		LZ4HC_match_t* matches, int* nbMatchesPtr,
+		HCfavor_e favorDecSpeed)
+	{
+		byte* @base = ctx->@base;
+		uint current = (uint) (ip - @base);
+		uint btLow = (ctx->dictLimit + LZ4_DISTANCE_MAX > current)
+			? ctx->dictLimit : current - LZ4_DISTANCE_MAX;
+		if (btLow < ctx->opt->binTreeLow) btLow = ctx->opt->binTreeLow;
+		uint h = LZ4HC_hashPtr(ip);
+		uint matchIndex = ctx->hashTable[h];
+		uint matchEndIdx = current + 8 + 1;
+		int longest = 0;
+		int bestLength = minLen;
+		int nbMatches = 0;
+
+		/* hash chain is maintained as well, so hash chain match finder can pick up */
+		{
+			size_t delta = current - matchIndex;
+			if (delta > LZ4_DISTANCE_MAX) delta = LZ4_DISTANCE_MAX;
+			DELTANEXTU16(ctx->chainTable, current) = (ushort) delta;
+			ctx->hashTable[h] = current;
+		}
+
+		ushort* smallerPtr = tree + ((current & LZ4HC_MAXD_MASK) << 1);
+		ushort* largerPtr = smallerPtr + 1;
+		uint smallerParent = current;
+		uint largerParent = current;
+		size_t commonSmaller = 0;
+		size_t commonLarger = 0;
+		ushort dummy;
+
+		if (matchIndex >= current) matchIndex = 0; /* left by some other strategy */
+
+		while ((matchIndex >= btLow) && (nbSearches-- > 0))
+		{
+			ushort* nextPtr = tree + ((matchIndex & LZ4HC_MAXD_MASK) << 1);
+			byte* match = @base + matchIndex;
+			size_t matchLength = MIN(commonSmaller, commonLarger);
+			Assert(matchIndex < current);
+
+			matchLength += LZ4_count(ip + matchLength, match + matchLength, iHighLimit);
+			if ((int) matchLength > longest) longest = (int) matchLength;
+			if (matchIndex + matchLength > matchEndIdx) matchEndIdx = matchIndex + matchLength;
+
+			if (matches != null && (int) matchLength > bestLength)
+			{
+				size_t length = matchLength;
+				uint offset = current - matchIndex;
+				if (favorDecSpeed != 0 && offset < LZ4HC_FAVOR_MIN_OFFSET)
+				{
+					/* repetition has the same length at every offset, so tree returns the
+					 * closest one only; period multiplied to at least LZ4HC_FAVOR_MIN_OFFSET
+					 * is tested instead */
+					offset = (LZ4HC_FAVOR_MIN_OFFSET + offset - 1) / offset * offset;
+					length = current - offset >= btLow
+						? LZ4_count(ip, ip - offset, iHighLimit)
+						: 0;
+				}
+
+				if ((int) length > bestLength)
+				{
+					bestLength = (int) length;
+					if (nbMatches == LZ4HC_BT_MATCHES_MAX) nbMatches--; /* keep the longest */
+					matches[nbMatches].len = (int) length;
+					matches[nbMatches].off = (int) offset;
+					nbMatches++;
+				}
+			}
+
+			/* cannot tell smaller from larger, drop the rest to keep tree consistent */
+			if (ip + matchLength >= iHighLimit) break;
+
+			if (match[matchLength] < ip[matchLength])
+			{
+				/* match is smaller than current, so is its smaller subtree */
+				*smallerPtr = (ushort) (smallerParent - matchIndex);
+				commonSmaller = matchLength;
+				if (matchIndex <= btLow) { smallerPtr = &dummy; break; }
+
+				smallerParent = matchIndex;
+				smallerPtr = nextPtr + 1;
+				matchIndex = nextPtr[1] == 0 ? 0 : matchIndex - nextPtr[1];
+			}
+			else
+			{
+				/* match is larger than current, so is its larger subtree */
+				*largerPtr = (ushort) (largerParent - matchIndex);
+				commonLarger = matchLength;
+				if (matchIndex <= btLow) { largerPtr = &dummy; break; }
+
+				largerParent = matchIndex;
+				largerPtr = nextPtr;
+				matchIndex = nextPtr[0] == 0 ? 0 : matchIndex - nextPtr[0];
+			}
+		}
+
+		*smallerPtr = 0;
+		*largerPtr = 0;
+
+		if (nbMatchesPtr != null) *nbMatchesPtr = nbMatches;
+
+		/* long repetitions would make it quadratic, so positions inside them can be skipped */
+		uint positions = longest > LZ4HC_BT_SKIP_LENGTH
+			? MIN(LZ4HC_BT_SKIP_LENGTH / 2, (uint) (longest - LZ4HC_BT_SKIP_LENGTH))
+			: 0;
+		uint covered = matchEndIdx - (current + 8);
+		return (int) (positions > covered ? positions : covered);
+	}
+
+	public static void LZ4HC_BinTree_update(
+		LZ4_streamHC_t* ctx, ushort* tree, byte* ip, byte* iHighLimit, int nbSearches)
+	{
+		byte* @base = ctx->@base;
+		uint target = (uint) (ip - @base);
+		uint idx = ctx->nextToUpdate;
+
+		while (idx < target)
+			idx += (uint) LZ4HC_BinTree_insert(
+				ctx, tree, @base + idx, iHighLimit, 0, nbSearches, null, null,
+				HCfavor_e.favorCompressionRatio);
+
+		ctx->nextToUpdate = target;
+	}
+
+	/* finds all matches longer than minLen which are not dominated by closer one
+	 * (longer match with smaller offset), sorted by length (and offset) */
+	public static int LZ4HC_BinTree_findMatches(
+		LZ4_streamHC_t* ctx, ushort* tree,
+		byte* ip, byte* iHighLimit,
+		int minLen, int nbSearches,
+		LZ4HC_match_t* matches,
+		HCfavor_e favorDecSpeed)
+	{
+		int nbMatches;
+		LZ4HC_BinTree_update(ctx, tree, ip, iHighLimit, nbSearches);
+		LZ4HC_BinTree_insert(
+			ctx, tree, ip, iHighLimit, minLen, nbSearches, matches, &nbMatches, favorDecSpeed);
+		ctx->nextToUpdate++;
+		if (nbMatches == 0) return 0;
+
+		if (favorDecSpeed != 0)
+		{
+			LZ4HC_match_t* longest = matches + nbMatches - 1;
+			if ((longest->len > 18) & (longest->len <= 36))
+				longest->len = 18; /* favor shortcut */
+		}
+
+		/* keep only pareto-optimal candidates (scanning from the longest one) */
+		{
+			int last = nbMatches - 1;
+			int kept = last;
+			for (int i = last - 1; i >= 0; i--)
+			{
+				if (matches[i].len >= matches[kept].len) continue;
+				if (matches[i].off >= matches[kept].off) continue;
+
+				matches[--kept] = matches[i];
+			}
+
+			nbMatches = last - kept + 1;
+			if (kept > 0)
+				Mem.Move(
+					(byte*) matches, (byte*) (matches + kept),
+					nbMatches * sizeof(LZ4HC_match_t));
+		}
+
+		return nbMatches;
+	}
+
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	private static int LZ4HC_FindLongerMatches(
+		LZ4_streamHC_t* ctx, ushort* tree,
+		byte* ip, byte* iHighLimit,
+		int minLen, int nbSearches,
+		dictCtx_directive dict,
+		HCfavor_e favorDecSpeed,
+		LZ4HC_match_t* matches)
+	{
+		if (tree != null)
+			return LZ4HC_BinTree_findMatches(
+				ctx, tree, ip, iHighLimit, minLen, nbSearches, matches, favorDecSpeed);
+
+		LZ4HC_match_t match = LZ4HC_FindLongerMatch(
+			ctx, ip, iHighLimit, minLen, nbSearches, dict, favorDecSpeed);
+		if (match.len == 0) return 0;
+
+		matches[0] = match;
+		return 1;
+	}
+
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	public static int LZ4HC_encodeSequence(
 		byte** ip,
@@ -516,6 +746,240 @@ internal unsafe partial class LL64
 		return 0;
 	}
 
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static int LZ4MID_compress(
+		LZ4_streamHC_t* ctx,
+		byte* src,
+		byte* dst,
+		int* srcSizePtr,
+		int maxOutputSize,
+		limitedOutput_directive limit,
+		dictCtx_directive dict)
+	{
+		uint* hash4Table = ctx->hashTable;
+		uint* hash8Table = hash4Table + LZ4MID_HASHTABLESIZE;
+		byte* ip = (byte*) src;
+		byte* anchor = ip;
+		byte* iend = ip + *srcSizePtr;
+		byte* mflimit = iend - MFLIMIT;
+		byte* matchlimit = (iend - LASTLITERALS);
+		byte* ilimit = (iend - LZ4MID_HASHSIZE);
+		byte* optr = (byte*) dst;
+		byte* op = (byte*) dst;
+		byte* oend = op + maxOutputSize;
+
+		byte* @base = ctx->@base;
+		byte* prefixPtr = @base + ctx->dictLimit;
+		uint prefixIdx = ctx->dictLimit;
+		uint ilimitIdx = (uint) (ilimit - @base);
+		byte* dictBase = ctx->dictBase;
+		uint dictIdx = ctx->lowLimit;
+		uint matchLength;
+		uint matchDistance;
+
+		/* dictionary context is never attached, so there is nothing to search beyond extDict */
+		Assert(dict == dictCtx_directive.noDictCtx);
+
+		/* input sanitization */
+		if (*srcSizePtr < 0) return 0; /* invalid */
+		if (maxOutputSize < 0) return 0; /* invalid */
+		if (*srcSizePtr > LZ4_MAX_INPUT_SIZE) return 0; /* forbidden: input is too large */
+
+		if (limit == limitedOutput_directive.fillOutput)
+			oend -= LASTLITERALS; /* Hack for support LZ4 format restriction */
+		if (*srcSizePtr < LZ4_minLength)
+			goto _last_literals; /* Input too small, no compression (all literals) */
+
+		/* main loop */
+		while (ip <= mflimit)
+		{
+			uint ipIndex = (uint) (ip - @base);
+
+			/* search long match */
+			{
+				uint h8 = LZ4MID_hash8Ptr(ip);
+				uint pos8 = hash8Table[h8];
+				Assert(pos8 < ipIndex);
+				hash8Table[h8] = ipIndex;
+				if (ipIndex - pos8 <= LZ4_DISTANCE_MAX)
+				{
+					/* match candidate found */
+					if (pos8 >= prefixIdx)
+					{
+						byte* matchPtr = @base + pos8;
+						Assert(matchPtr < ip);
+						matchLength = LZ4_count(ip, matchPtr, matchlimit);
+						if (matchLength >= MINMATCH)
+						{
+							matchDistance = ipIndex - pos8;
+							goto _encode_sequence;
+						}
+					}
+					else if (pos8 >= dictIdx)
+					{
+						/* extDict match candidate */
+						byte* matchPtr = dictBase + pos8;
+						long safeLen = MIN((long) (prefixIdx - pos8), matchlimit - ip);
+						matchLength = LZ4_count(ip, matchPtr, ip + safeLen);
+						if (matchLength >= MINMATCH)
+						{
+							matchDistance = ipIndex - pos8;
+							goto _encode_sequence;
+						}
+					}
+				}
+			}
+
+			/* search short match */
+			{
+				uint h4 = LZ4MID_hash4Ptr(ip);
+				uint pos4 = hash4Table[h4];
+				Assert(pos4 < ipIndex);
+				hash4Table[h4] = ipIndex;
+				if (ipIndex - pos4 <= LZ4_DISTANCE_MAX)
+				{
+					/* match candidate found */
+					if (pos4 >= prefixIdx)
+					{
+						/* only search within prefix */
+						byte* matchPtr = @base + pos4;
+						Assert(matchPtr < ip);
+						matchLength = LZ4_count(ip, matchPtr, matchlimit);
+						if (matchLength >= MINMATCH)
+						{
+							/* short match found, let's just check ip+1 for longer */
+							uint h8 = LZ4MID_hash8Ptr(ip + 1);
+							uint pos8 = hash8Table[h8];
+							uint m2Distance = ipIndex + 1 - pos8;
+							matchDistance = ipIndex - pos4;
+							if (m2Distance <= LZ4_DISTANCE_MAX
+								&& pos8 >= prefixIdx /* only search within prefix */
+								&& ip < mflimit)
+							{
+								byte* m2Ptr = @base + pos8;
+								uint ml2 = LZ4_count(ip + 1, m2Ptr, matchlimit);
+								if (ml2 > matchLength)
+								{
+									hash8Table[h8] = ipIndex + 1;
+									ip++;
+									matchLength = ml2;
+									matchDistance = m2Distance;
+								}
+							}
+
+							goto _encode_sequence;
+						}
+					}
+					else if (pos4 >= dictIdx)
+					{
+						/* extDict match candidate */
+						byte* matchPtr = dictBase + pos4;
+						long safeLen = MIN((long) (prefixIdx - pos4), matchlimit - ip);
+						matchLength = LZ4_count(ip, matchPtr, ip + safeLen);
+						if (matchLength >= MINMATCH)
+						{
+							matchDistance = ipIndex - pos4;
+							goto _encode_sequence;
+						}
+					}
+				}
+			}
+
+			/* no match found */
+			ip += 1 + ((ip - anchor) >> 9); /* skip faster over incompressible data */
+			continue;
+
+			_encode_sequence:
+			/* catch back */
+			while (ip > anchor
+				&& (uint) (ip - prefixPtr) > matchDistance
+				&& ip[-1] == ip[-(int) matchDistance - 1])
+			{
+				ip--;
+				matchLength++;
+			}
+
+			/* fill table with beginning of match */
+			{
+				uint matchIdx = (uint) (ip - @base);
+				hash8Table[LZ4MID_hash8Ptr(ip + 1)] = matchIdx + 1;
+				hash8Table[LZ4MID_hash8Ptr(ip + 2)] = matchIdx + 2;
+				hash4Table[LZ4MID_hash4Ptr(ip + 1)] = matchIdx + 1;
+			}
+
+			/* encode */
+			optr = op;
+			if (LZ4HC_encodeSequence(
+					&ip, &op, &anchor, (int) matchLength, ip - matchDistance, limit, oend) != 0)
+				goto _dest_overflow;
+
+			/* fill table with end of match */
+			{
+				uint endMatchIdx = (uint) (ip - @base);
+				uint pos_m2 = endMatchIdx - 2;
+				if (pos_m2 < ilimitIdx)
+				{
+					if (ip - prefixPtr > 5)
+						hash8Table[LZ4MID_hash8Ptr(ip - 5)] = endMatchIdx - 5;
+					hash8Table[LZ4MID_hash8Ptr(ip - 3)] = endMatchIdx - 3;
+					hash8Table[LZ4MID_hash8Ptr(ip - 2)] = endMatchIdx - 2;
+					hash4Table[LZ4MID_hash4Ptr(ip - 2)] = endMatchIdx - 2;
+					hash4Table[LZ4MID_hash4Ptr(ip - 1)] = endMatchIdx - 1;
+				}
+			}
+		}
+
+		_last_literals:
+		/* Encode Last Literals */
+		{
+			size_t lastRunSize = (size_t) (iend - anchor); /* literals */
+			size_t litLength = (lastRunSize + 255 - RUN_MASK) / 255;
+			size_t totalSize = 1 + litLength + lastRunSize;
+			if (limit == limitedOutput_directive.fillOutput)
+				oend += LASTLITERALS; /* restore correct value */
+			if (limit != 0 && (op + totalSize > oend))
+			{
+				if (limit == limitedOutput_directive.limitedOutput)
+					return 0; /* Check output limit */
+
+				/* adapt lastRunSize to fill 'dest' */
+				lastRunSize = (size_t) (oend - op) - 1;
+				litLength = (lastRunSize + 255 - RUN_MASK) / 255;
+				lastRunSize -= litLength;
+			}
+
+			ip = anchor + lastRunSize;
+
+			if (lastRunSize >= RUN_MASK)
+			{
+				size_t accumulator = lastRunSize - RUN_MASK;
+				*op++ = (byte) (RUN_MASK << ML_BITS);
+				for (; accumulator >= 255; accumulator -= 255) *op++ = 255;
+				*op++ = (byte) accumulator;
+			}
+			else
+			{
+				*op++ = (byte) (lastRunSize << ML_BITS);
+			}
+
+			Mem.Copy(op, anchor, (int) lastRunSize);
+			op += lastRunSize;
+		}
+
+		/* End */
+		*srcSizePtr = (int) (((byte*) ip) - src);
+		return (int) (((byte*) op) - dst);
+
+		_dest_overflow:
+		if (limit == limitedOutput_directive.fillOutput)
+		{
+			op = optr; /* restore correct out pointer */
+			goto _last_literals;
+		}
+
+		return 0;
+	}
+
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	public static int LZ4HC_compress_hashChain(
 		LZ4_streamHC_t* ctx,
@@ -525,7 +989,8 @@ internal unsafe partial class LL64
 		int maxOutputSize,
 		int maxNbAttempts,
 		limitedOutput_directive limit,
-		dictCtx_directive dict)
+		dictCtx_directive dict,
+		HCfavor_e favorDecSpeed)
 	{
 		int inputSize = *srcSizePtr;
 		bool patternAnalysis = (maxNbAttempts > 128); /* levels 9+ */
@@ -560,8 +1025,8 @@ internal unsafe partial class LL64
 		while (ip <= mflimit)
 		{
 			ml = LZ4HC_InsertAndFindBestMatch(
-				ctx, ip, matchlimit, &@ref, maxNbAttempts, patternAnalysis, dict);
-			if (ml < MINMATCH)
+				ctx, ip, matchlimit, &@ref, maxNbAttempts, patternAnalysis, dict, favorDecSpeed);
+			if (ml < (favorDecSpeed != 0 ? LZ4HC_FAVOR_MIN_MATCH : MINMATCH))
 			{
 				ip++;
 				continue;
@@ -579,7 +1044,7 @@ internal unsafe partial class LL64
 					ctx,
 					ip + ml - 2, ip + 0, matchlimit, ml, &ref2, &start2,
 					maxNbAttempts, patternAnalysis, false, dict,
-					HCfavor_e.favorCompressionRatio);
+					favorDecSpeed);
 			}
 			else
 			{
@@ -645,7 +1110,7 @@ internal unsafe partial class LL64
 					ctx,
 					start2 + ml2 - 3, start2, matchlimit, ml2, &ref3, &start3,
 					maxNbAttempts, patternAnalysis, false, dict,
-					HCfavor_e.favorCompressionRatio);
+					favorDecSpeed);
 			}
 			else
 			{
@@ -818,11 +1283,15 @@ internal unsafe partial class LL64
 		limitedOutput_directive limit,
 		bool fullUpdate,
 		dictCtx_directive dict,
-		HCfavor_e favorDecSpeed)
+		HCfavor_e favorDecSpeed,
+		LZ4HC_optimal_t* opt,
+		int optNum,
+		ushort* tree)
 	{
-		const int TRAILING_LITERALS = 3;
-/* ~64 KB, which is a bit large for stack... */
-		LZ4HC_optimal_t* opt = stackalloc LZ4HC_optimal_t[LZ4_OPT_NUM + TRAILING_LITERALS];
+		const int TRAILING_LITERALS = LZ4HC_OPT_TRAILING_LITERALS;
+		/* every extra sequence costs decoder more than a literal or two */
+		int seqPrice = favorDecSpeed != 0 ? LZ4HC_FAVOR_SEQUENCE_PRICE : 0;
+		LZ4HC_match_t* matches = stackalloc LZ4HC_match_t[LZ4HC_BT_MATCHES_MAX];
 
 		byte* ip = (byte*) source;
 		byte* anchor = ip;
@@ -837,7 +1306,7 @@ internal unsafe partial class LL64
 		*srcSizePtr = 0;
 		if (limit == limitedOutput_directive.fillOutput)
 			oend -= LASTLITERALS; /* Hack for support LZ4 format restriction */
-		if (sufficient_len >= LZ4_OPT_NUM) sufficient_len = LZ4_OPT_NUM - 1;
+		if (sufficient_len >= optNum) sufficient_len = (size_t) (optNum - 1);
 
 		/* Main Loop */
 		Assert(ip - anchor < LZ4_MAX_INPUT_SIZE);
@@ -847,14 +1316,17 @@ internal unsafe partial class LL64
 			int best_mlen, best_off;
 			int cur, last_match_pos = 0;
 
-			LZ4HC_match_t firstMatch = LZ4HC_FindLongerMatch(
-				ctx, ip, matchlimit, MINMATCH - 1, nbSearches, dict, favorDecSpeed);
-			if (firstMatch.len == 0)
+			int nbMatches = LZ4HC_FindLongerMatches(
+				ctx, tree, ip, matchlimit, MINMATCH - 1, nbSearches, dict, favorDecSpeed,
+				matches);
+			if (nbMatches == 0)
 			{
 				ip++;
 				continue;
 			}
 
+			LZ4HC_match_t firstMatch = matches[nbMatches - 1];
+
 			if ((size_t) firstMatch.len > sufficient_len)
 			{
 				/* good enough solution : immediate encoding */
@@ -883,12 +1355,15 @@ internal unsafe partial class LL64
 			/* set prices using initial match */
 			{
 				int mlen = MINMATCH;
-				int matchML = firstMatch.len; /* necessarily < sufficient_len < LZ4_OPT_NUM */
-				int offset = firstMatch.off;
-				Assert(matchML < LZ4_OPT_NUM);
+				int matchML = firstMatch.len; /* necessarily < sufficient_len < optNum */
+				int candidate = 0;
+				Assert(matchML < optNum);
 				for (; mlen <= matchML; mlen++)
 				{
-					int cost = LZ4HC_sequencePrice(llen, mlen);
+					/* closest match which is long enough */
+					if (mlen > matches[candidate].len) candidate++;
+					int offset = matches[candidate].off;
+					int cost = LZ4HC_sequencePrice(llen, mlen) + seqPrice;
 					opt[mlen].mlen = mlen;
 					opt[mlen].off = offset;
 					opt[mlen].litlen = llen;
@@ -913,6 +1388,7 @@ internal unsafe partial class LL64
 			{
 				byte* curPtr = ip + cur;
 				LZ4HC_match_t newMatch;
+				int nbNewMatches;
 
 				if (curPtr > mflimit) break;
 
@@ -931,17 +1407,20 @@ internal unsafe partial class LL64
 				}
 
 				if (fullUpdate)
-					newMatch = LZ4HC_FindLongerMatch(
-						ctx, curPtr, matchlimit, MINMATCH - 1, nbSearches, dict, favorDecSpeed);
+					nbNewMatches = LZ4HC_FindLongerMatches(
+						ctx, tree, curPtr, matchlimit, MINMATCH - 1, nbSearches, dict,
+						favorDecSpeed, matches);
 				else
 					/* only test matches of minimum length; slightly faster, but misses a few bytes */
-					newMatch = LZ4HC_FindLongerMatch(
-						ctx, curPtr, matchlimit, last_match_pos - cur, nbSearches, dict,
-						favorDecSpeed);
-				if (newMatch.len == 0) continue;
+					nbNewMatches = LZ4HC_FindLongerMatches(
+						ctx, tree, curPtr, matchlimit, last_match_pos - cur, nbSearches, dict,
+						favorDecSpeed, matches);
+				if (nbNewMatches == 0) continue;
+
+				newMatch = matches[nbNewMatches - 1];
 
 				if (((size_t) newMatch.len > sufficient_len)
-					|| (newMatch.len + cur >= LZ4_OPT_NUM))
+					|| (newMatch.len + cur >= optNum))
 				{
 					/* immediate encoding */
 					best_mlen = newMatch.len;
@@ -973,31 +1452,33 @@ internal unsafe partial class LL64
 				{
 					int matchML = newMatch.len;
 					int ml = MINMATCH;
+					int candidate = 0;
 
-					Assert(cur + newMatch.len < LZ4_OPT_NUM);
+					Assert(cur + newMatch.len < optNum);
 					for (; ml <= matchML; ml++)
 					{
 						int pos = cur + ml;
-						int offset = newMatch.off;
+						if (ml > matches[candidate].len) candidate++;
+						int offset = matches[candidate].off;
 						int price;
 						int ll;
 						if (opt[cur].mlen == 1)
 						{
 							ll = opt[cur].litlen;
 							price = ((cur > ll) ? opt[cur - ll].price : 0)
-								+ LZ4HC_sequencePrice(ll, ml);
+								+ LZ4HC_sequencePrice(ll, ml) + seqPrice;
 						}
 						else
 						{
 							ll = 0;
-							price = opt[cur].price + LZ4HC_sequencePrice(0, ml);
+							price = opt[cur].price + LZ4HC_sequencePrice(0, ml) + seqPrice;
 						}
 
 						Assert((uint) favorDecSpeed <= 1);
 						if (pos > last_match_pos + TRAILING_LITERALS
 							|| price <= opt[pos].price - (int) favorDecSpeed)
 						{
-							Assert(pos < LZ4_OPT_NUM);
+							Assert(pos < optNum);
 							if ((ml == matchML) /* last pos of last match */
 								&& (last_match_pos < pos))
 								last_match_pos = pos;
@@ -1022,13 +1503,13 @@ internal unsafe partial class LL64
 				}
 			} /* for (cur = 1; cur <= last_match_pos; cur++) */
 
-			Assert(last_match_pos < LZ4_OPT_NUM + TRAILING_LITERALS);
+			Assert(last_match_pos < optNum + TRAILING_LITERALS);
 			best_mlen = opt[last_match_pos].mlen;
 			best_off = opt[last_match_pos].off;
 			cur = last_match_pos - best_mlen;
 
 			encode: /* cur, last_match_pos, best_mlen, best_off must be set */
-			Assert(cur < LZ4_OPT_NUM);
+			Assert(cur < optNum);
 			Assert(last_match_pos >= 1); /* == 1 when only one candidate */
 			{
 				int candidate_pos = cur;
@@ -1128,22 +1609,6 @@ internal unsafe partial class LL64
 		return 0;
 	}
 
-	protected static cParams_t[] clTable = {
-		new cParams_t(lz4hc_strat_e.lz4hc, 2, 16), /* 0, unused */
-		new cParams_t(lz4hc_strat_e.lz4hc, 2, 16), /* 1, unused */
-		new cParams_t(lz4hc_strat_e.lz4hc, 2, 16), /* 2, unused */
-		new cParams_t(lz4hc_strat_e.lz4hc, 4, 16), /* 3 */
-		new cParams_t(lz4hc_strat_e.lz4hc, 8, 16), /* 4 */
-		new cParams_t(lz4hc_strat_e.lz4hc, 16, 16), /* 5 */
-		new cParams_t(lz4hc_strat_e.lz4hc, 32, 16), /* 6 */
-		new cParams_t(lz4hc_strat_e.lz4hc, 64, 16), /* 7 */
-		new cParams_t(lz4hc_strat_e.lz4hc, 128, 16), /* 8 */
-		new cParams_t(lz4hc_strat_e.lz4hc, 256, 16), /* 9 */
-		new cParams_t(lz4hc_strat_e.lz4opt, 96, 64), /*10==LZ4HC_CLEVEL_OPT_MIN*/
-		new cParams_t(lz4hc_strat_e.lz4opt, 512, 128), /*11 */
-		new cParams_t(lz4hc_strat_e.lz4opt, 16384, LZ4_OPT_NUM), /* 12==LZ4HC_CLEVEL_MAX */
-	};
-
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	public static int LZ4HC_compress_generic_internal(
 		LZ4_streamHC_t* ctx,
@@ -1161,33 +1626,81 @@ internal unsafe partial class LL64
 			return 0; /* Unsupported input size (too large or negative) */
 
 		ctx->end += *srcSizePtr;
+
+		/* blocks of single repeated byte are encoded directly, positions are not indexed
+		 * (next blocks referencing it would most likely be runs as well) */
+		if (*srcSizePtr >= LZ4_minLength && LZ4_isRun(src, *srcSizePtr))
+		{
+			int result = LZ4_compress_run(
+				src, dst, *srcSizePtr,
+				limit == limitedOutput_directive.notLimited
+					? LZ4_compressBound(*srcSizePtr)
+					: dstCapacity);
+			if (result > 0)
+			{
+				ctx->nextToUpdate = (uint) (ctx->end - ctx->@base);
+				return result;
+			}
+		}
+
 		if (cLevel < 1)
 			cLevel =
 				LZ4HC_CLEVEL_DEFAULT; /* note : convention is different from lz4frame, maybe something to review */
-		cLevel = MIN(LZ4HC_CLEVEL_MAX, cLevel);
+		cLevel = MIN(LZ4HC_CLEVEL_ULTRA, cLevel);
 		{
-			cParams_t cParam = clTable[cLevel];
+			cParams_t cParam = LZ4HC_getCLevelParams(cLevel);
+			if (ctx->nbSearches != 0) cParam.nbSearches = ctx->nbSearches;
+			if (ctx->targetLength != 0) cParam.targetLength = ctx->targetLength;
 			HCfavor_e favor = ctx->favorDecSpeed
 				? HCfavor_e.favorDecompressionSpeed
 				: HCfavor_e.favorCompressionRatio;
 			int result;
 
-			if (cParam.strat == lz4hc_strat_e.lz4hc)
+			if (cParam.strat == lz4hc_strat_e.lz4mid)
+			{
+				result = LZ4MID_compress(
+					ctx,
+					src, dst, srcSizePtr, dstCapacity,
+					limit, dict);
+			}
+			else if (cParam.strat == lz4hc_strat_e.lz4hc)
 			{
 				result = LZ4HC_compress_hashChain(
 					ctx,
 					src, dst, srcSizePtr, dstCapacity,
-					(int) cParam.nbSearches, limit, dict);
+					(int) cParam.nbSearches, limit, dict, favor);
 			}
 			else
 			{
 				Assert(cParam.strat == lz4hc_strat_e.lz4opt);
-				result = LZ4HC_compress_optimal(
-					ctx,
-					src, dst, srcSizePtr, dstCapacity,
-					(int) cParam.nbSearches, cParam.targetLength, limit,
-					cLevel == LZ4HC_CLEVEL_MAX, /* ultra mode */
-					dict, favor);
+				LZ4HC_opt_t* state = ctx->opt;
+				PinnedMemory statePin = default;
+				if (state == null)
+				{
+					/* no state attached, temporary one with default window (off the stack) */
+					int optNum = LZ4HC_getOptNum(cLevel, 0);
+					PinnedMemory.Alloc(out statePin, LZ4_sizeofStateOptHC(optNum, false), false);
+					state = LZ4_initStateOptHC(statePin.Pointer, optNum, false);
+				}
+
+				try
+				{
+					/* binary tree needs single memory segment (no extDict) */
+					ushort* tree =
+						dict == dictCtx_directive.noDictCtx && ctx->lowLimit == ctx->dictLimit
+							? state->binTree
+							: null;
+					result = LZ4HC_compress_optimal(
+						ctx,
+						src, dst, srcSizePtr, dstCapacity,
+						(int) cParam.nbSearches, cParam.targetLength, limit,
+						cLevel >= LZ4HC_CLEVEL_MAX, /* ultra mode */
+						dict, favor, state->parse, state->optNum, tree);
+				}
+				finally
+				{
+					statePin.Free();
+				}
 			}
 
 			if (result <= 0) ctx->dirty = true;
@@ -1372,17 +1885,35 @@ internal unsafe partial class LL64
 	}
 
 	public static int LZ4_compress_HC(
-		byte* src, byte* dst, int srcSize, int dstCapacity, int compressionLevel)
+		byte* src, byte* dst, int srcSize, int dstCapacity, int compressionLevel) =>
+		LZ4_compress_HC(src, dst, srcSize, dstCapacity, compressionLevel, 0, 0, false, false, 0);
+
+	public static int LZ4_compress_HC(
+		byte* src, byte* dst, int srcSize, int dstCapacity, int compressionLevel,
+		int nbSearches, int targetLength, bool favorDecSpeed, bool binaryTree, int optNum)
 	{
+		var optimal = compressionLevel >= LZ4HC_CLEVEL_OPT_MIN;
+		optNum = LZ4HC_getOptNum(compressionLevel, optNum);
 		PinnedMemory.Alloc(out var contextPin, sizeof(LZ4_streamHC_t), false);
+		var optPin = optimal
+			? PinnedMemory.Alloc(LZ4_sizeofStateOptHC(optNum, binaryTree), false)
+			: default;
 		try
 		{
 			var contextPtr = contextPin.Reference<LZ4_streamHC_t>();
-			return LZ4_compress_HC_extStateHC(
-				contextPtr, src, dst, srcSize, dstCapacity, compressionLevel);
+			var ctx = LZ4_initStreamHC(contextPtr);
+			if (ctx == null) return 0; /* init failure */
+
+			if (optimal)
+				LZ4_attachOptHC(ctx, LZ4_initStateOptHC(optPin.Pointer, optNum, binaryTree));
+			LZ4_setSearchParameters(ctx, nbSearches, targetLength);
+			LZ4_favorDecompressionSpeed(ctx, favorDecSpeed ? 1 : 0);
+			return LZ4_compress_HC_extStateHC_fastReset(
+				ctx, src, dst, srcSize, dstCapacity, compressionLevel);
 		}
 		finally
 		{
+			optPin.Free();
 			contextPin.Free();
 		}
 	}
@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+//
+// This file has been generated. All changes will be lost.
+//
+//------------------------------------------------------------------------------
+#define BIT32
+
+// ReSharper disable IdentifierTypo
+// ReSharper disable InconsistentNaming
+// ReSharper disable AccessToStaticMemberViaDerivedType
+// ReSharper disable BuiltInTypeReferenceStyle
+
+using System.Runtime.CompilerServices;
+
+#if BIT32
+using Mem = K4os.Compression.LZ4.Internal.Mem32;
+#else
+using Mem = K4os.Compression.LZ4.Internal.Mem64;
+#endif
+
+namespace K4os.Compression.LZ4.Engine;
+
+#if BIT32
+internal unsafe partial class LL32
+#else
+internal unsafe partial class LL64
+#endif
+{
+	/// <summary>
+	/// Entry points to hot functions, so they can be measured in isolation
+	/// (see <see cref="Pubternal"/>). They are still inlined, so callers see exactly
+	/// the same code as compressor and decompressor do.
+	/// </summary>
+	internal static class Kernels
+	{
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static uint Count(byte* pIn, byte* pMatch, byte* pInLimit) =>
+			LZ4_count(pIn, pMatch, pInLimit);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static uint Hash4(uint sequence, bool small) =>
+			LZ4_hash4(sequence, small ? tableType_t.byU16 : tableType_t.byU32);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static uint Hash5(ulong sequence, bool small) =>
+			LZ4_hash5(sequence, small ? tableType_t.byU16 : tableType_t.byU32);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static uint HashPosition(void* p, bool small) =>
+			LZ4_hashPosition(p, small ? tableType_t.byU16 : tableType_t.byU32);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static void WildCopy8(byte* target, byte* source, void* limit) =>
+			Mem.WildCopy8(target, source, limit);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static void MatchCopy(byte* target, byte* match, byte* limit, uint offset) =>
+			LZ4_memcpy_using_offset_base(target, match, limit, offset);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static uint CountPattern(byte* ip, byte* iEnd, uint pattern) =>
+			LZ4HC_countPattern(ip, iEnd, pattern);
+	}
+}
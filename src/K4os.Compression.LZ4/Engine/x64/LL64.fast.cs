@@ -43,7 +43,8 @@ internal unsafe partial class LL64
 		tableType_t tableType,
 		dict_directive dictDirective,
 		dictIssue_directive dictIssue,
-		int acceleration)
+		int acceleration,
+		int hashLog = LZ4_HASHLOG)
 	{
 		int result;
 		byte* ip = (byte*) source;
@@ -94,6 +95,7 @@ internal unsafe partial class LL64
 		if (tableType == tableType_t.byPtr)
 			Assert(dictDirective == dict_directive.noDict);
 		Assert(acceleration >= 1);
+		Assert(hashLog >= LZ4_HASHLOG_MIN && hashLog <= LZ4_HASHLOG);
 
 		lowLimit = (byte*) source
 			- (dictDirective == dict_directive.withPrefix64k ? dictSize : 0);
@@ -116,10 +118,26 @@ internal unsafe partial class LL64
 
 		if (inputSize < LZ4_minLength) goto _last_literals;
 
+		/* zero-filled (or any other single byte) blocks do not need match finder at all */
+		if (LZ4_isRun(ip, inputSize))
+		{
+			result = LZ4_compress_run(
+				ip, op, inputSize,
+				outputDirective == limitedOutput_directive.notLimited
+					? LZ4_compressBound(inputSize)
+					: maxOutputSize);
+			if (result > 0)
+			{
+				if (outputDirective == limitedOutput_directive.fillOutput)
+					*inputConsumed = inputSize;
+				return result;
+			}
+		}
+
 		/* First Byte */
-		LZ4_putPosition(ip, cctx->hashTable, tableType, @base);
+		LZ4_putPosition(ip, cctx->hashTable, tableType, @base, hashLog);
 		ip++;
-		forwardH = LZ4_hashPosition(ip, tableType);
+		forwardH = LZ4_hashPosition(ip, tableType, hashLog);
 
 		/* Main Loop */
 		for (;;)
@@ -146,7 +164,7 @@ internal unsafe partial class LL64
 					Assert(ip < mflimitPlusOne);
 
 					match = LZ4_getPositionOnHash(h, cctx->hashTable, tableType, @base);
-					forwardH = LZ4_hashPosition(forwardIp, tableType);
+					forwardH = LZ4_hashPosition(forwardIp, tableType, hashLog);
 					LZ4_putPositionOnHash(ip, h, cctx->hashTable, tableType, @base);
 				}
 				while ((match + LZ4_DISTANCE_MAX < ip) || (Mem.Peek4(match) != Mem.Peek4(ip)));
@@ -209,7 +227,7 @@ internal unsafe partial class LL64
 						match = @base + matchIndex;
 					}
 
-					forwardH = LZ4_hashPosition(forwardIp, tableType);
+					forwardH = LZ4_hashPosition(forwardIp, tableType, hashLog);
 					LZ4_putIndexOnHash(current, h, cctx->hashTable, tableType);
 
 					if ((dictIssue == dictIssue_directive.dictSmall)
@@ -350,7 +368,7 @@ internal unsafe partial class LL64
 							byte* ptr;
 							for (ptr = ip; ptr <= filledIp; ++ptr)
 							{
-								uint h = LZ4_hashPosition(ptr, tableType);
+								uint h = LZ4_hashPosition(ptr, tableType, hashLog);
 								LZ4_clearHash(h, cctx->hashTable, tableType);
 							}
 						}
@@ -391,13 +409,13 @@ internal unsafe partial class LL64
 			if (ip >= mflimitPlusOne) break;
 
 			/* Fill table */
-			LZ4_putPosition(ip - 2, cctx->hashTable, tableType, @base);
+			LZ4_putPosition(ip - 2, cctx->hashTable, tableType, @base, hashLog);
 
 			/* Test next position */
 			if (tableType == tableType_t.byPtr)
 			{
-				match = LZ4_getPosition(ip, cctx->hashTable, tableType, @base);
-				LZ4_putPosition(ip, cctx->hashTable, tableType, @base);
+				match = LZ4_getPosition(ip, cctx->hashTable, tableType, @base, hashLog);
+				LZ4_putPosition(ip, cctx->hashTable, tableType, @base, hashLog);
 				if ((match + LZ4_DISTANCE_MAX >= ip) && (Mem.Peek4(match) == Mem.Peek4(ip)))
 				{
 					token = op++;
@@ -409,7 +427,7 @@ internal unsafe partial class LL64
 			{
 				/* byU32, byU16 */
 
-				uint h = LZ4_hashPosition(ip, tableType);
+				uint h = LZ4_hashPosition(ip, tableType, hashLog);
 				uint current = (uint) (ip - @base);
 				uint matchIndex = LZ4_getIndexOnHash(h, cctx->hashTable, tableType);
 				Assert(matchIndex < current);
@@ -463,7 +481,7 @@ internal unsafe partial class LL64
 				}
 			}
 
-			forwardH = LZ4_hashPosition(++ip, tableType);
+			forwardH = LZ4_hashPosition(++ip, tableType, hashLog);
 		}
 
 		_last_literals:
@@ -516,9 +534,11 @@ internal unsafe partial class LL64
 
 	public static int LZ4_compress_fast_extState(
 		LZ4_stream_t* state, byte* source, byte* dest, int inputSize, int maxOutputSize,
-		int acceleration)
+		int acceleration, int hashLog = LZ4_HASHLOG)
 	{
-		var ctx = LZ4_initStream(state);
+		if (hashLog < LZ4_HASHLOG_MIN) hashLog = LZ4_HASHLOG_MIN;
+		if (hashLog > LZ4_HASHLOG) hashLog = LZ4_HASHLOG;
+		var ctx = hashLog < LZ4_HASHLOG ? LZ4_initStream(state, hashLog) : LZ4_initStream(state);
 		Assert(ctx != null);
 		if (acceleration < 1) acceleration = ACCELERATION_DEFAULT;
 		if (maxOutputSize >= LZ4_compressBound(inputSize))
@@ -529,7 +549,7 @@ internal unsafe partial class LL64
 					ctx, source, dest,
 					inputSize, null, 0, limitedOutput_directive.notLimited,
 					tableType_t.byU16, dict_directive.noDict, dictIssue_directive.noDictIssue,
-					acceleration);
+					acceleration, hashLog);
 			}
 			else
 			{
@@ -540,7 +560,7 @@ internal unsafe partial class LL64
 					ctx, source, dest,
 					inputSize, null, 0, limitedOutput_directive.notLimited,
 					tableType, dict_directive.noDict, dictIssue_directive.noDictIssue,
-					acceleration);
+					acceleration, hashLog);
 			}
 		}
 		else
@@ -551,7 +571,7 @@ internal unsafe partial class LL64
 					ctx, source, dest,
 					inputSize, null, maxOutputSize, limitedOutput_directive.limitedOutput,
 					tableType_t.byU16, dict_directive.noDict, dictIssue_directive.noDictIssue,
-					acceleration);
+					acceleration, hashLog);
 			}
 			else
 			{
@@ -562,17 +582,18 @@ internal unsafe partial class LL64
 					ctx, source, dest,
 					inputSize, null, maxOutputSize, limitedOutput_directive.limitedOutput,
 					tableType, dict_directive.noDict, dictIssue_directive.noDictIssue,
-					acceleration);
+					acceleration, hashLog);
 			}
 		}
 	}
 
 	public static int LZ4_compress_fast(
-		byte* source, byte* dest, int inputSize, int maxOutputSize, int acceleration)
+		byte* source, byte* dest, int inputSize, int maxOutputSize, int acceleration,
+		int hashLog = LZ4_HASHLOG)
 	{
 		LZ4_stream_t ctx;
 		return LZ4_compress_fast_extState(
-			&ctx, source, dest, inputSize, maxOutputSize, acceleration);
+			&ctx, source, dest, inputSize, maxOutputSize, acceleration, hashLog);
 	}
 
 	public static int LZ4_compress_default(
@@ -583,7 +604,7 @@ internal unsafe partial class LL64
 		LZ4_stream_t* LZ4_stream,
 		byte* source, byte* dest,
 		int inputSize, int maxOutputSize,
-		int acceleration)
+		int acceleration, int hashLog = LZ4_HASHLOG)
 	{
 		const tableType_t tableType = tableType_t.byU32;
 		var streamPtr = LZ4_stream;
@@ -593,6 +614,8 @@ internal unsafe partial class LL64
 
 		LZ4_renormDictT(streamPtr, inputSize);
 		if (acceleration < 1) acceleration = ACCELERATION_DEFAULT;
+		if (hashLog < LZ4_HASHLOG_MIN) hashLog = LZ4_HASHLOG_MIN;
+		if (hashLog > LZ4_HASHLOG) hashLog = LZ4_HASHLOG;
 
 		if (streamPtr->dictSize - 1 < 4 - 1 && dictEnd != source)
 		{
@@ -620,7 +643,7 @@ internal unsafe partial class LL64
 					streamPtr, source, dest, inputSize, null, maxOutputSize,
 					limitedOutput_directive.limitedOutput, tableType,
 					dict_directive.withPrefix64k, dictIssue_directive.dictSmall, 
-					acceleration);
+					acceleration, hashLog);
 			}
 			else
 			{
@@ -628,7 +651,7 @@ internal unsafe partial class LL64
 					streamPtr, source, dest, inputSize, null, maxOutputSize,
 					limitedOutput_directive.limitedOutput, tableType,
 					dict_directive.withPrefix64k, dictIssue_directive.noDictIssue,
-					acceleration);
+					acceleration, hashLog);
 			}
 		}
 
@@ -640,11 +663,11 @@ internal unsafe partial class LL64
 					Mem.Copy((byte*)streamPtr, (byte*)streamPtr->dictCtx, sizeof(LZ4_stream_t));
 					result = LZ4_compress_generic(
 						streamPtr, source, dest, inputSize, null, maxOutputSize, limitedOutput_directive.limitedOutput,
-						tableType, dict_directive.usingExtDict, dictIssue_directive.noDictIssue, acceleration);
+						tableType, dict_directive.usingExtDict, dictIssue_directive.noDictIssue, acceleration, hashLog);
 				} else {
 					result = LZ4_compress_generic(
 						streamPtr, source, dest, inputSize, null, maxOutputSize, limitedOutput_directive.limitedOutput,
-						tableType, dict_directive.usingDictCtx, dictIssue_directive.noDictIssue, acceleration);
+						tableType, dict_directive.usingDictCtx, dictIssue_directive.noDictIssue, acceleration, hashLog);
 				}
 			}
 			else
@@ -652,11 +675,11 @@ internal unsafe partial class LL64
 				if ((streamPtr->dictSize < 64 * KB) && (streamPtr->dictSize < streamPtr->currentOffset)) {
 					result = LZ4_compress_generic(
 						streamPtr, source, dest, inputSize, null, maxOutputSize, limitedOutput_directive.limitedOutput,
-						tableType, dict_directive.usingExtDict, dictIssue_directive.dictSmall, acceleration);
+						tableType, dict_directive.usingExtDict, dictIssue_directive.dictSmall, acceleration, hashLog);
 				} else {
 					result = LZ4_compress_generic(
 						streamPtr, source, dest, inputSize, null, maxOutputSize, limitedOutput_directive.limitedOutput,
-						tableType, dict_directive.usingExtDict, dictIssue_directive.noDictIssue, acceleration);
+						tableType, dict_directive.usingExtDict, dictIssue_directive.noDictIssue, acceleration, hashLog);
 				}
 			}
 
@@ -19,6 +19,10 @@ using Mem = K4os.Compression.LZ4.Internal.Mem64;
 using System.Numerics;
 #endif
 
+#if NET7_0_OR_GREATER && !BIT32
+using System.Runtime.Intrinsics;
+#endif
+
 using size_t = System.UInt32;
 using uptr_t = System.UInt64;
 
@@ -100,6 +104,26 @@ internal unsafe partial class LL64: LL
 			pMatch += STEPSIZE;
 		}
 
+		#if NET7_0_OR_GREATER && !BIT32
+
+		/* long matches (and runs, where pMatch is pIn - 1) are compared 32 bytes at a time */
+		if (Vector256.IsHardwareAccelerated)
+		{
+			while (pIn < pInLimit - 31)
+			{
+				var mask = Vector256
+					.Equals(Vector256.Load(pIn), Vector256.Load(pMatch))
+					.ExtractMostSignificantBits();
+				if (mask != uint.MaxValue)
+					return (uint)(pIn + BitOperations.TrailingZeroCount(~mask) - pStart);
+
+				pIn += 32;
+				pMatch += 32;
+			}
+		}
+
+		#endif
+
 		while (pIn < pInLimit - (STEPSIZE - 1))
 		{
 			var diff = Mem.PeekW(pMatch) ^ Mem.PeekW(pIn);
@@ -132,25 +156,36 @@ internal unsafe partial class LL64: LL
 		return (uint)(pIn - pStart);
 	}
 
+	/* checks if block is single byte repeated (like zero-filled pages), comparing block
+	 * with itself shifted by one byte; gives up on first different byte */
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	protected static bool LZ4_isRun(byte* src, int srcSize) =>
+		srcSize > 1 && LZ4_count(src + 1, src, src + srcSize) == (uint) (srcSize - 1);
+
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
-	protected static uint LZ4_hashPosition(void* p, tableType_t tableType)
+	protected static uint LZ4_hashPosition(
+		void* p, tableType_t tableType, int hashLog = LZ4_HASHLOG)
 	{
 		#if !BIT32
 		if (tableType != tableType_t.byU16)
-			return LZ4_hash5(Mem.PeekW(p), tableType);
+			return LZ4_hash5(Mem.PeekW(p), tableType, hashLog);
 		#endif
-		return LZ4_hash4(Mem.Peek4(p), tableType);
+		return LZ4_hash4(Mem.Peek4(p), tableType, hashLog);
 	}
 
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	protected static void LZ4_putPosition(
-		byte* p, void* tableBase, tableType_t tableType, byte* srcBase) =>
-		LZ4_putPositionOnHash(p, LZ4_hashPosition(p, tableType), tableBase, tableType, srcBase);
+		byte* p, void* tableBase, tableType_t tableType, byte* srcBase,
+		int hashLog = LZ4_HASHLOG) =>
+		LZ4_putPositionOnHash(
+			p, LZ4_hashPosition(p, tableType, hashLog), tableBase, tableType, srcBase);
 
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	protected static byte* LZ4_getPosition(
-		byte* p, void* tableBase, tableType_t tableType, byte* srcBase) =>
-		LZ4_getPositionOnHash(LZ4_hashPosition(p, tableType), tableBase, tableType, srcBase);
+		byte* p, void* tableBase, tableType_t tableType, byte* srcBase,
+		int hashLog = LZ4_HASHLOG) =>
+		LZ4_getPositionOnHash(
+			LZ4_hashPosition(p, tableType, hashLog), tableBase, tableType, srcBase);
 
 	#region dictionary
 
@@ -172,7 +207,7 @@ internal unsafe partial class LL64: LL
 		LZ4_dict->dictionary = dictEnd - LZ4_dict->dictSize;
 	}
 
-	public int LZ4_loadDict(LZ4_stream_t* LZ4_dict, byte* dictionary, int dictSize)
+	public static int LZ4_loadDict(LZ4_stream_t* LZ4_dict, byte* dictionary, int dictSize)
 	{
 		const int HASH_UNIT = ALGORITHM_ARCH;
 		var dict = LZ4_dict;
@@ -0,0 +1,390 @@
+#nullable enable
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+namespace K4os.Compression.LZ4.Internal;
+
+/// <summary>
+/// Pool of large buffers, sized for LZ4 frame blocks (64KB, 256KB, 1MB and 4MB, each
+/// with some room for compression bound and block framing). Shared array pool does not
+/// cache arrays that large on all runtimes, so without it every frame reader and writer
+/// using large blocks would allocate fresh arrays on large object heap.
+/// Cached buffers are spread over slots picked by current processor, and are released
+/// when pool has not been used for <see cref="TrimInterval"/>. Their total size is limited
+/// by <see cref="MaxCachedBytes"/>. Trim timer runs only while pool holds some buffers.
+/// </summary>
+public static class BlockBufferPool
+{
+	private static readonly int[] BlockSizes = { Mem.K64, Mem.K256, Mem.M1, Mem.M4 };
+
+	/// <summary>
+	/// Minimum requested size served by this pool. Smaller requests are expected
+	/// to be served by shared array pool.
+	/// </summary>
+	public const int MinPooledSize = Mem.K32;
+
+	/// <summary>Maximum requested size served by this pool.</summary>
+	public static readonly int MaxPooledSize = BufferLength(Mem.M4);
+
+	private static Bucket[] _buckets = CreateBuckets(DefaultCapacity());
+	private static bool _enabled = true;
+	private static long _maxCachedBytes = 32 * Mem.M1;
+	private static long _cachedBytes;
+	private static TimeSpan _trimInterval = TimeSpan.FromSeconds(60);
+	private static Timer? _trimTimer;
+
+	private static long _hits;
+	private static long _misses;
+	private static long _returns;
+	private static long _drops;
+	private static long _trims;
+
+	/// <summary>Indicates if pool is enabled. When disabled no buffers are cached,
+	/// and requests fall back to shared array pool.</summary>
+	public static bool Enabled
+	{
+		get => _enabled;
+		set
+		{
+			_enabled = value;
+			if (!value) Trim();
+		}
+	}
+
+	/// <summary>
+	/// Maximum number of buffers cached for every block size. Default is number
+	/// of processors (but no less than 2 and no more than 32). Changing it releases
+	/// all cached buffers.
+	/// </summary>
+	public static int Capacity
+	{
+		get => _buckets[0].Capacity;
+		set
+		{
+			var buckets = _buckets;
+			_buckets = CreateBuckets(Math.Max(1, value));
+			foreach (var bucket in buckets) Release(bucket);
+			StopTrimTimerIfEmpty();
+		}
+	}
+
+	/// <summary>
+	/// Maximum number of bytes held by cached buffers (all block sizes together), so pool
+	/// does not keep too much memory with large blocks (4MB buffers would fill 32 slots with
+	/// 128MB). Buffers returned when pool is full are dropped. Default is 32MB. Lowering it
+	/// below currently cached bytes releases all cached buffers.
+	/// </summary>
+	public static long MaxCachedBytes
+	{
+		get => Interlocked.Read(ref _maxCachedBytes);
+		set
+		{
+			Interlocked.Exchange(ref _maxCachedBytes, Math.Max(0, value));
+			if (Interlocked.Read(ref _cachedBytes) > value) Trim();
+		}
+	}
+
+	/// <summary>
+	/// Cached buffers of given size are released if they were not needed for this
+	/// long. Use <see cref="TimeSpan.Zero"/> to never release them.
+	/// </summary>
+	public static TimeSpan TrimInterval
+	{
+		get => _trimInterval;
+		set
+		{
+			_trimInterval = value < TimeSpan.Zero ? TimeSpan.Zero : value;
+			_trimTimer?.Change(TrimPeriod(), TrimPeriod());
+		}
+	}
+
+	/// <summary>Number of requests served with cached buffer.</summary>
+	public static long Hits => Interlocked.Read(ref _hits);
+
+	/// <summary>Number of requests which required new buffer to be allocated.</summary>
+	public static long Misses => Interlocked.Read(ref _misses);
+
+	/// <summary>Number of buffers returned to the pool and cached.</summary>
+	public static long Returns => Interlocked.Read(ref _returns);
+
+	/// <summary>Number of buffers returned to the pool, but dropped as pool was full
+	/// (or disabled).</summary>
+	public static long Drops => Interlocked.Read(ref _drops);
+
+	/// <summary>Number of cached buffers released because pool was idle.</summary>
+	public static long Trims => Interlocked.Read(ref _trims);
+
+	/// <summary>Number of currently cached buffers.</summary>
+	public static int CachedBuffers
+	{
+		get
+		{
+			var result = 0;
+			foreach (var bucket in _buckets) result += bucket.Count;
+			return result;
+		}
+	}
+
+	/// <summary>Number of bytes held by currently cached buffers.</summary>
+	public static long CachedBytes
+	{
+		get
+		{
+			var result = 0L;
+			foreach (var bucket in _buckets) result += (long)bucket.Count * bucket.Length;
+			return result;
+		}
+	}
+
+	/// <summary>Indicates if trim timer is running (it runs only while pool holds buffers).</summary>
+	public static bool TrimScheduled => Volatile.Read(ref _trimTimer) is not null;
+
+	/// <summary>Resets all counters.</summary>
+	public static void ResetCounters()
+	{
+		Interlocked.Exchange(ref _hits, 0);
+		Interlocked.Exchange(ref _misses, 0);
+		Interlocked.Exchange(ref _returns, 0);
+		Interlocked.Exchange(ref _drops, 0);
+		Interlocked.Exchange(ref _trims, 0);
+	}
+
+	/// <summary>Releases all cached buffers.</summary>
+	public static void Trim()
+	{
+		foreach (var bucket in _buckets)
+			Interlocked.Add(ref _trims, Release(bucket));
+		StopTrimTimerIfEmpty();
+	}
+
+	/// <summary>Length of buffers pooled for given block size.</summary>
+	/// <param name="blockSize">Block size.</param>
+	/// <returns>Buffer length.</returns>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static int BufferLength(int blockSize) =>
+		// compression bound, plus room for block framing (and some extra to make it
+		// very unlikely to be power of 2, so it never matches buffer from array pool)
+		blockSize + blockSize / 255 + 16 + 64;
+
+	/// <summary>Rents buffer for given size, if size is handled by this pool.</summary>
+	/// <param name="size">Requested size.</param>
+	/// <returns>Buffer, or <c>null</c> if this pool does not handle such size.</returns>
+	public static byte[]? TryRent(int size)
+	{
+		if (!_enabled || size < MinPooledSize || size > MaxPooledSize)
+			return null;
+
+		var bucket = FindBucket(_buckets, size);
+		var array = bucket.TryTake();
+		if (array is not null)
+		{
+			Interlocked.Add(ref _cachedBytes, -bucket.Length);
+			Interlocked.Increment(ref _hits);
+			return array;
+		}
+
+		Interlocked.Increment(ref _misses);
+		return new byte[bucket.Length];
+	}
+
+	/// <summary>Returns buffer to the pool, if it has been rented from it.</summary>
+	/// <param name="buffer">Buffer.</param>
+	/// <returns><c>true</c> if buffer belonged to this pool (even if it has not been
+	/// cached); <c>false</c> if it needs to be handled by someone else.</returns>
+	public static bool TryReturn(byte[] buffer)
+	{
+		var length = buffer.Length;
+		if (length < MinPooledSize || length > MaxPooledSize)
+			return false;
+
+		var bucket = FindBucket(_buckets, length);
+		if (bucket.Length != length)
+			return false;
+
+		if (_enabled && TryReserve(length))
+		{
+			if (bucket.TryPut(buffer))
+			{
+				Interlocked.Increment(ref _returns);
+				EnsureTrimTimer();
+				return true;
+			}
+
+			Interlocked.Add(ref _cachedBytes, -length);
+		}
+
+		Interlocked.Increment(ref _drops);
+		return true;
+	}
+
+	private static bool TryReserve(int length)
+	{
+		if (Interlocked.Add(ref _cachedBytes, length) <= Interlocked.Read(ref _maxCachedBytes))
+			return true;
+
+		Interlocked.Add(ref _cachedBytes, -length);
+		return false;
+	}
+
+	private static int Release(Bucket bucket)
+	{
+		var count = bucket.Trim();
+		if (count > 0) Interlocked.Add(ref _cachedBytes, -(long)count * bucket.Length);
+		return count;
+	}
+
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	private static Bucket FindBucket(Bucket[] buckets, int size)
+	{
+		var last = buckets.Length - 1;
+		for (var i = 0; i < last; i++)
+			if (size <= buckets[i].Length)
+				return buckets[i];
+
+		return buckets[last];
+	}
+
+	private static int DefaultCapacity() =>
+		Math.Min(Math.Max(Environment.ProcessorCount, 2), 32);
+
+	private static Bucket[] CreateBuckets(int capacity)
+	{
+		var result = new Bucket[BlockSizes.Length];
+		for (var i = 0; i < result.Length; i++)
+			result[i] = new Bucket(BufferLength(BlockSizes[i]), capacity);
+		return result;
+	}
+
+	private static TimeSpan TrimPeriod() =>
+		_trimInterval > TimeSpan.Zero ? _trimInterval : Timeout.InfiniteTimeSpan;
+
+	private static void EnsureTrimTimer()
+	{
+		if (_trimTimer is not null)
+			return;
+
+		var timer = new Timer(_ => TrimIdle(), null, Timeout.Infinite, Timeout.Infinite);
+		if (Interlocked.CompareExchange(ref _trimTimer, timer, null) is null)
+			timer.Change(TrimPeriod(), TrimPeriod());
+		else
+			timer.Dispose();
+	}
+
+	private static void StopTrimTimerIfEmpty()
+	{
+		if (Interlocked.Read(ref _cachedBytes) > 0)
+			return;
+
+		Interlocked.Exchange(ref _trimTimer, null)?.Dispose();
+
+		// buffer could have been cached while timer was being stopped
+		if (Interlocked.Read(ref _cachedBytes) > 0)
+			EnsureTrimTimer();
+	}
+
+	private static void TrimIdle()
+	{
+		var interval = _trimInterval;
+		if (interval <= TimeSpan.Zero)
+			return;
+
+		var now = Environment.TickCount;
+		var idle = (int)Math.Min(interval.TotalMilliseconds, int.MaxValue);
+		foreach (var bucket in _buckets)
+			if (unchecked(now - bucket.LastUsed) >= idle)
+				Interlocked.Add(ref _trims, Release(bucket));
+
+		StopTrimTimerIfEmpty();
+	}
+
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	private static int CurrentCore() =>
+#if NET5_0_OR_GREATER
+		Thread.GetCurrentProcessorId();
+#else
+		Environment.CurrentManagedThreadId;
+#endif
+
+	private sealed class Bucket
+	{
+		public readonly int Length;
+		private readonly byte[]?[] _slots;
+		private int _lastUsed;
+
+		public Bucket(int length, int capacity)
+		{
+			Length = length;
+			_slots = new byte[capacity][];
+			_lastUsed = Environment.TickCount;
+		}
+
+		public int Capacity => _slots.Length;
+
+		public int LastUsed => Volatile.Read(ref _lastUsed);
+
+		public int Count
+		{
+			get
+			{
+				var result = 0;
+				foreach (var slot in _slots)
+					if (slot is not null) result++;
+				return result;
+			}
+		}
+
+		private int FirstSlot() => (int)((uint)CurrentCore() % (uint)_slots.Length);
+
+		public byte[]? TryTake()
+		{
+			Volatile.Write(ref _lastUsed, Environment.TickCount);
+
+			var slots = _slots;
+			var count = slots.Length;
+			var index = FirstSlot();
+
+			for (var i = 0; i < count; i++)
+			{
+				if (Volatile.Read(ref slots[index]) is not null)
+				{
+					var array = Interlocked.Exchange(ref slots[index], null);
+					if (array is not null) return array;
+				}
+
+				if (++index >= count) index = 0;
+			}
+
+			return null;
+		}
+
+		public bool TryPut(byte[] array)
+		{
+			var slots = _slots;
+			var count = slots.Length;
+			var index = FirstSlot();
+
+			for (var i = 0; i < count; i++)
+			{
+				if (Volatile.Read(ref slots[index]) is null &&
+					Interlocked.CompareExchange(ref slots[index], array, null) is null)
+					return true;
+
+				if (++index >= count) index = 0;
+			}
+
+			return false;
+		}
+
+		public int Trim()
+		{
+			var result = 0;
+			var slots = _slots;
+			for (var i = 0; i < slots.Length; i++)
+				if (Interlocked.Exchange(ref slots[i], null) is not null)
+					result++;
+			return result;
+		}
+	}
+}
@@ -7,7 +7,8 @@ using System.Runtime.CompilerServices;
 namespace K4os.Compression.LZ4.Internal;
 
 /// <summary>
-/// Naive wrapper around ArrayPool. Makes calls if something should be pooled. 
+/// Naive wrapper around ArrayPool. Makes calls if something should be pooled.
+/// Large buffers (sized for LZ4 blocks) are handled by <see cref="BlockBufferPool"/>.
 /// </summary>
 public static class BufferPool
 {
@@ -21,7 +22,7 @@ public static class BufferPool
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	private static byte[] Rent(int size, bool zero)
 	{
-		var array = ArrayPool<byte>.Shared.Rent(size);
+		var array = BlockBufferPool.TryRent(size) ?? ArrayPool<byte>.Shared.Rent(size);
 		if (zero) array.AsSpan(0, size).Clear();
 		return array;
 	}
@@ -49,7 +50,7 @@ public static class BufferPool
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	public static void Free(byte[]? buffer)
 	{
-		if (buffer is not null && IsPooled(buffer))
+		if (buffer is not null && IsPooled(buffer) && !BlockBufferPool.TryReturn(buffer))
 			ArrayPool<byte>.Shared.Return(buffer);
 	}
 }
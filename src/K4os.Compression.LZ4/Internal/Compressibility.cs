@@ -0,0 +1,143 @@
+using System;
+using System.Runtime.CompilerServices;
+using K4os.Compression.LZ4.Engine;
+
+namespace K4os.Compression.LZ4.Internal;
+
+/// <summary>
+/// Cheap compressibility pre-check, used to skip expensive (HC and optimal) compression of
+/// blocks which would not compress anyway, like already compressed media or encrypted data.
+/// It looks at fixed number of samples spread across the block only (4KB regardless of
+/// block size), checking their byte distribution and repeated 4-byte sequences, so it is
+/// a heuristic: data with high entropy but long distant repetitions is not detected
+/// as compressible. That's why <see cref="IsIncompressible(byte*,int,int,byte*)"/> confirms
+/// it with fast compressor, which is cheap on data which really does not compress.
+/// </summary>
+public static unsafe class Compressibility
+{
+	/// <summary>Blocks shorter than this are never considered incompressible.</summary>
+	public const int MinLength = SampleCount * SampleLength;
+
+	private const int SampleCount = 64;
+	private const int SampleLength = 64;
+	private const int Samples = SampleCount * SampleLength;
+
+	private const int HashLog = 10;
+
+	/// <summary>
+	/// Collision probability of sampled bytes (sum of squared frequencies) scaled so uniform
+	/// distribution is <c>256</c>. For 4096 random bytes it is expected to be around
+	/// <c>272</c> (sampling noise), anything below <c>320</c> is almost 8 bits per byte.
+	/// </summary>
+	private const int MaxCollisions = 320;
+
+	/// <summary>Max number of sampled positions starting a repeated 4-byte sequence.</summary>
+	private const int MaxRepeats = Samples / 256;
+
+	/// <summary>Block is worth compressing if fast compressor saves at least 1/16 of it.</summary>
+	private const int MinSavingLog = 4;
+
+	/// <summary>
+	/// Checks if block looks incompressible (high byte entropy and no repetitions in samples).
+	/// </summary>
+	/// <param name="source">Block.</param>
+	/// <returns><c>true</c> if it is not worth compressing block.</returns>
+	public static bool LooksIncompressible(ReadOnlySpan<byte> source)
+	{
+		fixed (byte* sourceP = source)
+			return LooksIncompressible(sourceP, source.Length);
+	}
+
+	/// <summary>
+	/// Checks if block looks incompressible (high byte entropy and no repetitions in samples).
+	/// </summary>
+	/// <param name="source">Block.</param>
+	/// <param name="length">Length of block.</param>
+	/// <returns><c>true</c> if it is not worth compressing block.</returns>
+	public static bool LooksIncompressible(byte* source, int length)
+	{
+		if (length < MinLength) return false;
+
+		var counts = stackalloc int[256];
+		var table = stackalloc int[1 << HashLog];
+		new Span<int>(counts, 256).Clear();
+		new Span<int>(table, 1 << HashLog).Fill(-1);
+
+		// last 3 bytes of every sample are not hashed, so reads stay within the block
+		var step = (length - SampleLength) / (SampleCount - 1);
+		var repeats = 0;
+
+		for (var s = 0; s < SampleCount; s++)
+		{
+			var sample = s * step;
+			for (var i = sample; i < sample + SampleLength; i++)
+				counts[source[i]]++;
+
+			for (var i = sample; i < sample + SampleLength - 3; i++)
+			{
+				var sequence = Mem.Peek4(source + i);
+				var hash = Hash(sequence);
+				var other = table[hash];
+				if (other >= 0 && Mem.Peek4(source + other) == sequence && ++repeats > MaxRepeats)
+					return false;
+
+				table[hash] = i;
+			}
+		}
+
+		var collisions = 0L;
+		for (var i = 0; i < 256; i++)
+			collisions += (long)counts[i] * counts[i];
+
+		// sum(c^2) / N^2 * 256 < MaxCollisions / 256 * 256
+		return collisions * 256 * 256 < (long)MaxCollisions * Samples * Samples;
+	}
+
+	/// <summary>
+	/// Checks if block is incompressible: it needs to look incompressible (see
+	/// <see cref="LooksIncompressible(byte*,int)"/>) and fast compressor needs to fail
+	/// to make it noticeably smaller.
+	/// </summary>
+	/// <param name="source">Block.</param>
+	/// <param name="buffer">Scratch buffer, at least as long as block.</param>
+	/// <returns><c>true</c> if it is not worth compressing block.</returns>
+	public static bool IsIncompressible(ReadOnlySpan<byte> source, Span<byte> buffer)
+	{
+		if (buffer.Length < source.Length)
+			throw new ArgumentException("Buffer needs to be at least as long as source");
+
+		fixed (byte* sourceP = source)
+		fixed (byte* bufferP = buffer)
+			return IsIncompressible(sourceP, source.Length, 0, bufferP);
+	}
+
+	/// <summary>
+	/// Checks if block is incompressible: it needs to look incompressible (see
+	/// <see cref="LooksIncompressible(byte*,int)"/>) and fast compressor, using data
+	/// preceding block as dictionary, needs to fail to make it noticeably smaller.
+	/// </summary>
+	/// <param name="source">Block.</param>
+	/// <param name="length">Length of block.</param>
+	/// <param name="historyLength">Length of data preceding block which can be referenced
+	/// (for example, previous blocks in chained mode), <c>0</c> if none.</param>
+	/// <param name="buffer">Scratch buffer, at least as long as block.</param>
+	/// <returns><c>true</c> if it is not worth compressing block.</returns>
+	public static bool IsIncompressible(byte* source, int length, int historyLength, byte* buffer)
+	{
+		if (!LooksIncompressible(source, length))
+			return false;
+
+		var limit = length - (length >> MinSavingLog);
+		historyLength = Math.Min(Math.Max(historyLength, 0), Mem.K64);
+
+		if (historyLength <= 0)
+			return LLxx.LZ4_compress_fast(source, buffer, length, limit, 1) <= 0;
+
+		LL.LZ4_stream_t context; // initialized by LZ4_loadDict
+		LLxx.LZ4_loadDict(&context, source - historyLength, historyLength);
+		return LLxx.LZ4_compress_fast_continue(&context, source, buffer, length, limit, 1) <= 0;
+	}
+
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	private static uint Hash(uint sequence) => (sequence * 2654435761u) >> (32 - HashLog);
+}
@@ -0,0 +1,213 @@
+#nullable enable
+
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+
+#if NET5_0_OR_GREATER
+using System.Diagnostics.Metrics;
+#endif
+
+namespace K4os.Compression.LZ4.Internal;
+
+/// <summary>
+/// Instrumentation of block codec, frame readers and frame writers. It is published as
+/// <c>System.Diagnostics.Metrics</c> meter named <see cref="MeterName"/> (on .NET Framework
+/// it does nothing). Measurements are taken only if some listener is subscribed to given
+/// instrument, otherwise it is just a flag check per block.
+/// All instruments are tagged with <c>lz4.operation</c> (<see cref="Encode"/> or
+/// <see cref="Decode"/>) and <c>lz4.api</c> (<see cref="Codec"/> or <see cref="Frame"/>):
+/// <list type="bullet">
+/// <item><c>lz4.bytes.in</c> - bytes consumed (uncompressed when encoding, compressed when decoding)</item>
+/// <item><c>lz4.bytes.out</c> - bytes produced (compressed when encoding, uncompressed when decoding)</item>
+/// <item><c>lz4.blocks</c> - number of blocks encoded or decoded</item>
+/// <item><c>lz4.blocks.uncompressed</c> - number of blocks stored uncompressed (as they did not compress)</item>
+/// <item><c>lz4.block.duration</c> - time spent encoding or decoding single block (in seconds)</item>
+/// <item><c>lz4.checksum.duration</c> - time spent calculating or verifying checksums (in seconds)</item>
+/// <item><c>lz4.write.duration</c> - time spent writing single block to inner stream, frame writers only (in seconds)</item>
+/// <item><c>lz4.level.changes</c> - number of level changes made by adaptive compression level,
+/// additionally tagged with <c>lz4.level</c> (new level) and <c>lz4.reason</c>
+/// (see <see cref="Encoders.LZ4LevelController.Reason"/>)</item>
+/// </list>
+/// </summary>
+public static class LZ4Metrics
+{
+	/// <summary>Name of the meter.</summary>
+	public const string MeterName = "K4os.Compression.LZ4";
+
+	/// <summary>Tag value for encoding.</summary>
+	public const string Encode = "encode";
+
+	/// <summary>Tag value for decoding.</summary>
+	public const string Decode = "decode";
+
+	/// <summary>Tag value for block codec (<see cref="LZ4Codec"/>).</summary>
+	public const string Codec = "codec";
+
+	/// <summary>Tag value for frame readers and writers.</summary>
+	public const string Frame = "frame";
+
+	#if NET5_0_OR_GREATER
+
+	private static readonly Meter Meter = new(
+		MeterName, typeof(LZ4Metrics).Assembly.GetName().Version?.ToString());
+
+	private static readonly Counter<long> BytesIn = Meter.CreateCounter<long>(
+		"lz4.bytes.in", "By", "Bytes consumed");
+
+	private static readonly Counter<long> BytesOut = Meter.CreateCounter<long>(
+		"lz4.bytes.out", "By", "Bytes produced");
+
+	private static readonly Counter<long> Blocks = Meter.CreateCounter<long>(
+		"lz4.blocks", "{block}", "Blocks encoded or decoded");
+
+	private static readonly Counter<long> UncompressedBlocks = Meter.CreateCounter<long>(
+		"lz4.blocks.uncompressed", "{block}", "Blocks stored uncompressed");
+
+	private static readonly Histogram<double> BlockDuration = Meter.CreateHistogram<double>(
+		"lz4.block.duration", "s", "Time spent encoding or decoding single block");
+
+	private static readonly Histogram<double> ChecksumDuration = Meter.CreateHistogram<double>(
+		"lz4.checksum.duration", "s", "Time spent calculating or verifying checksums");
+
+	private static readonly Histogram<double> WriteDuration = Meter.CreateHistogram<double>(
+		"lz4.write.duration", "s", "Time spent writing single block to inner stream");
+
+	private static readonly Counter<long> LevelChanges = Meter.CreateCounter<long>(
+		"lz4.level.changes", "{change}", "Compression level changes");
+
+	#endif
+
+	/// <summary>Indicates if any block counter is being listened to.</summary>
+	public static bool Enabled
+	{
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		get =>
+			#if NET5_0_OR_GREATER
+			BytesIn.Enabled || BytesOut.Enabled || Blocks.Enabled || UncompressedBlocks.Enabled;
+			#else
+			false;
+			#endif
+	}
+
+	/// <summary>Starts measuring block duration.</summary>
+	/// <returns>Timestamp, or <c>0</c> if block duration is not being listened to.</returns>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static long StartBlock() =>
+		#if NET5_0_OR_GREATER
+		BlockDuration.Enabled ? Stopwatch.GetTimestamp() : 0;
+		#else
+		0;
+		#endif
+
+	/// <summary>Starts measuring checksum duration.</summary>
+	/// <returns>Timestamp, or <c>0</c> if checksum duration is not being listened to.</returns>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static long StartChecksum() =>
+		#if NET5_0_OR_GREATER
+		ChecksumDuration.Enabled ? Stopwatch.GetTimestamp() : 0;
+		#else
+		0;
+		#endif
+
+	/// <summary>Starts measuring write duration.</summary>
+	/// <returns>Timestamp, or <c>0</c> if write duration is not being listened to.</returns>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static long StartWrite() =>
+		#if NET5_0_OR_GREATER
+		WriteDuration.Enabled ? Stopwatch.GetTimestamp() : 0;
+		#else
+		0;
+		#endif
+
+	/// <summary>Records processed block.</summary>
+	/// <param name="operation">Operation, <see cref="Encode"/> or <see cref="Decode"/>.</param>
+	/// <param name="api">Api, <see cref="Codec"/> or <see cref="Frame"/>.</param>
+	/// <param name="bytesIn">Number of bytes consumed.</param>
+	/// <param name="bytesOut">Number of bytes produced.</param>
+	/// <param name="uncompressed">Indicates that block was stored uncompressed.</param>
+	/// <param name="started">Value returned by <see cref="StartBlock"/>.</param>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static void Block(
+		string operation, string api,
+		int bytesIn, int bytesOut, bool uncompressed, long started)
+	{
+		#if NET5_0_OR_GREATER
+		if (started != 0 || Enabled)
+			RecordBlock(operation, api, bytesIn, bytesOut, uncompressed, started);
+		#endif
+	}
+
+	/// <summary>Records checksum calculation or verification.</summary>
+	/// <param name="operation">Operation, <see cref="Encode"/> or <see cref="Decode"/>.</param>
+	/// <param name="api">Api, <see cref="Codec"/> or <see cref="Frame"/>.</param>
+	/// <param name="started">Value returned by <see cref="StartChecksum"/>.</param>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static void Checksum(string operation, string api, long started)
+	{
+		#if NET5_0_OR_GREATER
+		if (started != 0)
+			ChecksumDuration.Record(Elapsed(started), Tags(operation, api));
+		#endif
+	}
+
+	/// <summary>Records block written to inner stream.</summary>
+	/// <param name="operation">Operation, <see cref="Encode"/> or <see cref="Decode"/>.</param>
+	/// <param name="api">Api, <see cref="Codec"/> or <see cref="Frame"/>.</param>
+	/// <param name="started">Value returned by <see cref="StartWrite"/> (or any other
+	/// timestamp).</param>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static void Write(string operation, string api, long started)
+	{
+		#if NET5_0_OR_GREATER
+		if (started != 0 && WriteDuration.Enabled)
+			WriteDuration.Record(Elapsed(started), Tags(operation, api));
+		#endif
+	}
+
+	/// <summary>Records compression level change.</summary>
+	/// <param name="operation">Operation, <see cref="Encode"/> or <see cref="Decode"/>.</param>
+	/// <param name="api">Api, <see cref="Codec"/> or <see cref="Frame"/>.</param>
+	/// <param name="level">New compression level.</param>
+	/// <param name="reason">Reason of the change.</param>
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	public static void LevelChange(string operation, string api, LZ4Level level, string? reason)
+	{
+		#if NET5_0_OR_GREATER
+		if (LevelChanges.Enabled)
+			RecordLevelChange(operation, api, level, reason);
+		#endif
+	}
+
+	#if NET5_0_OR_GREATER
+
+	[MethodImpl(MethodImplOptions.NoInlining)]
+	private static void RecordLevelChange(
+		string operation, string api, LZ4Level level, string? reason)
+	{
+		var tags = Tags(operation, api);
+		tags.Add("lz4.level", (int)level);
+		tags.Add("lz4.reason", reason);
+		LevelChanges.Add(1, tags);
+	}
+
+	[MethodImpl(MethodImplOptions.NoInlining)]
+	private static void RecordBlock(
+		string operation, string api,
+		int bytesIn, int bytesOut, bool uncompressed, long started)
+	{
+		var tags = Tags(operation, api);
+		BytesIn.Add(bytesIn, tags);
+		BytesOut.Add(bytesOut, tags);
+		Blocks.Add(1, tags);
+		if (uncompressed) UncompressedBlocks.Add(1, tags);
+		if (started != 0) BlockDuration.Record(Elapsed(started), tags);
+	}
+
+	private static TagList Tags(string operation, string api) =>
+		new() { { "lz4.operation", operation }, { "lz4.api", api } };
+
+	private static double Elapsed(long started) =>
+		(double)(Stopwatch.GetTimestamp() - started) / Stopwatch.Frequency;
+
+	#endif
+}
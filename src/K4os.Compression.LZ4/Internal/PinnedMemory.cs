@@ -8,15 +8,16 @@ namespace K4os.Compression.LZ4.Internal;
 
 /// <summary>
 /// Represents pinned memory.
-/// It either points to unmanaged memory or block of memory from shared array pool.
+/// It either points to unmanaged memory or block of memory from <see cref="BufferPool"/>.
 /// When disposed, it handles it appropriately.
 /// </summary>
 public unsafe struct PinnedMemory
 {
 	/// <summary>
-	/// Maximum size of the buffer that can be pooled from shared array pool.
+	/// Maximum size of the buffer that can be pooled. By default, it is the largest
+	/// size handled by <see cref="BlockBufferPool"/> (4MB block with some extra room).
 	/// </summary>
-	public static int MaxPooledSize { get; set; } = Mem.M1;
+	public static int MaxPooledSize { get; set; } = BlockBufferPool.MaxPooledSize;
 
 	private byte* _pointer;
 	private GCHandle _handle;
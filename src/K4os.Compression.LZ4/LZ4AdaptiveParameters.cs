@@ -0,0 +1,44 @@
+namespace K4os.Compression.LZ4;
+
+/// <summary>
+/// Parameters of adaptive compression level (see <see cref="Encoders.LZ4LevelController"/>).
+/// Level is chosen per block, between <see cref="MinLevel"/> and <see cref="MaxLevel"/>,
+/// so compression keeps up with <see cref="TargetThroughput"/>, stays within
+/// <see cref="TargetCpuShare"/> and/or follows <see cref="Backpressure"/>.
+/// At least one of the targets needs to be set.
+/// </summary>
+public class LZ4AdaptiveParameters
+{
+	/// <summary>Lowest (fastest) level which can be used. Default is <see cref="LZ4Level.L00_FAST"/>.</summary>
+	public LZ4Level MinLevel { get; set; } = LZ4Level.L00_FAST;
+
+	/// <summary>Highest level which can be used. Default is <see cref="LZ4Level.L09_HC"/>.</summary>
+	public LZ4Level MaxLevel { get; set; } = LZ4Level.L09_HC;
+
+	/// <summary>
+	/// Required compression speed, in uncompressed bytes per second of time spent compressing
+	/// (for example, <c>200_000_000</c> for 200MB/s). <c>null</c> (default) means no target.
+	/// </summary>
+	public double? TargetThroughput { get; set; }
+
+	/// <summary>
+	/// Maximum share of writer's time (between <c>0</c> and <c>1</c>) which can be spent
+	/// compressing. The rest is spent producing data and writing it, so, for example,
+	/// <c>0.5</c> means compression should not take longer than everything else.
+	/// <c>null</c> (default) means no target.
+	/// </summary>
+	public double? TargetCpuShare { get; set; }
+
+	/// <summary>
+	/// Makes level follow speed of inner stream: it is raised while writing blocks takes
+	/// longer than compressing them (so CPU which would be waiting for I/O is used to get better
+	/// ratio), and lowered when compression becomes the bottleneck. It works best when writing
+	/// overlaps with compression (asynchronous writes with pending writes enabled).
+	/// Default is <c>false</c>.
+	/// </summary>
+	public bool Backpressure { get; set; }
+
+	/// <summary>Creates copy of these parameters.</summary>
+	/// <returns>New instance of <see cref="LZ4AdaptiveParameters"/>.</returns>
+	public LZ4AdaptiveParameters Clone() => (LZ4AdaptiveParameters)MemberwiseClone();
+}
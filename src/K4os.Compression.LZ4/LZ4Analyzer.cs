@@ -0,0 +1,135 @@
+#nullable enable
+
+using K4os.Compression.LZ4.Engine;
+
+namespace K4os.Compression.LZ4;
+
+/// <summary>
+/// Walks compressed LZ4 blocks the same way decoder does (parsing tokens, lengths and
+/// offsets) but without producing any output, and collects <see cref="LZ4BlockStats"/>.
+/// Decode cost is estimated with simple model following decoder's fast paths:
+/// every sequence costs <see cref="SequenceCost"/>, short literals and short matches with
+/// offset of at least <see cref="LZ4BlockStats.OverlapOffset"/> are copied in one go,
+/// longer ones are copied in 32-byte chunks (plus one for every extra length byte), and
+/// overlapping matches are copied in 8-byte chunks after additional setup.
+/// </summary>
+public static class LZ4Analyzer
+{
+	private const int WILDCOPY = 32;
+	private const int PATTERNCOPY = 8;
+
+	/// <summary>Cost of decoding sequence (token, offset and short copies).</summary>
+	public const int SequenceCost = 4;
+
+	/// <summary>Additional cost of setting up copy of overlapping match.</summary>
+	public const int OverlapCost = 2;
+
+	/// <summary>Analyzes single compressed block.</summary>
+	/// <param name="source">Compressed block.</param>
+	/// <param name="stats">Statistics to add to (new one is created when <c>null</c>).</param>
+	/// <param name="dictionaryLength">Length of data block can reference before its own
+	/// output (for example, previous blocks in chained frames, or dictionary).</param>
+	/// <returns>Statistics.</returns>
+	/// <exception cref="InvalidDataException">Thrown when block is corrupted.</exception>
+	public static LZ4BlockStats Block(
+		ReadOnlySpan<byte> source, LZ4BlockStats? stats = null, int dictionaryLength = 0)
+	{
+		stats ??= new LZ4BlockStats();
+		var decoded = Walk(source, stats, dictionaryLength);
+		stats.Block(source.Length, decoded, false);
+		return stats;
+	}
+
+	/// <summary>Records block stored uncompressed (in frames or pickles).</summary>
+	/// <param name="length">Length of block.</param>
+	/// <param name="stats">Statistics to add to (new one is created when <c>null</c>).</param>
+	/// <returns>Statistics.</returns>
+	public static LZ4BlockStats Stored(int length, LZ4BlockStats? stats = null)
+	{
+		stats ??= new LZ4BlockStats();
+		stats.Block(length, length, true);
+		stats.Cost((length + WILDCOPY - 1) / WILDCOPY);
+		return stats;
+	}
+
+	/// <summary>Analyzes buffer produced by <see cref="LZ4Pickler"/>.</summary>
+	/// <param name="source">Pickled buffer.</param>
+	/// <param name="stats">Statistics to add to (new one is created when <c>null</c>).</param>
+	/// <returns>Statistics.</returns>
+	/// <exception cref="InvalidDataException">Thrown when pickle is corrupted.</exception>
+	public static LZ4BlockStats Pickle(ReadOnlySpan<byte> source, LZ4BlockStats? stats = null)
+	{
+		stats ??= new LZ4BlockStats();
+		if (source.Length == 0) return stats;
+
+		var header = LZ4Pickler.DecodeHeader(source);
+		var data = source.Slice(header.DataOffset);
+		if (!header.IsCompressed)
+			return Stored(data.Length, stats);
+
+		var decoded = Walk(data, stats, 0);
+		if (decoded != header.ResultLength)
+			throw Corrupted(
+				$"Expected to decode {header.ResultLength} bytes but block contains {decoded}");
+
+		stats.Block(data.Length, decoded, false);
+		return stats;
+	}
+
+	/// <summary>Walks the block and returns its decoded length.</summary>
+	private static unsafe int Walk(
+		ReadOnlySpan<byte> source, LZ4BlockStats stats, int dictionaryLength)
+	{
+		// empty input is empty output, like in LZ4Codec.Decode
+		if (source.Length == 0)
+			return 0;
+
+		var visitor = new StatsVisitor(stats);
+		int decoded;
+		fixed (byte* sourceP = source)
+			decoded = LL.LZ4_walkBlock(sourceP, source.Length, dictionaryLength, ref visitor);
+
+		if (decoded < 0)
+			throw Corrupted($"Invalid sequence at {-decoded - 1}");
+		if (decoded == 0)
+			throw Corrupted("Block decodes to nothing");
+
+		stats.Cost(visitor.Cost);
+		return decoded;
+	}
+
+	/// <summary>Collects statistics and estimates decode cost.</summary>
+	private struct StatsVisitor: ILZ4BlockVisitor
+	{
+		private readonly LZ4BlockStats _stats;
+
+		public long Cost;
+
+		public StatsVisitor(LZ4BlockStats stats)
+		{
+			_stats = stats;
+			Cost = 0;
+		}
+
+		public void Literals(int length, int extra)
+		{
+			Cost += SequenceCost;
+			if (extra > 0) Cost += extra + (length + WILDCOPY - 1) / WILDCOPY;
+			_stats.Literals(length);
+		}
+
+		public void Match(int length, int offset, int extra)
+		{
+			Cost += extra + MatchCost(length, offset, extra > 0);
+			_stats.Match(length, offset);
+		}
+	}
+
+	private static long MatchCost(int matchLength, int offset, bool longMatch) =>
+		offset >= LZ4BlockStats.OverlapOffset
+			? !longMatch ? 0 : (matchLength + WILDCOPY - 1) / WILDCOPY
+			: OverlapCost + (matchLength + PATTERNCOPY - 1) / PATTERNCOPY;
+
+	private static Exception Corrupted(string message) =>
+		new InvalidDataException($"Block is corrupted: {message}");
+}
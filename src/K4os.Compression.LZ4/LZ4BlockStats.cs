@@ -0,0 +1,178 @@
+#nullable enable
+
+using System.IO;
+
+namespace K4os.Compression.LZ4;
+
+/// <summary>
+/// Statistics of compressed LZ4 blocks, as collected by <see cref="LZ4Analyzer"/>.
+/// Histograms use power-of-two buckets: bucket <c>0</c> counts zeros,
+/// bucket <c>n</c> counts values in range <c>[2^(n-1), 2^n)</c>.
+/// </summary>
+public class LZ4BlockStats
+{
+	/// <summary>Number of histogram buckets.</summary>
+	public const int Buckets = 32;
+
+	/// <summary>Matches with offset below this value are overlapping (cannot be
+	/// copied with wide copies by decoder).</summary>
+	public const int OverlapOffset = 16;
+
+	/// <summary>Number of blocks (compressed or stored).</summary>
+	public long Blocks { get; private set; }
+
+	/// <summary>Number of blocks stored uncompressed.</summary>
+	public long StoredBlocks { get; private set; }
+
+	/// <summary>Number of compressed bytes (block payloads only).</summary>
+	public long CompressedBytes { get; private set; }
+
+	/// <summary>Number of decompressed bytes.</summary>
+	public long DecodedBytes { get; private set; }
+
+	/// <summary>Number of sequences (including last literals).</summary>
+	public long Sequences { get; private set; }
+
+	/// <summary>Number of matches.</summary>
+	public long Matches { get; private set; }
+
+	/// <summary>Number of bytes produced by literals.</summary>
+	public long LiteralBytes { get; private set; }
+
+	/// <summary>Number of bytes produced by matches.</summary>
+	public long MatchBytes { get; private set; }
+
+	/// <summary>Number of matches with offset below <see cref="OverlapOffset"/>.</summary>
+	public long OverlappingMatches { get; private set; }
+
+	/// <summary>Estimated decode cost (in arbitrary units, roughly proportional
+	/// to number of decoder iterations, see <see cref="LZ4Analyzer"/>).</summary>
+	public long DecodeCost { get; private set; }
+
+	/// <summary>Histogram of literal run lengths.</summary>
+	public long[] LiteralLengths { get; } = new long[Buckets];
+
+	/// <summary>Histogram of match lengths.</summary>
+	public long[] MatchLengths { get; } = new long[Buckets];
+
+	/// <summary>Histogram of match offsets.</summary>
+	public long[] Offsets { get; } = new long[Buckets];
+
+	/// <summary>Compression ratio (decoded bytes / compressed bytes).</summary>
+	public double Ratio => CompressedBytes == 0 ? 0 : (double)DecodedBytes / CompressedBytes;
+
+	/// <summary>Share of matches which are overlapping.</summary>
+	public double OverlappingShare => Matches == 0 ? 0 : (double)OverlappingMatches / Matches;
+
+	/// <summary>Estimated decode cost per KB of decoded data.</summary>
+	public double DecodeCostPerKB => DecodedBytes == 0 ? 0 : DecodeCost * 1024.0 / DecodedBytes;
+
+	/// <summary>Returns histogram bucket for given value.</summary>
+	/// <param name="value">Value.</param>
+	/// <returns>Bucket index.</returns>
+	public static int Bucket(long value)
+	{
+		var bucket = 0;
+		while (value > 0 && bucket < Buckets - 1)
+		{
+			value >>= 1;
+			bucket++;
+		}
+
+		return bucket;
+	}
+
+	internal void Block(int compressed, int decoded, bool stored)
+	{
+		Blocks++;
+		if (stored) StoredBlocks++;
+		CompressedBytes += compressed;
+		DecodedBytes += decoded;
+	}
+
+	internal void Literals(int length)
+	{
+		Sequences++;
+		LiteralBytes += length;
+		LiteralLengths[Bucket(length)]++;
+	}
+
+	internal void Match(int length, int offset)
+	{
+		Matches++;
+		MatchBytes += length;
+		if (offset < OverlapOffset) OverlappingMatches++;
+		MatchLengths[Bucket(length)]++;
+		Offsets[Bucket(offset)]++;
+	}
+
+	internal void Cost(long cost) => DecodeCost += cost;
+
+	/// <summary>Adds statistics collected somewhere else (for example, in parallel).</summary>
+	/// <param name="other">Other statistics.</param>
+	public void Add(LZ4BlockStats other)
+	{
+		Blocks += other.Blocks;
+		StoredBlocks += other.StoredBlocks;
+		CompressedBytes += other.CompressedBytes;
+		DecodedBytes += other.DecodedBytes;
+		Sequences += other.Sequences;
+		Matches += other.Matches;
+		LiteralBytes += other.LiteralBytes;
+		MatchBytes += other.MatchBytes;
+		OverlappingMatches += other.OverlappingMatches;
+		DecodeCost += other.DecodeCost;
+		for (var i = 0; i < Buckets; i++)
+		{
+			LiteralLengths[i] += other.LiteralLengths[i];
+			MatchLengths[i] += other.MatchLengths[i];
+			Offsets[i] += other.Offsets[i];
+		}
+	}
+
+	/// <summary>Writes human readable report.</summary>
+	/// <param name="writer">Text writer.</param>
+	public void WriteTo(TextWriter writer)
+	{
+		writer.WriteLine($"blocks:       {Blocks} ({StoredBlocks} stored)");
+		writer.WriteLine($"bytes:        {CompressedBytes} -> {DecodedBytes} (ratio {Ratio:0.000})");
+		writer.WriteLine($"sequences:    {Sequences} ({Matches} matches)");
+		writer.WriteLine($"literals:     {LiteralBytes} bytes ({Share(LiteralBytes, DecodedBytes)})");
+		writer.WriteLine($"matches:      {MatchBytes} bytes ({Share(MatchBytes, DecodedBytes)})");
+		writer.WriteLine($"overlapping:  {OverlappingMatches} ({OverlappingShare:P1} of matches, offset < {OverlapOffset})");
+		writer.WriteLine($"decode cost:  {DecodeCost} ({DecodeCostPerKB:0.0} per KB)");
+		WriteHistogram(writer, "literal length", LiteralLengths);
+		WriteHistogram(writer, "match length", MatchLengths);
+		WriteHistogram(writer, "offset", Offsets);
+	}
+
+	/// <inheritdoc />
+	public override string ToString()
+	{
+		var writer = new StringWriter();
+		WriteTo(writer);
+		return writer.ToString();
+	}
+
+	private static string Share(long value, long total) =>
+		total == 0 ? "-" : $"{(double)value / total:P1}";
+
+	private static void WriteHistogram(TextWriter writer, string name, long[] histogram)
+	{
+		var last = Array.FindLastIndex(histogram, c => c != 0);
+		if (last < 0) return;
+
+		var first = Array.FindIndex(histogram, c => c != 0);
+		var total = 0L;
+		foreach (var count in histogram) total += count;
+
+		writer.WriteLine($"{name}:");
+		for (var i = first; i <= last; i++)
+		{
+			var lo = i == 0 ? 0 : 1L << (i - 1);
+			var hi = i == 0 ? 0 : (1L << i) - 1;
+			var range = lo == hi ? $"{lo}" : $"{lo}-{hi}";
+			writer.WriteLine($"  {range,13}: {histogram[i],12} {Share(histogram[i], total),7}");
+		}
+	}
+}
@@ -1,6 +1,7 @@
 #nullable enable
 
 using K4os.Compression.LZ4.Engine;
+using K4os.Compression.LZ4.Internal;
 
 namespace K4os.Compression.LZ4;
 
@@ -45,10 +46,13 @@ public static class LZ4Codec
 		if (sourceLength <= 0)
 			return 0;
 
-		var encoded = level < LZ4Level.L03_HC
-			? LLxx.LZ4_compress_fast(source, target, sourceLength, targetLength, 1)
-			: LLxx.LZ4_compress_HC(source, target, sourceLength, targetLength, (int)level);
-		return encoded <= 0 ? -1 : encoded;
+		var started = LZ4Metrics.StartBlock();
+		var encoded = EncodeBlock(source, sourceLength, target, targetLength, level);
+		if (encoded <= 0) return -1;
+
+		LZ4Metrics.Block(
+			LZ4Metrics.Encode, LZ4Metrics.Codec, sourceLength, encoded, false, started);
+		return encoded;
 	}
 
 	/// <summary>Compresses data from one buffer into another.</summary>
@@ -95,6 +99,125 @@ public static class LZ4Codec
 				level);
 	}
 
+	/// <summary>Compresses data from one buffer into another.</summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="sourceLength">Length of input buffer.</param>
+	/// <param name="target">Output buffer.</param>
+	/// <param name="targetLength">Output buffer length.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <returns>Number of bytes written, or negative value if output buffer is too small.</returns>
+	public static unsafe int Encode(
+		byte* source, int sourceLength,
+		byte* target, int targetLength,
+		LZ4CompressionParameters parameters)
+	{
+		if (parameters is null)
+			throw new ArgumentNullException(nameof(parameters));
+		if (sourceLength <= 0)
+			return 0;
+
+		var started = LZ4Metrics.StartBlock();
+		var encoded = EncodeBlock(source, sourceLength, target, targetLength, parameters);
+		if (encoded <= 0) return -1;
+
+		LZ4Metrics.Block(
+			LZ4Metrics.Encode, LZ4Metrics.Codec, sourceLength, encoded, false, started);
+		return encoded;
+	}
+
+	/// <summary>Compresses data from one buffer into another.</summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="target">Output buffer.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <returns>Number of bytes written, or negative value if output buffer is too small.</returns>
+	public static unsafe int Encode(
+		ReadOnlySpan<byte> source, Span<byte> target,
+		LZ4CompressionParameters parameters)
+	{
+		var sourceLength = source.Length;
+		if (sourceLength <= 0)
+			return 0;
+
+		var targetLength = target.Length;
+		fixed (byte* sourceP = source)
+		fixed (byte* targetP = target)
+			return Encode(sourceP, sourceLength, targetP, targetLength, parameters);
+	}
+
+	/// <summary>Compresses data from one buffer into another.</summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="sourceOffset">Input buffer offset.</param>
+	/// <param name="sourceLength">Input buffer length.</param>
+	/// <param name="target">Output buffer.</param>
+	/// <param name="targetOffset">Output buffer offset.</param>
+	/// <param name="targetLength">Output buffer length.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <returns>Number of bytes written, or negative value if output buffer is too small.</returns>
+	public static unsafe int Encode(
+		byte[] source, int sourceOffset, int sourceLength,
+		byte[] target, int targetOffset, int targetLength,
+		LZ4CompressionParameters parameters)
+	{
+		source.Validate(sourceOffset, sourceLength);
+		target.Validate(targetOffset, targetLength);
+
+		fixed (byte* sourceP = source)
+		fixed (byte* targetP = target)
+			return Encode(
+				sourceP + sourceOffset, sourceLength,
+				targetP + targetOffset, targetLength,
+				parameters);
+	}
+
+	// Block encoding and decoding without metrics, for encoders and decoders which are
+	// measured by their callers (frame readers and writers), so blocks are not counted twice.
+
+	internal static unsafe int EncodeBlock(
+		byte* source, int sourceLength,
+		byte* target, int targetLength,
+		LZ4Level level)
+	{
+		if (sourceLength <= 0)
+			return 0;
+
+		var encoded = level < LZ4Level.L02_MID
+			? LLxx.LZ4_compress_fast(source, target, sourceLength, targetLength, 1)
+			: LLxx.LZ4_compress_HC(source, target, sourceLength, targetLength, (int)level);
+		return encoded <= 0 ? -1 : encoded;
+	}
+
+	internal static unsafe int EncodeBlock(
+		byte* source, int sourceLength,
+		byte* target, int targetLength,
+		LZ4CompressionParameters parameters)
+	{
+		if (sourceLength <= 0)
+			return 0;
+
+		var level = parameters.Level;
+		var encoded = level < LZ4Level.L02_MID
+			? LLxx.LZ4_compress_fast(
+				source, target, sourceLength, targetLength,
+				parameters.Acceleration, parameters.HashLog)
+			: LLxx.LZ4_compress_HC(
+				source, target, sourceLength, targetLength, (int)level,
+				parameters.SearchDepth ?? 0, parameters.TargetLength ?? 0,
+				parameters.FavorDecompressionSpeed, parameters.BinaryTreeMatchFinder,
+				parameters.ParseWindow ?? 0);
+		return encoded <= 0 ? -1 : encoded;
+	}
+
+	internal static unsafe int DecodeBlock(
+		byte* source, int sourceLength,
+		byte* target, int targetLength)
+	{
+		if (sourceLength <= 0)
+			return 0;
+
+		var decoded = LLxx.LZ4_decompress_safe(source, target, sourceLength, targetLength);
+		return decoded <= 0 ? -1 : decoded;
+	}
+
 	/// <summary>Decompresses data from given buffer.</summary>
 	/// <param name="source">Input buffer.</param>
 	/// <param name="sourceLength">Input buffer length.</param>
@@ -108,10 +231,13 @@ public static class LZ4Codec
 		if (sourceLength <= 0)
 			return 0;
 
-		var decoded = LLxx.LZ4_decompress_safe(
-			source, target, sourceLength, targetLength);
-			
-		return decoded <= 0 ? -1 : decoded;
+		var started = LZ4Metrics.StartBlock();
+		var decoded = DecodeBlock(source, sourceLength, target, targetLength);
+		if (decoded <= 0) return -1;
+
+		LZ4Metrics.Block(
+			LZ4Metrics.Decode, LZ4Metrics.Codec, sourceLength, decoded, false, started);
+		return decoded;
 	}
 	
 	/// <summary>Decompresses data from given buffer, stopping at <paramref name="targetLength"/>.</summary>
@@ -127,10 +253,14 @@ public static class LZ4Codec
 		if (sourceLength <= 0)
 			return 0;
 
+		var started = LZ4Metrics.StartBlock();
 		var decoded = LLxx.LZ4_decompress_safe_partial(
 			source, target, sourceLength, targetLength);
-			
-		return decoded <= 0 ? -1 : decoded;
+		if (decoded <= 0) return -1;
+
+		LZ4Metrics.Block(
+			LZ4Metrics.Decode, LZ4Metrics.Codec, sourceLength, decoded, false, started);
+		return decoded;
 	}
 
 	/// <summary>Decompresses data from given buffer.</summary>
@@ -149,11 +279,15 @@ public static class LZ4Codec
 		if (sourceLength <= 0)
 			return 0;
 
+		var started = LZ4Metrics.StartBlock();
 		var decoded = LLxx.LZ4_decompress_safe_usingDict(
 			source, target, sourceLength, targetLength,
 			dictionary, dictionaryLength);
+		if (decoded <= 0) return -1;
 
-		return decoded <= 0 ? -1 : decoded;
+		LZ4Metrics.Block(
+			LZ4Metrics.Decode, LZ4Metrics.Codec, sourceLength, decoded, false, started);
+		return decoded;
 	}
 
 	/// <summary>Decompresses data from given buffer, stopping at <paramref name="target"/> buffer length.</summary>
@@ -264,4 +398,59 @@ public static class LZ4Codec
 				targetP + targetOffset, targetLength,
 				dictionaryP + dictionaryOffset, dictionaryLength);
 	}
-}
\ No newline at end of file
+
+	/// <summary>
+	/// Calculates length of decompressed block without decompressing it. It only walks
+	/// tokens, literal lengths and match lengths (skipping over literals), applying the same
+	/// parsing restrictions as decoder, so it is much faster than decoding and allows to
+	/// allocate output buffer of exact size. Length is never returned for block which
+	/// <see cref="Decode(byte*,int,byte*,int,byte*,int)"/> would reject, and empty input
+	/// has length of <c>0</c>, like it does when decoded.
+	/// </summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="sourceLength">Input buffer length.</param>
+	/// <param name="dictionaryLength">Length of dictionary block is going to be decoded with.</param>
+	/// <returns>Length of decompressed block, or negative value if block is corrupted.</returns>
+	public static unsafe int GetDecodedLength(
+		byte* source, int sourceLength, int dictionaryLength = 0)
+	{
+		if (sourceLength <= 0)
+			return 0;
+
+		var visitor = new LL.LZ4_nullVisitor();
+		var decoded = LL.LZ4_walkBlock(source, sourceLength, dictionaryLength, ref visitor);
+		return decoded <= 0 ? -1 : decoded;
+	}
+
+	/// <summary>
+	/// Calculates length of decompressed block without decompressing it
+	/// (see <see cref="GetDecodedLength(byte*,int,int)"/>).
+	/// </summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="dictionaryLength">Length of dictionary block is going to be decoded with.</param>
+	/// <returns>Length of decompressed block, or negative value if block is corrupted.</returns>
+	public static unsafe int GetDecodedLength(
+		ReadOnlySpan<byte> source, int dictionaryLength = 0)
+	{
+		fixed (byte* sourceP = source)
+			return GetDecodedLength(sourceP, source.Length, dictionaryLength);
+	}
+
+	/// <summary>
+	/// Calculates length of decompressed block without decompressing it
+	/// (see <see cref="GetDecodedLength(byte*,int,int)"/>).
+	/// </summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="sourceOffset">Input buffer offset.</param>
+	/// <param name="sourceLength">Input buffer length.</param>
+	/// <param name="dictionaryLength">Length of dictionary block is going to be decoded with.</param>
+	/// <returns>Length of decompressed block, or negative value if block is corrupted.</returns>
+	public static unsafe int GetDecodedLength(
+		byte[] source, int sourceOffset, int sourceLength, int dictionaryLength = 0)
+	{
+		source.Validate(sourceOffset, sourceLength);
+
+		fixed (byte* sourceP = source)
+			return GetDecodedLength(sourceP + sourceOffset, sourceLength, dictionaryLength);
+	}
+}
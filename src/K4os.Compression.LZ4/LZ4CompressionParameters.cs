@@ -0,0 +1,101 @@
+using K4os.Compression.LZ4.Engine;
+
+namespace K4os.Compression.LZ4;
+
+/// <summary>
+/// Advanced compression parameters. Allow to fine tune compressor selected by
+/// <see cref="Level"/>. Parameters which do not apply to selected compressor are ignored,
+/// values out of range are clamped, so encoded data is always valid LZ4 and can be
+/// decoded regardless of parameters used.
+/// </summary>
+public class LZ4CompressionParameters
+{
+	/// <summary>Minimum value of <see cref="HashLog"/>.</summary>
+	public const int MinHashLog = LL.LZ4_HASHLOG_MIN;
+
+	/// <summary>Maximum (and default) value of <see cref="HashLog"/>.</summary>
+	public const int MaxHashLog = LL.LZ4_HASHLOG;
+
+	/// <summary>Minimum value of <see cref="ParseWindow"/>.</summary>
+	public const int MinParseWindow = LL.LZ4_OPT_NUM_MIN;
+
+	/// <summary>Default value of <see cref="ParseWindow"/>.</summary>
+	public const int DefaultParseWindow = LL.LZ4_OPT_NUM;
+
+	/// <summary>Maximum value of <see cref="ParseWindow"/> ("ultra" mode).</summary>
+	public const int UltraParseWindow = LL.LZ4_OPT_NUM_ULTRA;
+
+	/// <summary>Creates parameters with default values for <see cref="LZ4Level.L00_FAST"/>.</summary>
+	public LZ4CompressionParameters() { }
+
+	/// <summary>Creates parameters with default values for given level.</summary>
+	/// <param name="level">Compression level.</param>
+	public LZ4CompressionParameters(LZ4Level level) => Level = level;
+
+	/// <summary>Compression level, selects compressor (fast, mid, HC or optimal).</summary>
+	public LZ4Level Level { get; set; } = LZ4Level.L00_FAST;
+
+	/// <summary>
+	/// Acceleration of fast compressor (<see cref="LZ4Level.L00_FAST"/> only).
+	/// Higher values skip more aggressively over data which does not seem to compress,
+	/// trading compression ratio for speed. Default is <c>1</c>.
+	/// </summary>
+	public int Acceleration { get; set; } = 1;
+
+	/// <summary>
+	/// Log2 of number of entries in hash table of fast compressor
+	/// (<see cref="LZ4Level.L00_FAST"/> only), between <see cref="MinHashLog"/> and
+	/// <see cref="MaxHashLog"/>. Smaller table is cheaper to initialize and fits better in
+	/// L1 cache (good for small blocks) but finds fewer matches. Default is
+	/// <see cref="MaxHashLog"/>.
+	/// </summary>
+	public int HashLog { get; set; } = MaxHashLog;
+
+	/// <summary>
+	/// Maximum number of match candidates tested at every position (HC and optimal levels only).
+	/// <c>null</c> (default) uses value implied by <see cref="Level"/>.
+	/// </summary>
+	public int? SearchDepth { get; set; }
+
+	/// <summary>
+	/// Match length which is considered good enough to stop searching for better one
+	/// ("nice length", optimal levels only). <c>null</c> (default) uses value implied by
+	/// <see cref="Level"/>.
+	/// </summary>
+	public int? TargetLength { get; set; }
+
+	/// <summary>
+	/// Favors decompression speed over compression ratio (HC and optimal levels), following
+	/// decoder's fast paths: matches with offsets shorter than 16 bytes (overlapping copies)
+	/// are avoided, and fewer, longer sequences are preferred (HC levels skip 4-byte matches,
+	/// optimal levels price every sequence one byte higher and trim matches of 19-36 bytes
+	/// to 18, so they need no extra match length byte). Compressed output is usually 1-5%
+	/// larger, but decompresses 5-30% faster.
+	/// </summary>
+	public bool FavorDecompressionSpeed { get; set; }
+
+	/// <summary>
+	/// Uses binary tree instead of hash chain to find matches (optimal levels only).
+	/// Binary tree returns all useful (length, offset) candidates and does not degrade on
+	/// highly repetitive data, where it is several times faster than hash chain, but it
+	/// costs more per byte on regular data and needs extra 256KB of memory.
+	/// Default is <c>false</c>.
+	/// </summary>
+	public bool BinaryTreeMatchFinder { get; set; }
+
+	/// <summary>
+	/// Number of positions optimal parser prices before it commits to a sequence
+	/// (optimal levels only), between <see cref="MinParseWindow"/> and
+	/// <see cref="UltraParseWindow"/>. Larger window lets parser go through long matches
+	/// without cutting them, at cost of 16 bytes of memory per position.
+	/// <see cref="TargetLength"/> can be raised up to parse window as well.
+	/// <c>null</c> (default) uses value implied by <see cref="Level"/>
+	/// (<see cref="UltraParseWindow"/> for <see cref="LZ4Level.L13_ULTRA"/>,
+	/// <see cref="DefaultParseWindow"/> otherwise).
+	/// </summary>
+	public int? ParseWindow { get; set; }
+
+	/// <summary>Creates copy of these parameters.</summary>
+	/// <returns>New instance of <see cref="LZ4CompressionParameters"/>.</returns>
+	public LZ4CompressionParameters Clone() => (LZ4CompressionParameters)MemberwiseClone();
+}
@@ -8,6 +8,13 @@ public enum LZ4Level
 	/// <summary>Fast compression.</summary>
 	L00_FAST = 0,
 
+	/// <summary>
+	/// Mid compression, level 2. Uses two hash tables (4 and 8 bytes) and no hash chains,
+	/// so it is noticeably slower than <see cref="L00_FAST"/> but still much faster than
+	/// <see cref="L03_HC"/>, with compression ratio in between.
+	/// </summary>
+	L02_MID = 2,
+
 	/// <summary>High compression, level 3.</summary>
 	L03_HC = 3,
 
@@ -37,4 +44,14 @@ public enum LZ4Level
 
 	/// <summary>Maximum compression, level 12.</summary>
 	L12_MAX = 12,
+
+	/// <summary>
+	/// Ultra compression, level 13. Like <see cref="L12_MAX"/>, but search is not limited
+	/// by depth (whole 64KB window is scanned) and parser uses largest parse window
+	/// (<see cref="LZ4CompressionParameters.UltraParseWindow"/>), so it rarely commits to
+	/// a sequence early. Slower than <see cref="L12_MAX"/> and usually only marginally
+	/// better, meant for write-once, read-many data. Output is regular LZ4, so
+	/// decompression speed is not affected.
+	/// </summary>
+	L13_ULTRA = 13,
 }
\ No newline at end of file
@@ -48,8 +48,27 @@ public static partial class LZ4Pickler
 	/// <param name="source">Input buffer.</param>
 	/// <param name="level">Compression level.</param>
 	/// <returns>Output buffer.</returns>
-	public static unsafe byte[] Pickle(
-		ReadOnlySpan<byte> source, LZ4Level level = LZ4Level.L00_FAST)
+	public static byte[] Pickle(
+		ReadOnlySpan<byte> source, LZ4Level level = LZ4Level.L00_FAST) =>
+		Pickle(source, level, null);
+
+	/// <summary>Compresses input buffer into self-contained package.</summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <returns>Output buffer.</returns>
+	public static byte[] Pickle(byte[] source, LZ4CompressionParameters parameters) =>
+		Pickle(source.AsSpan(), parameters);
+
+	/// <summary>Compresses input buffer into self-contained package.</summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	/// <returns>Output buffer.</returns>
+	public static byte[] Pickle(
+		ReadOnlySpan<byte> source, LZ4CompressionParameters parameters) =>
+		Pickle(source, LZ4Level.L00_FAST, parameters ?? throw NoParameters());
+
+	private static unsafe byte[] Pickle(
+		ReadOnlySpan<byte> source, LZ4Level level, LZ4CompressionParameters? parameters)
 	{
 		var sourceLength = source.Length;
 		if (sourceLength == 0) return Mem.Empty;
@@ -57,14 +76,14 @@ public static partial class LZ4Pickler
 		if (sourceLength <= MAX_STACKALLOC)
 		{
 			Span<byte> target = stackalloc byte[MAX_STACKALLOC];
-			return PickleWithBuffer(source, level, target);
+			return PickleWithBuffer(source, level, parameters, target);
 		}
 		else
 		{
 			PinnedMemory.Alloc(out var target, sourceLength, false);
 			try
 			{
-				return PickleWithBuffer(source, level, target.Span);
+				return PickleWithBuffer(source, level, parameters, target.Span);
 			}
 			finally
 			{
@@ -73,14 +92,29 @@ public static partial class LZ4Pickler
 		}
 	}
 
+	/// <summary>
+	/// Encodes source into target, which is expected to be no longer than source, so
+	/// compressor gives up as soon as it knows data does not compress. HC and optimal levels
+	/// do not even start if data is incompressible (see <see cref="Compressibility"/>).
+	/// </summary>
+	/// <returns>Encoded length, or <c>0</c> if source should be stored uncompressed.</returns>
+	private static int Encode(
+		ReadOnlySpan<byte> source, Span<byte> target,
+		LZ4Level level, LZ4CompressionParameters? parameters) =>
+		(parameters?.Level ?? level) >= LZ4Level.L03_HC &&
+		Compressibility.IsIncompressible(source, target) ? 0 :
+		parameters is null ? LZ4Codec.Encode(source, target, level) :
+		LZ4Codec.Encode(source, target, parameters);
+
 	private static byte[] PickleWithBuffer(
-		ReadOnlySpan<byte> source, LZ4Level level, Span<byte> buffer)
+		ReadOnlySpan<byte> source, LZ4Level level, LZ4CompressionParameters? parameters,
+		Span<byte> buffer)
 	{
 		const int version = 0;
 		var sourceLength = source.Length;
 
 		Debug.Assert(buffer.Length >= sourceLength);
-		var encodedLength = LZ4Codec.Encode(source, buffer, level);
+		var encodedLength = Encode(source, buffer.Slice(0, sourceLength), level, parameters);
 
 		if (encodedLength <= 0 || encodedLength >= sourceLength)
 		{
@@ -113,6 +147,22 @@ public static partial class LZ4Pickler
 	public static void Pickle<TBufferWriter>(
 		ReadOnlySpan<byte> source, TBufferWriter writer,
 		LZ4Level level = LZ4Level.L00_FAST)
+		where TBufferWriter: IBufferWriter<byte> =>
+		Pickle(source, writer, level, null);
+
+	/// <summary>Compresses input buffer into self-contained package.</summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="writer">Where the compressed data is written.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	public static void Pickle<TBufferWriter>(
+		ReadOnlySpan<byte> source, TBufferWriter writer,
+		LZ4CompressionParameters parameters)
+		where TBufferWriter: IBufferWriter<byte> =>
+		Pickle(source, writer, LZ4Level.L00_FAST, parameters ?? throw NoParameters());
+
+	private static void Pickle<TBufferWriter>(
+		ReadOnlySpan<byte> source, TBufferWriter writer,
+		LZ4Level level, LZ4CompressionParameters? parameters)
 		where TBufferWriter: IBufferWriter<byte>
 	{
 		if (writer is null) 
@@ -129,8 +179,8 @@ public static partial class LZ4Pickler
 		var headerSize = GetPessimisticHeaderSize(version, sourceLength);
 		var target = writer.GetSpan(headerSize + sourceLength);
 
-		var encodedLength = LZ4Codec.Encode(
-			source, target.Slice(headerSize, sourceLength), level);
+		var encodedLength = Encode(
+			source, target.Slice(headerSize, sourceLength), level, parameters);
 
 		if (encodedLength <= 0 || encodedLength >= sourceLength)
 		{
@@ -157,6 +207,15 @@ public static partial class LZ4Pickler
 		LZ4Level level = LZ4Level.L00_FAST) =>
 		Pickle<IBufferWriter<byte>>(source, writer, level);
 
+	/// <summary>Compresses input buffer into self-contained package.</summary>
+	/// <param name="source">Input buffer.</param>
+	/// <param name="writer">Where the compressed data is written.</param>
+	/// <param name="parameters">Compression parameters.</param>
+	public static void Pickle(
+		ReadOnlySpan<byte> source, IBufferWriter<byte> writer,
+		LZ4CompressionParameters parameters) =>
+		Pickle<IBufferWriter<byte>>(source, writer, parameters);
+
 	// ReSharper disable once UnusedParameter.Local
 	private static int GetPessimisticHeaderSize(int version, int sourceLength) =>
 		version switch {
@@ -227,6 +286,9 @@ public static partial class LZ4Pickler
 	private static int EncodeSizeOf(int size) =>
 		size switch { 4 => 3, _ => size };
 
+	private static Exception NoParameters() =>
+		new ArgumentNullException("parameters");
+
 	private static Exception UnexpectedVersion(int version) =>
 		new ArgumentException($"Unexpected pickle version: {version}");
 }
\ No newline at end of file
@@ -128,7 +128,7 @@ public static partial class LZ4Pickler
 				$"Expected to decode {expectedLength} bytes but {decodedLength} has been decoded");
 	}
 
-	private static PickleHeader DecodeHeader(ReadOnlySpan<byte> source) =>
+	internal static PickleHeader DecodeHeader(ReadOnlySpan<byte> source) =>
 		(source[0] & VersionMask) switch {
 			0 => DecodeHeaderV0(source),
 			var v => throw CorruptedPickle($"Version {v} is not recognized"),
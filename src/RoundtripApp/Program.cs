@@ -7,6 +7,7 @@ using K4os.Hash.xxHash;
 
 var levels = new[] {
 	LZ4Level.L00_FAST,
+	LZ4Level.L02_MID,
 	LZ4Level.L03_HC,
 	LZ4Level.L09_HC,
 	LZ4Level.L10_OPT,
@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+# Builds native reference library (liblz4ref) from sources in src/sanitized.
+# Those sources had C types and macros renamed for translation to C#,
+# so renames are reverted first (into obj folder), then compiled as plain C.
+# Usage: build.sh [output-folder] (default: src/native/bin)
+set -euo pipefail
+
+here="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+sources="$here/../sanitized"
+obj="$here/obj"
+bin="${1:-$here/bin}"
+cc="${CC:-cc}"
+
+mkdir -p "$obj" "$bin"
+
+restore() {
+	sed -E \
+		-e 's/@(base|ref)\b/\1/g' \
+		-e 's/\bMem\.Peek2\b/LZ4_read16/g' \
+		-e 's/\bMem\.Peek4\b/LZ4_read32/g' \
+		-e 's/\bMem\.PeekW\b/LZ4_read_ARCH/g' \
+		-e 's/\bMem\.Poke2\b/LZ4_writeLE16/g' \
+		-e 's/\bMem\.Poke4\b/LZ4_write32/g' \
+		-e 's/\bMem\.WildCopy8\b/LZ4_wildCopy8/g' \
+		-e 's/\bDebug\.Assert\b/assert/g' \
+		-e 's/\bnull\b/NULL/g' \
+		-e 's/\bureg_t\b/reg_t/g' \
+		-e 's/\buptr_t\b/uptrval/g' \
+		-e 's/^#ifndef *$/#if 0/' \
+		-e 's/\bbyte byte = /byte b = /; s/\(\*ip != byte\)/(*ip != b)/' \
+		-e '/^ *typedef .*\b(byte|ushort|uint|int|ulong|ptr_t);/d' \
+		"$1" > "$2"
+}
+
+for file in lz4.h lz4hc.h lz4.c lz4hc.c; do
+	restore "$sources/$file" "$obj/$file"
+done
+
+# type names used by sanitized sources
+cat > "$obj/lz4types.h" <<'TYPES'
+#include <stddef.h>
+#include <stdint.h>
+typedef uint8_t byte;
+typedef uint16_t ushort;
+typedef uint32_t uint;
+typedef uint64_t ulong;
+typedef uintptr_t ptr_t;
+TYPES
+
+"$cc" -O3 -fPIC -shared -std=c99 -DNDEBUG \
+	-include "$obj/lz4types.h" -Wno-pointer-sign -w \
+	-o "$bin/liblz4ref.so" "$obj/lz4.c" "$obj/lz4hc.c"
+
+echo "$bin/liblz4ref.so"